@@ -0,0 +1,178 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
+#define DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
+
+// Framework include files
+#include "DD4hep/Conditions.h"
+#include "DDCond/ConditionsPool.h"
+
+// C/C++ include files
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Forward declarations
+    class ConditionsIOVPool;
+
+    /// Columnar, memory mapped conditions snapshot
+    /**
+     *  Flat alternative to the ConditionsRootPersistency snapshots.
+     *  The file is a sequence of plain columns:
+     *  - the IOV table,
+     *  - the condition keys (sorted),
+     *  - the IOV index of each condition,
+     *  - the item descriptors (grammar hash, flags, payload location),
+     *  - a heap with names and the serialized payloads.
+     *
+     *  Opening a snapshot only maps the file into memory. Conditions objects
+     *  are materialized one by one on request (see materialize()), typically
+     *  by the DD4hep_Conditions_mapped_snapshot_Loader when the user pool
+     *  finds a condition missing. Fundamental data types and alignment deltas
+     *  are stored in binary form, all other payloads as the string
+     *  representation given by their grammar.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsMappedSnapshot  {
+    public:
+      typedef Condition::key_type key_type;
+
+      /// Payload encoding types
+      enum Encoding  {
+        PAYLOAD_RAW    = 1,
+        PAYLOAD_DELTA  = 2,
+        PAYLOAD_STRING = 3
+      };
+      /// File header: offsets of all columns relative to the file start
+      struct Header  {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t spare;
+        std::uint64_t num_iovs;
+        std::uint64_t num_items;
+        std::uint64_t iov_offset;
+        std::uint64_t key_offset;
+        std::uint64_t iov_index_offset;
+        std::uint64_t item_offset;
+        std::uint64_t heap_offset;
+        std::uint64_t heap_size;
+      };
+      /// IOV table entry
+      struct IOVEntry  {
+        std::uint64_t name_offset;
+        std::uint32_t name_length;
+        std::uint32_t type;
+        std::int64_t  lower;
+        std::int64_t  upper;
+      };
+      /// Item descriptor: payload location and type information
+      struct Item  {
+        std::uint64_t grammar;
+        std::uint64_t data_offset;
+        std::uint64_t name_offset;
+        std::uint32_t data_length;
+        std::uint32_t name_length;
+        std::uint32_t flags;
+        std::uint32_t encoding;
+      };
+
+    protected:
+      /// Writer record of a condition to be saved
+      struct Record  {
+        Condition condition;
+        std::uint32_t iov;
+        bool operator<(const Record& r) const
+        { return condition->hash < r.condition->hash || (condition->hash == r.condition->hash && iov < r.iov); }
+      };
+      /// Writer buffer: IOVs to be saved
+      std::vector<IOV>     m_iovs;
+      /// Writer buffer: conditions to be saved
+      std::vector<Record>  m_records;
+
+      /// Reader: Mapped file descriptor
+      int                  m_fd      = -1;
+      /// Reader: Length of the mapped region
+      std::size_t          m_length  = 0;
+      /// Reader: Start of the mapped region
+      const char*          m_base    = 0;
+      /// Reader: Columns inside the mapped region
+      const Header*        m_header  = 0;
+      const IOVEntry*      m_iovTab  = 0;
+      const key_type*      m_keys    = 0;
+      const std::uint32_t* m_iovIdx  = 0;
+      const Item*          m_items   = 0;
+      const char*          m_heap    = 0;
+
+      /// Register new IOV in the writer buffer
+      std::uint32_t _addIOV(const IOV& iov);
+      /// Add conditions to the writer buffer. Derived conditions are ignored
+      std::size_t _add(const IOV& iov, const std::vector<Condition>& conditions);
+
+    public:
+      /// Time spent for the last save/open operation in seconds
+      float duration = 0;
+
+    public:
+      /// Default constructor (writer mode)
+      ConditionsMappedSnapshot() = default;
+      /// No copy constructor
+      ConditionsMappedSnapshot(const ConditionsMappedSnapshot& copy) = delete;
+      /// Default destructor. Unmaps the file (if any)
+      virtual ~ConditionsMappedSnapshot();
+      /// No assignment
+      ConditionsMappedSnapshot& operator=(const ConditionsMappedSnapshot& copy) = delete;
+
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const IOV& iov, const std::vector<Condition>& conditions);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(ConditionsPool& pool);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const ConditionsIOVPool& pool);
+      /// Save the data content to a flat file. Returns the number of bytes written or -1
+      long save(const std::string& file_name);
+
+      /// Map snapshot file into memory (reader mode)
+      static std::unique_ptr<ConditionsMappedSnapshot> open(const std::string& file_name);
+
+      /// Number of IOVs in the snapshot
+      std::size_t numIOVs()  const     {  return m_header ? m_header->num_iovs  : 0;  }
+      /// Number of conditions in the snapshot
+      std::size_t size()  const        {  return m_header ? m_header->num_items : 0;  }
+      /// Access IOV table entry
+      const IOVEntry& iov(std::size_t i)  const   {  return m_iovTab[i];          }
+      /// Access the IOV type name of an IOV table entry
+      std::string iovTypeName(std::size_t i)  const;
+      /// Access the key column
+      key_type key(std::size_t i)  const          {  return m_keys[i];            }
+      /// Access the IOV index column
+      std::uint32_t iovIndex(std::size_t i) const {  return m_iovIdx[i];          }
+      /// Access item descriptor
+      const Item& item(std::size_t i)  const      {  return m_items[i];           }
+      /// Index range [first,second) of all entries with a given key
+      std::pair<std::size_t,std::size_t> range(key_type key)  const;
+      /// Create the condition object for entry 'i'. The IOV is assigned by the caller.
+      Condition materialize(std::size_t i)  const;
+    };
+  }        /* End namespace cond                            */
+}          /* End namespace dd4hep                          */
+#endif // DDCOND_CONDITIONSMAPPEDSNAPSHOT_H
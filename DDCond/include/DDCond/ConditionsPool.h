@@ -55,6 +55,8 @@ namespace dd4hep {
     protected:
       /// Handle to conditions manager object
       ConditionsManager m_manager;
+      /// Memory arena for the payloads of the conditions owned by this pool (optional)
+      OpaqueDataArena*  m_arena = 0;
       
     public:
       enum { AGE_NONE    = 0, 
@@ -77,6 +79,13 @@ namespace dd4hep {
       ConditionsPool(ConditionsManager mgr, IOV* iov);
       /// Default destructor. Note: pool must be cleared by the subclass!
       virtual ~ConditionsPool();
+      /// Access the payload memory arena of this pool. Created on first access.
+      /** Conditions owned by this pool may allocate their payload from the arena
+       *  instead of the heap (see OpaqueDataBlock::bind). The arena is released
+       *  after all conditions of the pool are deleted. Not thread safe: the
+       *  caller must hold the conditions manager lock like for any registration.
+       */
+      OpaqueDataArena& arena();
       /// Print pool basics
       void print()   const;
       /// Print pool basics
@@ -181,6 +181,8 @@ namespace dd4hep {
       /** ConditionsMap interface implementation:                                         */
       /// ConditionsMap overload: Add a condition directly to the slice
       virtual bool insert(DetElement detector, Condition::itemkey_type key, Condition condition)  override;
+      /// ConditionsMap overload: Inserted conditions are registered to (and owned by) a conditions pool
+      virtual bool adoptsConditions()  const override  {  return true;  }
       /// ConditionsMap overload: Access a condition
       virtual Condition get(DetElement detector, Condition::itemkey_type key)  const override;
       /// No ConditionsMap overload: Access all conditions within a key range in the interval [lower,upper]
@@ -0,0 +1,332 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/AlignmentData.h"
+#include "DD4hep/detail/ConditionsInterna.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DDCond/ConditionsMappedSnapshot.h"
+
+#include "TTimeStamp.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::cond;
+
+// Local namespace for anonymous stuff
+namespace  {
+
+  static const char      s_magic[8] = { 'D','D','4','C','O','N','D','\0' };
+  static const uint32_t  s_version   = 1;
+
+  /// Binary image of an alignment delta
+  struct DeltaRecord  {
+    double   translation[3];
+    double   pivot[3];
+    double   rotation[3];
+    uint32_t flags;
+    uint32_t spare;
+  };
+
+  /// Helper to measure the duration of an operation
+  struct DurationStamp  {
+    TTimeStamp start;
+    float&     duration;
+    DurationStamp(float& d) : duration(d)  {
+    }
+    ~DurationStamp()  {
+      TTimeStamp stop;
+      duration = stop.AsDouble()-start.AsDouble();
+    }
+  };
+
+  /// Round up to the next 8 byte boundary
+  inline size_t align8(size_t len)   {
+    return (len+7) & ~size_t(7);
+  }
+
+  /// Grammars of fundamental types may be stored as plain bytes
+  inline bool is_raw(const BasicGrammar* g)   {
+    return g->clazz() == 0;
+  }
+}
+
+/// Default destructor
+ConditionsMappedSnapshot::~ConditionsMappedSnapshot()   {
+  if ( m_base ) ::munmap((void*)m_base, m_length);
+  if ( m_fd >= 0 ) ::close(m_fd);
+  m_records.clear();
+  m_iovs.clear();
+}
+
+/// Register new IOV in the writer buffer
+uint32_t ConditionsMappedSnapshot::_addIOV(const IOV& iov)   {
+  for( size_t i=0; i<m_iovs.size(); ++i )  {
+    const IOV& e = m_iovs[i];
+    if ( e.iovType == iov.iovType && e.keyData == iov.keyData )
+      return i;
+  }
+  m_iovs.emplace_back(iov);
+  return m_iovs.size()-1;
+}
+
+/// Add conditions to the writer buffer. Derived conditions are ignored
+size_t ConditionsMappedSnapshot::_add(const IOV& iov, const vector<Condition>& conditions)   {
+  uint32_t iov_idx = _addIOV(iov);
+  size_t   count   = 0;
+  for( Condition c : conditions )   {
+    if ( c.testFlag(Condition::DERIVED) || !c->data.is_bound() )
+      continue;
+    m_records.emplace_back(Record{c, iov_idx});
+    ++count;
+  }
+  return count;
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+size_t ConditionsMappedSnapshot::add(const IOV& iov, const vector<Condition>& conditions)   {
+  DurationStamp stamp(duration);
+  return _add(iov, conditions);
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+size_t ConditionsMappedSnapshot::add(ConditionsPool& pool)   {
+  DurationStamp stamp(duration);
+  RangeConditions conditions;
+  pool.select_all(conditions);
+  return _add(*pool.iov, conditions);
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+size_t ConditionsMappedSnapshot::add(const ConditionsIOVPool& pool)   {
+  DurationStamp stamp(duration);
+  size_t count = 0;
+  for( const auto& p : pool.elements )  {
+    RangeConditions conditions;
+    p.second->select_all(conditions);
+    count += _add(*p.second->iov, conditions);
+  }
+  return count;
+}
+
+/// Save the data content to a flat file
+long ConditionsMappedSnapshot::save(const string& file_name)   {
+  DurationStamp stamp(duration);
+  Header          hdr;
+  string          heap;
+  vector<IOVEntry> iovs(m_iovs.size());
+  vector<key_type> keys(m_records.size());
+  vector<uint32_t> iov_index(m_records.size());
+  vector<Item>     items(m_records.size());
+
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_magic, sizeof(hdr.magic));
+  stable_sort(m_records.begin(), m_records.end());
+  for( size_t i=0; i<m_iovs.size(); ++i )   {
+    const IOV& iov = m_iovs[i];
+    IOVEntry&  e   = iovs[i];
+    e.name_offset  = heap.length();
+    e.name_length  = iov.iovType->name.length();
+    e.type         = iov.iovType->type;
+    e.lower        = iov.keyData.first;
+    e.upper        = iov.keyData.second;
+    heap.append(iov.iovType->name);
+  }
+  for( size_t i=0; i<m_records.size(); ++i )   {
+    const Record&       r = m_records[i];
+    Condition::Object*  o = r.condition.ptr();
+    const BasicGrammar* g = o->data.grammar;
+    Item& e        = items[i];
+    keys[i]        = o->hash;
+    iov_index[i]   = r.iov;
+    e.grammar      = g->hash();
+    e.flags        = o->flags;
+#if defined(DD4HEP_CONDITIONS_HAVE_NAME)
+    e.name_offset  = heap.length();
+    e.name_length  = o->name.length();
+    heap.append(o->name);
+#else
+    e.name_offset  = 0;
+    e.name_length  = 0;
+#endif
+    heap.append(align8(heap.length())-heap.length(), '\0');
+    e.data_offset  = heap.length();
+    if ( g->equals(typeid(Delta)) )   {
+      const Delta& d = o->data.get<Delta>();
+      DeltaRecord  rec;
+      d.translation.GetCoordinates(rec.translation);
+      d.pivot.Vect().GetCoordinates(rec.pivot);
+      d.rotation.GetComponents(rec.rotation);
+      rec.flags      = d.flags;
+      rec.spare      = 0;
+      e.encoding     = PAYLOAD_DELTA;
+      e.data_length  = sizeof(rec);
+      heap.append((const char*)&rec, sizeof(rec));
+    }
+    else if ( is_raw(g) )   {
+      e.encoding     = PAYLOAD_RAW;
+      e.data_length  = g->sizeOf();
+      heap.append((const char*)o->data.ptr(), g->sizeOf());
+    }
+    else   {
+      string rep     = o->data.str();
+      e.encoding     = PAYLOAD_STRING;
+      e.data_length  = rep.length();
+      heap.append(rep);
+    }
+  }
+  hdr.version          = s_version;
+  hdr.num_iovs         = iovs.size();
+  hdr.num_items        = items.size();
+  hdr.iov_offset       = align8(sizeof(Header));
+  hdr.key_offset       = hdr.iov_offset       + align8(iovs.size()*sizeof(IOVEntry));
+  hdr.iov_index_offset = hdr.key_offset       + align8(keys.size()*sizeof(key_type));
+  hdr.item_offset      = hdr.iov_index_offset + align8(iov_index.size()*sizeof(uint32_t));
+  hdr.heap_offset      = hdr.item_offset      + align8(items.size()*sizeof(Item));
+  hdr.heap_size        = heap.length();
+
+  string image(hdr.heap_offset + heap.length(), '\0');
+  ::memcpy(&image[0],                    &hdr,             sizeof(hdr));
+  ::memcpy(&image[hdr.iov_offset],       iovs.data(),      iovs.size()*sizeof(IOVEntry));
+  ::memcpy(&image[hdr.key_offset],       keys.data(),      keys.size()*sizeof(key_type));
+  ::memcpy(&image[hdr.iov_index_offset], iov_index.data(), iov_index.size()*sizeof(uint32_t));
+  ::memcpy(&image[hdr.item_offset],      items.data(),     items.size()*sizeof(Item));
+  ::memcpy(&image[hdr.heap_offset],      heap.data(),      heap.length());
+
+  int fd = ::open(file_name.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0644);
+  if ( fd < 0 )   {
+    printout(ERROR,"ConditionsMappedSnapshot","+++ FAILED to open file %s: %s",
+             file_name.c_str(), ::strerror(errno));
+    return -1;
+  }
+  const char* ptr = image.data();
+  size_t      len = image.length();
+  while ( len > 0 )   {
+    ssize_t nb = ::write(fd, ptr, len);
+    if ( nb < 0 && errno == EINTR ) continue;
+    if ( nb <= 0 )   {
+      printout(ERROR,"ConditionsMappedSnapshot","+++ FAILED to write file %s: %s",
+               file_name.c_str(), ::strerror(errno));
+      ::close(fd);
+      return -1;
+    }
+    ptr += nb;
+    len -= nb;
+  }
+  ::close(fd);
+  return image.length();
+}
+
+/// Map snapshot file into memory (reader mode)
+unique_ptr<ConditionsMappedSnapshot> ConditionsMappedSnapshot::open(const string& file_name)   {
+  unique_ptr<ConditionsMappedSnapshot> p(new ConditionsMappedSnapshot());
+  DurationStamp stamp(p->duration);
+  struct stat st;
+  p->m_fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( p->m_fd < 0 || ::fstat(p->m_fd, &st) != 0 )   {
+    except("ConditionsMappedSnapshot","+++ FAILED to open file %s: %s",
+           file_name.c_str(), ::strerror(errno));
+  }
+  if ( size_t(st.st_size) < sizeof(Header) )   {
+    except("ConditionsMappedSnapshot","+++ File %s is too short to be a conditions snapshot.",
+           file_name.c_str());
+  }
+  void* base = ::mmap(0, st.st_size, PROT_READ, MAP_SHARED, p->m_fd, 0);
+  if ( base == MAP_FAILED )   {
+    except("ConditionsMappedSnapshot","+++ FAILED to map file %s: %s",
+           file_name.c_str(), ::strerror(errno));
+  }
+  p->m_length = st.st_size;
+  p->m_base   = (const char*)base;
+  p->m_header = (const Header*)p->m_base;
+  const Header* h = p->m_header;
+  if ( ::memcmp(h->magic, s_magic, sizeof(s_magic)) != 0 || h->version != s_version )  {
+    except("ConditionsMappedSnapshot","+++ File %s is no conditions snapshot [bad magic/version].",
+           file_name.c_str());
+  }
+  if ( h->heap_offset + h->heap_size > p->m_length )   {
+    except("ConditionsMappedSnapshot","+++ File %s is truncated.", file_name.c_str());
+  }
+  p->m_iovTab = (const IOVEntry*)     (p->m_base + h->iov_offset);
+  p->m_keys   = (const key_type*)     (p->m_base + h->key_offset);
+  p->m_iovIdx = (const uint32_t*)     (p->m_base + h->iov_index_offset);
+  p->m_items  = (const Item*)         (p->m_base + h->item_offset);
+  p->m_heap   =                        p->m_base + h->heap_offset;
+  return p;
+}
+
+/// Access the IOV type name of an IOV table entry
+string ConditionsMappedSnapshot::iovTypeName(size_t i)  const   {
+  const IOVEntry& e = m_iovTab[i];
+  return string(m_heap + e.name_offset, e.name_length);
+}
+
+/// Index range [first,second) of all entries with a given key
+pair<size_t,size_t> ConditionsMappedSnapshot::range(key_type k)  const   {
+  const key_type* first = m_keys;
+  const key_type* last  = m_keys + size();
+  auto r = equal_range(first, last, k);
+  return make_pair(size_t(r.first-first), size_t(r.second-first));
+}
+
+/// Create the condition object for entry 'i'. The IOV is assigned by the caller.
+Condition ConditionsMappedSnapshot::materialize(size_t i)  const   {
+  const Item&         e = m_items[i];
+  const BasicGrammar& g = BasicGrammar::get(e.grammar);
+  const char*       ptr = m_heap + e.data_offset;
+  string            nam(m_heap + e.name_offset, e.name_length);
+  Condition           c(nam, g.type_name());
+  Condition::Object*  o = c.ptr();
+
+  o->hash  = m_keys[i];
+  o->flags = e.flags;
+  switch( e.encoding )   {
+  case PAYLOAD_DELTA:   {
+    const DeltaRecord* rec = (const DeltaRecord*)ptr;
+    Delta& d = o->data.bind<Delta>();
+    d.translation.SetCoordinates(rec->translation);
+    d.pivot.SetXYZ(rec->pivot[0], rec->pivot[1], rec->pivot[2]);
+    d.rotation.SetComponents(rec->rotation[0], rec->rotation[1], rec->rotation[2]);
+    d.flags = rec->flags;
+    break;
+  }
+  case PAYLOAD_RAW:
+    ::memcpy(o->data.bind(&g), ptr, e.data_length);
+    break;
+  case PAYLOAD_STRING:
+    if ( !g.specialization.bind )   {
+      except("ConditionsMappedSnapshot","+++ Grammar %s cannot construct objects.",
+             g.type_name().c_str());
+    }
+    g.specialization.bind(o->data.bind(&g));
+    if ( !o->data.fromString(string(ptr, e.data_length)) )   {
+      except("ConditionsMappedSnapshot","+++ FAILED to parse payload of condition %016llX [%s]",
+             m_keys[i], g.type_name().c_str());
+    }
+    break;
+  default:
+    except("ConditionsMappedSnapshot","+++ Unknown payload encoding %d of condition %016llX",
+           int(e.encoding), m_keys[i]);
+  }
+  return c;
+}
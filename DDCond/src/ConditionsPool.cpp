@@ -37,9 +37,17 @@ ConditionsPool::ConditionsPool(ConditionsManager mgr, IOV* i)
 /// Default destructor
 ConditionsPool::~ConditionsPool()   {
   // Should, but cannot clear here, since clear is a virtual overload.
+  // The subclass already deleted all conditions: the payload arena may be released
+  detail::deletePtr(m_arena);
   InstanceCount::decrement(this);
 }
 
+/// Access the payload memory arena of this pool. Created on first access.
+OpaqueDataArena& ConditionsPool::arena()   {
+  if ( !m_arena ) m_arena = new OpaqueDataArena();
+  return *m_arena;
+}
+
 /// Print pool basics
 void ConditionsPool::print()   const  {
   printout(INFO,"ConditionsPool","+++ Conditions for pool with IOV: %-32s age:%3d [%4d entries]",
@@ -0,0 +1,181 @@
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//  \author  Markus Frank
+//  \date    2016-02-02
+//  \version 1.0
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMAPPEDLOADER_H
+#define DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMAPPEDLOADER_H
+
+// Framework include files
+#include "DDCond/ConditionsDataLoader.h"
+#include "DDCond/ConditionsMappedSnapshot.h"
+#include "DD4hep/Printout.h"
+
+// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond  {
+
+    /// Conditions loader reading memory mapped columnar snapshots
+    /**
+     *  The snapshot files are only mapped when the first conditions are requested.
+     *  Conditions objects are materialized on demand: only the items missing
+     *  in the user pool for the requested IOV are created and registered
+     *  to the corresponding conditions pool of the manager.
+     *
+     *  \author   M.Frank
+     *  \version  1.0
+     *  \ingroup  DD4HEP_CONDITIONS
+     */
+    class ConditionsSnapshotMappedLoader : public ConditionsDataLoader   {
+      std::vector<std::unique_ptr<ConditionsMappedSnapshot> > buffers;
+      void load_source  (const std::string& nam);
+    public:
+      /// Default constructor
+      ConditionsSnapshotMappedLoader(Detector& description, ConditionsManager mgr, const std::string& nam);
+      /// Default destructor
+      virtual ~ConditionsSnapshotMappedLoader();
+      /// Optimized update using conditions slice data
+      virtual size_t load_many(  const IOV&      req_validity,
+                                 RequiredItems&  work,
+                                 LoadedItems&    loaded,
+                                 IOV&            conditions_validity)  override;
+    };
+  }    /* End namespace cond                             */
+}      /* End namespace dd4hep                            */
+#endif /* DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMAPPEDLOADER_H  */
+
+//#include "ConditionsSnapshotMappedLoader.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/PluginCreators.h"
+#include "DD4hep/detail/ConditionsInterna.h"
+#include "DDCond/ConditionsIOVPool.h"
+
+// C/C++ include files
+#include <string>
+#include <cstring>
+#include <iostream>
+
+// Forward declartions
+using std::string;
+using namespace dd4hep;
+using namespace dd4hep::cond;
+
+namespace {
+  void* create_loader(Detector& description, int argc, char** argv)   {
+    const char* name = argc>0 ? argv[0] : "MappedLoader";
+    ConditionsManagerObject* mgr = (ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
+    return new ConditionsSnapshotMappedLoader(description,ConditionsManager(mgr),name);
+  }
+}
+DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_mapped_snapshot_Loader,create_loader)
+
+/// Standard constructor, initializes variables
+ConditionsSnapshotMappedLoader::ConditionsSnapshotMappedLoader(Detector& description, ConditionsManager mgr, const std::string& nam)
+: ConditionsDataLoader(description, mgr, nam)
+{
+}
+
+/// Default Destructor
+ConditionsSnapshotMappedLoader::~ConditionsSnapshotMappedLoader() {
+  buffers.clear();
+}
+
+void ConditionsSnapshotMappedLoader::load_source(const std::string& nam)  {
+  buffers.emplace_back(ConditionsMappedSnapshot::open(nam));
+  printout(DEBUG,"ConditionsLoader","+++ Mapped %ld conditions of %ld IOVs from %s [%8.3f seconds]",
+           buffers.back()->size(), buffers.back()->numIOVs(), nam.c_str(), buffers.back()->duration);
+}
+
+size_t ConditionsSnapshotMappedLoader::load_many(const IOV&      req_validity,
+                                                 RequiredItems&  work,
+                                                 LoadedItems&    loaded,
+                                                 IOV&            conditions_validity)
+{
+  size_t len = loaded.size();
+  for(const auto& src : m_sources )
+    load_source(src.first);
+  m_sources.clear();
+
+  const IOVType* typ = req_validity.iovType;
+  for(const auto& w : work )   {
+    for(const auto& buff : buffers )   {
+      auto r = buff->range(w.first);
+      size_t i = r.first;
+      for( ; i < r.second; ++i )   {
+        const auto& e = buff->iov(buff->iovIndex(i));
+        IOV::Key    k(e.lower, e.upper);
+        if ( e.type == typ->type && IOV::key_is_contained(req_validity.keyData, k) )   {
+          ConditionsPool* pool = m_mgr.registerIOV(*typ, k);
+          Condition       cond = buff->materialize(i);
+          m_mgr.registerUnlocked(*pool, cond);
+          loaded[w.first] = cond;
+          conditions_validity.iov_intersection(k);
+          break;
+        }
+      }
+      if ( i < r.second ) break;
+    }
+  }
+  return loaded.size()-len;
+}
+
+// ======================================================================================
+/// Plugin entry point: Save the conditions pools of the manager to a mapped snapshot
+/**
+ *  Factory: DD4hep_ConditionsMappedSnapshotWriter
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/04/2016
+ */
+static long ddcond_write_mapped_snapshot(Detector& description, int argc, char** argv) {
+  bool arg_error = false;
+  string output = "", iov_type = "";
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-output",argv[i],4) )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-iov_type",argv[i],4) )
+      iov_type = argv[++i];
+    else
+      arg_error = true;
+  }
+  if ( arg_error || output.empty() )  {
+    /// Help printout describing the basic command line interface
+    std::cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionsMappedSnapshotWriter         \n\n"
+      "     -output   <string>       Output file name.                             \n\n"
+      "     -iov_type <string>       Only save conditions of this IOV type.        \n\n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  ConditionsManager manager = ConditionsManager::from(description);
+  ConditionsMappedSnapshot snapshot;
+  size_t count = 0;
+  for( const IOVType* typ : manager.iovTypesUsed() )   {
+    if ( iov_type.empty() || iov_type == typ->name )
+      count += snapshot.add(*manager.iovPool(*typ));
+  }
+  long nBytes = snapshot.save(output);
+  if ( nBytes < 0 )   {
+    except("Conditions","+++ Failed to write conditions snapshot %s",output.c_str());
+  }
+  printout(INFO,"Conditions","+++ Wrote %ld Bytes (%ld conditions) to mapped snapshot %s [%8.3f seconds]",
+           nBytes, count, output.c_str(), snapshot.duration);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_ConditionsMappedSnapshotWriter,ddcond_write_mapped_snapshot)
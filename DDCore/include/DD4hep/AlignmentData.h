@@ -73,6 +73,10 @@ namespace dd4hep {
     ~Delta();
     /// Assignment operator
     Delta& operator=(const Delta& c);
+    /// Equality operator: identical flags and parameters
+    bool operator==(const Delta& c)  const;
+    /// Inequality operator
+    bool operator!=(const Delta& c)  const  {  return !(*this == c);           }
     /// Reset information to identity
     void clear();
     /// Check a given flag
@@ -47,6 +47,7 @@ namespace dd4hep {
         size_t computed = 0;
         size_t missing  = 0;
 	size_t multiply = 0;
+        size_t reused   = 0;
         Result() = default;
         /// Copy constructor
         Result(const Result& result) = default;
@@ -141,6 +142,23 @@ namespace dd4hep {
                      ConditionsMap& alignments)  const;
       /// Optimized call using already properly ordered Deltas
       Result compute(const OrderedDeltas& deltas, ConditionsMap& alignments)  const;
+      /// Incremental update: only recompute detector elements with changed deltas and their children
+      /** The alignment conditions of the previous computation are looked up in 'previous'.
+       *  Detector elements, where neither the delta nor the delta of any parent changed,
+       *  are not recomputed: their transformations are taken from the previous alignment
+       *  condition. If 'previous' and 'alignments' are the same object the conditions are
+       *  reused in place. Otherwise the previous conditions are inserted into 'alignments'
+       *  without creating new condition objects, unless 'alignments' adopts its conditions
+       *  (ConditionsMap::adoptsConditions, e.g. a ConditionsSlice). Then new conditions are
+       *  created and the transformations copied. The number of reused transformations is
+       *  reported in Result::reused.
+       *
+       *  Note: Parent transformations of detector elements not contained in the
+       *  delta set are assumed to be unchanged.
+       */
+      Result compute(const OrderedDeltas& deltas,
+                     const ConditionsMap& previous,
+                     ConditionsMap& alignments)  const;
 
       /// Helper: Extract all Delta-conditions from the conditions map
       size_t extract_deltas(cond::ConditionUpdateContext& context,
@@ -180,6 +198,7 @@ namespace dd4hep {
       multiply += result.multiply;
       computed += result.computed;
       missing  += result.missing;
+      reused   += result.reused;
       return *this;
     }
     /// Subtract results
@@ -188,6 +207,7 @@ namespace dd4hep {
       multiply -= result.multiply;
       computed -= result.computed;
       missing  -= result.missing;
+      reused   -= result.reused;
       return *this;
     }
 
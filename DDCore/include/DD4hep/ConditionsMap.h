@@ -79,6 +79,8 @@ namespace dd4hep {
                           Condition::itemkey_type key) const = 0;
     /// Interface to scan data content of the conditions mapping
     virtual void scan(const Condition::Processor& processor) const = 0;
+    /// Check if inserted conditions are adopted by a conditions pool. Adopted conditions may not be shared
+    virtual bool adoptsConditions()  const  {  return false;  }
 
     /** Partial implementations for utilities accessing DetElement conditions      */
 
@@ -16,6 +16,9 @@
 // Framework include files
 #include "DD4hep/Fields.h"
 #include "DD4hep/Shapes.h"
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 /// Namespace for the AIDA detector description toolkit
@@ -162,5 +165,96 @@ namespace dd4hep {
     virtual void fieldComponents(const double* pos, double* field);
   };
 
+  /// Implementation object of a magnetic field given by a tabulated grid
+  /**
+   *  The field values are given on a regular grid either in 3 dimensions
+   *  (coordinates XYZ: Bx, By, Bz at the grid points in x, y and z) or in
+   *  2 dimensions assuming cylindrical symmetry (coordinates RZ: Br, Bz at the
+   *  grid points in r and z). Between the grid points the field is obtained
+   *  by trilinear (bilinear for RZ) interpolation. Outside the grid the
+   *  field map does not contribute.
+   *
+   *  The grid is read from a binary file consisting of a fixed size header
+   *  followed by the field values as single precision floats:
+   *  (i * num[1] + j) * num[2] + k, where (i,j,k) are the indices along (x,y,z)
+   *  or (r,z,-) with num[2] = 1. The field components of one grid point are
+   *  stored consecutively. The file is memory mapped unless disabled.
+   *
+   *  Consecutive calls from a tracking step are mostly inside the same grid cell.
+   *  Hence the field values at the corners of the last cell accessed are cached
+   *  for each thread and reused as long as the point stays in the cell.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class TabulatedField : public CartesianField::Object {
+  public:
+    enum Coordinates  { XYZ = 0, RZ = 1 };
+    /// Header of the binary field map file
+    struct Header  {
+      /// File type identifier: "DD4hep-fieldmap"
+      char     magic[16];
+      /// File format version
+      int32_t  version;
+      /// Coordinate system of the grid (XYZ or RZ)
+      int32_t  coordinates;
+      /// Number of grid points along each axis. num[2] = 1 for RZ maps
+      int32_t  num[3];
+      int32_t  reserved;
+      /// Position of the first grid point
+      double   lower[3];
+      /// Position of the last grid point
+      double   upper[3];
+    };
+
+    /// Coordinate system of the grid (XYZ or RZ)
+    int          coordinates   { XYZ };
+    /// Number of grid points along each axis
+    int          num[3]        { 1, 1, 1 };
+    /// Position of the first grid point
+    double       lower[3]      { 0e0, 0e0, 0e0 };
+    /// Position of the last grid point
+    double       upper[3]      { 0e0, 0e0, 0e0 };
+    /// Scale factor applied to the tabulated values (field unit)
+    double       scale         { 1e0 };
+    /// Offset of the grid origin in the global frame. Set before defining the grid
+    Position     offset;
+
+  protected:
+    /// Unique identifier of this instance for the thread local cell cache
+    long                  m_id        { 0 };
+    /// Inverse of the grid spacing along each axis
+    double                m_invStep[3] { 0e0, 0e0, 0e0 };
+    /// Stride of the neighbour grid point along each axis (0 for a single point)
+    long                  m_stride[3] { 0, 0, 0 };
+    /// Pointer to the tabulated field values
+    const float*          m_values    { nullptr };
+    /// Storage of the field values (heap memory or memory mapped file)
+    std::shared_ptr<void> m_storage;
+
+    /// Compute the grid parameters after the grid was defined
+    void initialize();
+
+  public:
+    /// Initializing constructor
+    TabulatedField();
+    /// Default destructor
+    virtual ~TabulatedField() = default;
+    /// Number of field components stored per grid point
+    int numComponents()  const    {  return coordinates == RZ ? 2 : 3;   }
+    /// Number of grid points
+    std::size_t numPoints()  const  {  return std::size_t(num[0]) * num[1] * num[2];   }
+    /// Define the grid and the field values from memory. Values are copied
+    void setGrid(int coords, const int n[3], const double lo[3], const double up[3],
+                 const std::vector<float>& values);
+    /// Load the field map from a binary file. Positions are scaled by lunit, values by funit
+    void load(const std::string& file_name, double lunit, double funit, bool use_mmap = true);
+    /// Save the field map to a binary file
+    void save(const std::string& file_name)  const;
+    /// Call to access the field components at a given location
+    virtual void fieldComponents(const double* pos, double* field);
+  };
+
 }         /* End namespace dd4hep             */
 #endif // DD4HEP_FIELDTYPES_H
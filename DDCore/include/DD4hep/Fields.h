@@ -58,10 +58,24 @@ namespace dd4hep {
       int        type;
       /// Field extensions
       Properties properties;
+      /// Lower corner of the bounding box outside which the field vanishes (global frame)
+      double     minimum[3];
+      /// Upper corner of the bounding box outside which the field vanishes (global frame)
+      double     maximum[3];
       /// Default constructor
       Object();
       /// Default destructor
       virtual ~Object();
+      /// Define the bounding box of the region with non-vanishing field
+      void setBoundingBox(const double* lower, const double* upper);
+      /// Check if the bounding box of the field is finite along any axis
+      bool bounded() const;
+      /// Check if the given position is inside the bounding box of the field
+      bool inside(const double* pos) const  {
+        return pos[0] >= minimum[0] && pos[0] <= maximum[0] &&
+          pos[1] >= minimum[1] && pos[1] <= maximum[1] &&
+          pos[2] >= minimum[2] && pos[2] <= maximum[2];
+      }
 
       /** Overwrite to compute the field components at a given location -
        *  NB: The field components have to be added to the provided
@@ -117,7 +131,8 @@ namespace dd4hep {
    *  field components.
    *
    *  The resulting field vectors are computed by the vector addition
-   *  of the individual components.
+   *  of the individual components. Components with a bounding box
+   *  are only evaluated for positions inside the box.
    *
    *  \author  M.Frank
    *  \version 1.0
@@ -139,11 +154,36 @@ namespace dd4hep {
      */
     class Object: public NamedObject {
     public:
+      /// Flattened field component for the evaluation of the overlay
+      /**
+       *  Holds the bare object pointer and a copy of the bounding box.
+       *  Unbounded components skip the position check.
+       */
+      struct Component  {
+        CartesianField::Object* object;
+        bool                    bounded;
+        double                  minimum[3];
+        double                  maximum[3];
+        /// Add the field components at a given location if inside the bounding box
+        void value(const double* pos, double* field) const  {
+          if ( !bounded ||
+               (pos[0] >= minimum[0] && pos[0] <= maximum[0] &&
+                pos[1] >= minimum[1] && pos[1] <= maximum[1] &&
+                pos[2] >= minimum[2] && pos[2] <= maximum[2]) )
+            object->fieldComponents(pos, field);
+        }
+      };
+      typedef std::vector<Component> Components;
+
       int type;
       CartesianField electric;
       CartesianField magnetic;
       std::vector<CartesianField> electric_components;
       std::vector<CartesianField> magnetic_components;
+      /// Dispatch list of the electric field components (not persistent: rebuilt by compile())
+      Components electric_dispatch;  //!
+      /// Dispatch list of the magnetic field components (not persistent: rebuilt by compile())
+      Components magnetic_dispatch;  //!
       /// Field extensions
       Properties properties;
       /// Default constructor
@@ -172,6 +212,9 @@ namespace dd4hep {
     /// Add a new field component
     void add(CartesianField field);
 
+    /// Rebuild the dispatch lists from the field components (e.g. after changing bounding boxes)
+    void compile();
+
     /// Returns the 3 electric field components (x, y, z) if many components are present
     void combinedElectric(const Position& pos, double* field) const {
       combinedElectric((const double*) &pos, field);
@@ -222,8 +265,7 @@ namespace dd4hep {
     /// Returns the 3 electric field components (x, y, z).
     void electricField(const double* pos, double* field) const {
       field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->electric;
-      f.isValid() ? f.value(pos, field) : combinedElectric(pos, field);
+      for( const auto& c : data<Object>()->electric_dispatch ) c.value(pos, field);
     }
 
     /// Returns the 3 magnetic field components (x, y, z).
@@ -246,8 +288,7 @@ namespace dd4hep {
     /// Returns the 3  magnetic field components (x, y, z).
     void magneticField(const double* pos, double* field) const {
       field[0] = field[1] = field[2] = 0.0;
-      CartesianField f = data<Object>()->magnetic;
-      f.isValid() ? f.value(pos, field) : combinedMagnetic(pos, field);
+      for( const auto& c : data<Object>()->magnetic_dispatch ) c.value(pos, field);
     }
 
     /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
@@ -15,6 +15,7 @@
 
 // Framework include files
 #include "DD4hep/Handle.h"
+#include "DD4hep/Volumes.h"
 #include "DD4hep/BitFieldCoder.h"
 
 // C++ include files
@@ -39,6 +40,63 @@ namespace dd4hep {
     typedef std::vector<std::pair<std::string, const BitFieldElement*> >  FieldMap;
     typedef std::vector<std::pair<size_t, std::string> >          FieldIDs;
 
+    /// Precompiled encoder of a fixed sequence of fields
+    /**
+     *  The field offsets and masks are resolved once when the encoder is
+     *  created. Encoding then takes the field values as a plain array in the
+     *  order of the field names given at construction and loops over the fields
+     *  without name lookups or branches. Values are truncated to the field width
+     *  exactly like IDDescriptor::encode. Use inRange() to check the values explicitly.
+     *
+     *  The encoder refers to no data of the descriptor: it stays valid if the
+     *  descriptor is deleted, but not if it is rebuilt.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CORE
+     */
+    class Encoder  {
+    public:
+      /// Precomputed encoding parameters of one field
+      struct Field  {
+        VolumeID mask      { 0 };
+        int      offset    { 0 };
+        int      minValue  { 0 };
+        int      maxValue  { 0 };
+      };
+    protected:
+      /// Fields in the order of the encoded values
+      std::vector<Field> m_fields;
+      /// Combined mask of all fields
+      VolumeID           m_mask  { 0 };
+
+    public:
+      /// Default constructor
+      Encoder() = default;
+      /// Initializing constructor from a sequence of field names
+      Encoder(const IDDescriptor& descriptor, const std::vector<std::string>& field_names);
+      /// Initializing constructor from the field names of a set of volume identifiers
+      Encoder(const IDDescriptor& descriptor, const PlacedVolumeExtension::VolIDs& ids);
+      /// Number of fields encoded
+      size_t size()  const                       {  return m_fields.size();  }
+      /// Combined mask of all fields
+      VolumeID mask()  const                     {  return m_mask;           }
+      /// Access the precomputed field parameters
+      const std::vector<Field>& fields()  const  {  return m_fields;         }
+      /// Check if all values fit into their fields. Returns the index of the first bad value or -1
+      int inRange(const int* values)  const;
+      /// Encode one volumeID from size() field values
+      VolumeID encode(const int* values)  const  {
+        VolumeID id = 0;
+        const Field* f = m_fields.data();
+        for( size_t i = 0, n = m_fields.size(); i < n; ++i )
+          id |= (VolumeID(values[i]) << f[i].offset) & f[i].mask;
+        return id;
+      }
+      /// Encode num_ids volumeIDs. The values are stored row-wise: values[num_ids][size()]
+      void encode(const int* values, size_t num_ids, VolumeID* ids)  const;
+    };
+
   public:
     /// Default constructor
     IDDescriptor() = default;
@@ -60,6 +118,10 @@ namespace dd4hep {
     size_t fieldID(const std::string& field_name) const;
     /// Get the field descriptor of one field by its identifier
     const BitFieldElement* field(size_t identifier) const;
+    /// Get the field descriptor of one field by its interned name
+    const BitFieldElement* field(const VolIDName& field_name) const;
+    /// Create a precompiled encoder for a fixed sequence of fields
+    Encoder encoder(const std::vector<std::string>& field_names) const;
 #ifndef __MAKECINT__
     /// Encode a set of volume identifiers (corresponding to this description of course!) to a volumeID.
     VolumeID encode(const std::vector<std::pair<std::string, int> >& ids) const;
@@ -67,6 +129,12 @@ namespace dd4hep {
     VolumeID encode_reverse(const std::vector<std::pair<std::string, int> >& id_vector) const;
     /// Compute the submask for a given set of volume IDs
     VolumeID get_mask(const std::vector<std::pair<std::string, int> >& id_vector) const;
+    /// Encode a set of volume identifiers with interned field names to a volumeID.
+    VolumeID encode(const PlacedVolumeExtension::VolIDs& ids) const;
+    /// Encode a set of volume identifiers with interned field names to a volumeID with the system ID on the top bits
+    VolumeID encode_reverse(const PlacedVolumeExtension::VolIDs& ids) const;
+    /// Compute the submask for a given set of volume IDs with interned field names
+    VolumeID get_mask(const PlacedVolumeExtension::VolIDs& ids) const;
 #endif
     /// Decode volume IDs and return filled descriptor with all fields
     void decodeFields(VolumeID vid, std::vector<std::pair<const BitFieldElement*, VolumeID> >& fields)  const;
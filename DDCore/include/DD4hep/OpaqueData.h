@@ -26,6 +26,7 @@ namespace dd4hep {
 
   // Forward declarations
   class BasicGrammar;
+  class OpaqueDataArena;
 
   /// Class describing an opaque data block
   /**
@@ -91,13 +92,19 @@ namespace dd4hep {
    */
   class OpaqueDataBlock : public OpaqueData   {
 
+  public:
+    /// Size of the inline data buffer. May be enlarged at build time (DD4HEP_OPAQUEDATA_INLINE_SIZE)
+    static constexpr size_t inline_size =
+      DD4HEP_OPAQUEDATA_INLINE_SIZE > sizeof(std::vector<void*>)
+      ? DD4HEP_OPAQUEDATA_INLINE_SIZE : sizeof(std::vector<void*>);
+
   protected:
     /// Data buffer: plain data are allocated directly on this buffer
     /** This internal data buffer is sufficient to store any 
      *  STL vector, list, map, etc. and hence should be sufficient to
      *  probably store normal relatively primitive basic objects.
      */
-    unsigned char data[sizeof(std::vector<void*>)];
+    alignas(double) unsigned char data[inline_size];
 
   public:
     enum _DataTypes  {
@@ -126,6 +133,8 @@ namespace dd4hep {
     void* bind(const BasicGrammar* grammar);
     /// Bind data value in place
     void* bind(void* ptr, size_t len, const BasicGrammar* grammar);
+    /// Bind data value. Payloads not fitting the inline buffer are allocated from the arena
+    void* bind(const BasicGrammar* grammar, OpaqueDataArena& arena);
     /// Bind external data value to the pointer
     void bindExtern(void* ptr, const BasicGrammar* grammar);
     /// Construct conditions object and bind the data
@@ -134,6 +143,8 @@ namespace dd4hep {
     template <typename T> T& bind();
     /// Bind data value
     template <typename T> T& bind(void* ptr, size_t len);
+    /// Bind data value using the arena if the inline buffer is too small
+    template <typename T> T& bind(OpaqueDataArena& arena);
     /// Bind data value
     template <typename T> T& bind(const std::string& value);
     /// Bind data value
@@ -142,6 +153,52 @@ namespace dd4hep {
     template <typename T> void bindExtern(T* ptr);
   };
 
+  /// Chunked memory arena for opaque data payloads
+  /**
+   *  Payloads of many small objects with identical lifetime (e.g. all conditions
+   *  owned by one conditions pool) are allocated from large chunks instead of
+   *  individual heap allocations. The memory is only released when the arena
+   *  is destroyed. The arena must therefore outlive all data blocks bound to it.
+   *  Data blocks bound to the arena only call the payload destructor.
+   *
+   *  The arena is not thread safe.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CONDITIONS
+   */
+  class OpaqueDataArena  {
+  protected:
+    /// Allocated memory chunks
+    std::vector<unsigned char*> m_chunks;
+    /// Default chunk size
+    size_t m_chunkSize  = 0;
+    /// Free space in the current chunk
+    size_t m_free       = 0;
+    /// Total number of bytes handed out
+    size_t m_allocated  = 0;
+    /// Total number of bytes reserved in chunks
+    size_t m_reserved   = 0;
+    /// Pointer to the next free byte in the current chunk
+    unsigned char* m_next = 0;
+
+  public:
+    /// Initializing constructor
+    OpaqueDataArena(size_t chunk_size = 64*1024);
+    /// No copy constructor
+    OpaqueDataArena(const OpaqueDataArena& copy) = delete;
+    /// Default destructor. Releases all memory chunks
+    ~OpaqueDataArena();
+    /// No assignment
+    OpaqueDataArena& operator=(const OpaqueDataArena& copy) = delete;
+    /// Allocate a memory block (aligned to alignof(std::max_align_t))
+    void* allocate(size_t len);
+    /// Number of bytes allocated from the arena
+    size_t allocated()  const  {  return m_allocated;                     }
+    /// Number of bytes reserved by the arena
+    size_t reserved()  const   {  return m_reserved;                      }
+  };
+
   /// Generic getter. Specify the exact type, not a polymorph type
   template <typename T> inline T& OpaqueData::get() {
     if (!grammar || !grammar->equals(typeid(T))) { throw std::bad_cast(); }
@@ -190,6 +247,12 @@ namespace dd4hep {
     return *(new(this->pointer) T());
   }
 
+  /// Bind data value using the arena if the inline buffer is too small
+  template <typename T> inline T& OpaqueDataBlock::bind(OpaqueDataArena& arena)  {
+    this->bind(&BasicGrammar::instance<T>(), arena);
+    return *(new(this->pointer) T());
+  }
+
   /// Bind grammar and assign value
   template <typename T> inline T& OpaqueDataBlock::bind(const std::string& value)   {
     T& ret = this->bind<T>();
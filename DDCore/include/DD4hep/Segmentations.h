@@ -86,6 +86,8 @@ namespace dd4hep {
     VolumeID volumeID(const CellID& cellID) const;
     /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
     void neighbours(const CellID& cellID, std::set<CellID>& neighbours) const;
+    /// Fills the neighbours of the given cell ID into a caller supplied buffer. Returns the number of neighbours
+    size_t findNeighbours(const CellID& cellID, int type, CellID* buffer, size_t capacity) const;
     /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
      *  in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
      *
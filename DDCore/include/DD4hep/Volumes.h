@@ -21,6 +21,10 @@
 // C/C++ include files
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <iosfwd>
+#include <algorithm>
 
 // ROOT include file (includes TGeoVolume + TGeoShape)
 #include "TGeoNode.h"
@@ -68,6 +72,82 @@ namespace dd4hep {
     void execute()  const;
   };
     
+  /// Interned field name of a volume identifier
+  /**
+   *   The field names of the volume identifiers are stored once in a process
+   *   wide pool. The handle only holds the integer key of the name in the pool.
+   *   Names are never removed from the pool, keys are valid for the lifetime
+   *   of the process, but are not persistent.
+   *
+   *   The handle converts implicitly to std::string to support the string
+   *   based volume identifier API.
+   *
+   *   \author  M.Frank
+   *   \version 1.0
+   *   \ingroup DD4HEP_CORE
+   */
+  class VolIDName  {
+  public:
+    typedef unsigned int key_type;
+  private:
+    /// Key of the name in the pool. Key 0 is the empty string
+    key_type m_key  { 0 };
+  public:
+    /// Intern a name and return its key
+    static key_type intern(const std::string& nam);
+    /// Access the name corresponding to a key
+    static const std::string& name(key_type key);
+    /// Number of names in the pool
+    static std::size_t size();
+    /// Memory used by the pool in bytes (approximate)
+    static std::size_t memoryUsage();
+
+    /// Default constructor: empty name
+    VolIDName() = default;
+    /// Initializing constructor
+    VolIDName(const std::string& nam) : m_key(intern(nam))  {}
+    /// Initializing constructor. Explicit to avoid ambiguities with std::string overloads
+    explicit VolIDName(const char* nam) : m_key(intern(nam))  {}
+    /// Copy constructor
+    VolIDName(const VolIDName& copy) = default;
+    /// Assignment operator
+    VolIDName& operator=(const VolIDName& copy) = default;
+    /// Access the key of the name
+    key_type key()  const                  {  return m_key;             }
+    /// Access the name
+    const std::string& str()  const        {  return name(m_key);       }
+    /// Access the name as C-string
+    const char* c_str()  const             {  return name(m_key).c_str(); }
+    /// Check if the name is empty
+    bool empty()  const                    {  return 0 == m_key;        }
+    /// Conversion to the string based API
+    operator const std::string& ()  const  {  return name(m_key);       }
+  };
+  /// Equality of interned names: key comparison
+  inline bool operator==(const VolIDName& a, const VolIDName& b)    {  return a.key() == b.key();  }
+  /// Inequality of interned names: key comparison
+  inline bool operator!=(const VolIDName& a, const VolIDName& b)    {  return a.key() != b.key();  }
+  /// Compare interned name with a string
+  inline bool operator==(const VolIDName& a, const std::string& b)  {  return a.str() == b;         }
+  /// Compare interned name with a string
+  inline bool operator==(const std::string& a, const VolIDName& b)  {  return a == b.str();         }
+  /// Compare interned name with a string
+  inline bool operator!=(const VolIDName& a, const std::string& b)  {  return a.str() != b;         }
+  /// Compare interned name with a string
+  inline bool operator!=(const std::string& a, const VolIDName& b)  {  return a != b.str();         }
+  /// Compare interned name with a C-string
+  inline bool operator==(const VolIDName& a, const char* b)         {  return a.str() == b;         }
+  /// Compare interned name with a C-string
+  inline bool operator==(const char* a, const VolIDName& b)         {  return b.str() == a;         }
+  /// Compare interned name with a C-string
+  inline bool operator!=(const VolIDName& a, const char* b)         {  return a.str() != b;         }
+  /// Compare interned name with a C-string
+  inline bool operator!=(const char* a, const VolIDName& b)         {  return b.str() != a;         }
+  /// Lexical ordering of interned names
+  inline bool operator<(const VolIDName& a, const VolIDName& b)     {  return a.str() < b.str();    }
+  /// Stream interned name
+  std::ostream& operator<<(std::ostream& os, const VolIDName& nam);
+
   /// Implementation class extending the ROOT placed volume
   /**
    *   For any further documentation please see the following ROOT documentation:
@@ -79,42 +159,115 @@ namespace dd4hep {
    */
   class PlacedVolumeExtension : public TGeoExtension  {
   public:
-    typedef std::pair<std::string, int> VolID;
+    typedef std::pair<VolIDName, int> VolID;
     /// Volume ID container
     /**
+     *   Compact container of volume identifiers with interned field names.
+     *   Up to INLINE_CAPACITY identifiers are stored without heap allocation.
+     *   The interface follows the one of std::vector.
+     *
+     *   The field names are streamed as strings by the ROOT I/O.
+     *
      *   \author  M.Frank
      *   \version 1.0
      *   \ingroup DD4HEP_CORE
      */
-    class VolIDs: public std::vector<VolID> {
+    class VolIDs  {
+    public:
+      typedef VolID         value_type;
+      typedef VolID&        reference;
+      typedef const VolID&  const_reference;
+      typedef VolID*        iterator;
+      typedef const VolID*  const_iterator;
+      typedef std::size_t   size_type;
+      /// Number of identifiers stored without heap allocation
+      enum { INLINE_CAPACITY = 3 };
+
+    private:
+      /// Pointer to the identifiers: either m_inline or heap memory
+      VolID*       m_data      { m_inline };          //!
+      /// Number of identifiers
+      unsigned int m_size      { 0 };                 //!
+      /// Capacity of the current storage
+      unsigned int m_capacity  { INLINE_CAPACITY };   //!
+      /// Inline storage
+      VolID        m_inline[INLINE_CAPACITY];         //!
+
+      /// Ensure the storage can hold the requested number of identifiers
+      void grow(size_type num);
+
     public:
-      typedef std::vector<VolID> Base;
       /// Default constructor
       VolIDs() = default;
       /// Move constructor
-      VolIDs(VolIDs&& copy) = default;
+      VolIDs(VolIDs&& copy);
       /// Copy constructor
-      VolIDs(const VolIDs& copy) = default;
+      VolIDs(const VolIDs& copy);
+      /// Default destructor
+      ~VolIDs();
       /// Move assignment
-      VolIDs& operator=(VolIDs&& copy)  = default;
+      VolIDs& operator=(VolIDs&& copy);
       /// Assignment operator
-      VolIDs& operator=(const VolIDs& c)  = default;
+      VolIDs& operator=(const VolIDs& c);
+
+      /// Number of identifiers
+      size_type size()  const                      {  return m_size;                }
+      /// Check if the container is empty
+      bool empty()  const                          {  return 0 == m_size;           }
+      /// Capacity of the current storage
+      size_type capacity()  const                  {  return m_capacity;            }
+      /// Heap memory used by the identifiers in bytes
+      size_type heapUsage()  const                 {  return m_data == m_inline ? 0 : m_capacity*sizeof(VolID); }
+      iterator begin()                             {  return m_data;                }
+      iterator end()                               {  return m_data + m_size;       }
+      const_iterator begin()  const                {  return m_data;                }
+      const_iterator end()  const                  {  return m_data + m_size;       }
+      reference operator[](size_type i)            {  return m_data[i];             }
+      const_reference operator[](size_type i) const{  return m_data[i];             }
+      reference front()                            {  return m_data[0];             }
+      const_reference front()  const               {  return m_data[0];             }
+      reference back()                             {  return m_data[m_size-1];      }
+      const_reference back()  const                {  return m_data[m_size-1];      }
+      /// Remove all identifiers
+      void clear()                                 {  m_size = 0;                   }
+      /// Reserve storage
+      void reserve(size_type num)                  {  if ( num > m_capacity ) grow(num); }
+      /// Append identifier
+      void push_back(const VolID& id)   {
+        VolID value = id;   // id may refer to an entry of this container
+        if ( m_size == m_capacity ) grow(m_size+1);
+        m_data[m_size++] = value;
+      }
+      /// Append identifier
+      template <typename... Args> void emplace_back(Args&&... args)  {
+        push_back(VolID(std::forward<Args>(args)...));
+      }
+      /// Find entry
+      const_iterator find(const std::string& name) const;
       /// Find entry
-      std::vector<VolID>::const_iterator find(const std::string& name) const;
+      const_iterator find(const VolIDName& name) const;
       /// Insert new entry
-      std::pair<std::vector<VolID>::iterator, bool> insert(const std::string& name, int value);
+      std::pair<iterator, bool> insert(const std::string& name, int value);
       /// Insert bunch of entries
       template< class InputIt>
       iterator insert(InputIt first, InputIt last)
-      {  return this->Base::insert(this->Base::end(), first, last);    }
-#if !defined __GNUCC__ || (defined __GNUCC__ && __GNUC__ > 5)
+      {  return this->insert(this->end(), first, last);    }
       /// Insert bunch of entries
       template< class InputIt>
-      iterator insert(std::vector<VolID>::const_iterator pos, InputIt first, InputIt last)
-      {  return this->Base::insert(pos, first, last);    }
-#endif
+      iterator insert(const_iterator pos, InputIt first, InputIt last)  {
+        VolIDs tmp;
+        for( ; first != last; ++first ) tmp.push_back(VolID(*first));
+        size_type idx = pos - m_data;
+        reserve(m_size + tmp.m_size);
+        std::copy_backward(m_data + idx, m_data + m_size, m_data + m_size + tmp.m_size);
+        std::copy(tmp.begin(), tmp.end(), m_data + idx);
+        m_size += tmp.m_size;
+        return m_data + idx;
+      }
       /// String representation for debugging
       std::string str()  const;
+      /// ROOT I/O
+      ClassDefNV(VolIDs,2);
     };
     /// Magic word to detect memory corruptions
     unsigned long magic = 0;
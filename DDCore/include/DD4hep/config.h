@@ -31,6 +31,14 @@
 #define DD4HEP_MINIMAL_CONDITIONS   1
 #endif
 
+/// Size of the inline payload buffer of opaque data blocks (conditions) in bytes.
+/// Payloads up to this size are stored without heap allocation.
+/// Values smaller than the size of a STL container are ignored.
+/// May be set at build time with the cmake option DD4HEP_OPAQUEDATA_INLINE_SIZE.
+#if !defined(DD4HEP_OPAQUEDATA_INLINE_SIZE)
+#define DD4HEP_OPAQUEDATA_INLINE_SIZE 0
+#endif
+
 /// Valid implementations of the Gaudi plugin service are 1 and 2
 #define DD4HEP_PLUGINSVC_VERSION    2
 
@@ -207,10 +207,13 @@ namespace dd4hep {
   public:
     typedef std::vector<std::pair<std::string, const BitFieldElement*> > FieldMap;
     typedef std::vector<std::pair<size_t, std::string> >         FieldIDs;
+    typedef std::vector<std::pair<unsigned int, const BitFieldElement*> > FieldKeys;
     /// Map of id-fields in the descriptor
     FieldMap      fieldMap;
     /// String map of id descriptors
     FieldIDs      fieldIDs;
+    /// Map of interned field names (VolIDName keys) to id-fields. Not persistent: keys are process local
+    FieldKeys     fieldKeys;  //!
     /// Decoder object
     BitFieldCoder decoder;
     
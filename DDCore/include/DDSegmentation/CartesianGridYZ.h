@@ -39,6 +39,8 @@ namespace dd4hep {
       virtual Vector3D position(const CellID& cellID) const;
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// fill the neighbours of the cell ID into a caller supplied buffer
+      virtual size_t findNeighbours(const CellID& cellID, int type, CellID* buffer, size_t capacity) const;
       /// access the grid size in Y
       double gridSizeY() const {
         return _gridSizeY;
@@ -70,6 +70,8 @@ namespace dd4hep {
 
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// fill the neighbours of the cell ID into a caller supplied buffer
+      virtual size_t findNeighbours(const CellID& cellID, int type, CellID* buffer, size_t capacity) const;
 
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
@@ -78,6 +78,24 @@ namespace dd4hep {
     /// Base class for all segmentations
     class Segmentation {
     public:
+      /// Neighbourhoods supported by findNeighbours
+      enum NeighbourType  {
+        /// Cells sharing a face: one index changed by +-1
+        FaceNeighbours = 0,
+        /// Cells sharing a face, an edge or a corner: any combination of indices changed by +-1
+        AllNeighbours  = 1
+      };
+      /// Index range of one dimension of a regular grid used by the neighbour search
+      struct GridAxis  {
+        const BitFieldElement* field  = 0;
+        long64                 minBin = 0;
+        long64                 maxBin = 0;
+        /// Default constructor
+        GridAxis() = default;
+        /// Initializing constructor: the index range is the range of the field
+        GridAxis(const BitFieldElement& f) : field(&f), minBin(f.minValue()), maxBin(f.maxValue()) {}
+      };
+
       /// Destructor
       virtual ~Segmentation();
 
@@ -92,6 +110,17 @@ namespace dd4hep {
       virtual VolumeID volumeID(const CellID& cellID) const;
       /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
       virtual void neighbours(const CellID& cellID, std::set<CellID>& neighbours) const;
+      /** \brief Fills the neighbours of the given cell ID into a caller supplied buffer
+
+          Neither throws nor allocates memory. Indices outside the valid range are skipped.
+          The order of the neighbours is not specified.
+          \param cellID   cellID of the cell for which the neighbours are searched
+          \param type     neighbourhood, see NeighbourType
+          \param buffer   output buffer of at least capacity cell IDs
+          \param capacity size of the output buffer
+          \return number of neighbours. If it exceeds capacity, only the first capacity neighbours were stored
+      */
+      virtual size_t findNeighbours(const CellID& cellID, int type, CellID* buffer, size_t capacity) const;
       /// Access the encoding string
       virtual std::string fieldDescription() const {
         return _decoder->fieldDescription();
@@ -148,6 +177,14 @@ namespace dd4hep {
       void registerIdentifier(const std::string& nam, const std::string& desc, std::string& ident,
                               const std::string& defaultVal);
 
+      /// Helper method to fill the neighbours of a cell on a regular grid of index fields
+      static size_t gridNeighbours(const CellID& cellID, int type, const GridAxis* axes, size_t num_axes,
+                                   CellID* buffer, size_t capacity);
+      /// Helper method to set a field value without range check
+      static CellID setBin(const CellID& cellID, const BitFieldElement& field, long64 bin)  {
+        return CellID((ulong64(cellID) & ~field.mask()) | ((ulong64(bin) << field.offset()) & field.mask()));
+      }
+
       /// Helper method to convert a bin number to a 1D position
       static double binToPosition(CellID bin, double cellSize, double offset = 0.);
       /// Helper method to convert a 1D position to a cell ID
@@ -47,6 +47,15 @@ Delta& Delta::operator=(const Delta& c)   {
   return *this;
 }
 
+/// Equality operator: identical flags and parameters
+bool Delta::operator==(const Delta& c)  const   {
+  if ( &c == this ) return true;
+  return flags       == c.flags       &&
+         translation == c.translation &&
+         pivot       == c.pivot       &&
+         rotation    == c.rotation;
+}
+
 /// Reset information to identity
 void Delta::clear()   {
   flags       = 0;
@@ -23,6 +23,16 @@
 #include "DD4hep/AlignmentsCalculator.h"
 #include "DD4hep/detail/AlignmentsInterna.h"
 
+// ROOT include files
+#include "TGeoMatrix.h"
+
+// C/C++ include files
+#include <algorithm>
+#ifdef DD4HEP_USE_TBB
+#include "tbb/parallel_reduce.h"
+#include "tbb/blocked_range.h"
+#endif
+
 using namespace dd4hep;
 using namespace dd4hep::align;
 typedef AlignmentsCalculator::Result Result;
@@ -36,11 +46,19 @@ namespace dd4hep {
     /// Anonymous implementation classes
     namespace {
       static Delta        identity_delta;
+      static const double identity_trafo[12] = { 1e0, 0e0, 0e0,
+                                                 0e0, 1e0, 0e0,
+                                                 0e0, 0e0, 1e0,
+                                                 0e0, 0e0, 0e0 };
 
       /// Alignment calculator.
       /**
        *  Uses internally the conditions mechanism to calculator the alignment conditions.
        *
+       *  The transformations are evaluated level by level of the detector element
+       *  hierarchy. Once all parents are known the entries of one level are independent
+       *  and are computed in parallel if TBB is available.
+       *
        *  \author  M.Frank
        *  \version 2.0
        *  \ingroup DD4HEP_ALIGNMENTS
@@ -49,16 +67,25 @@ namespace dd4hep {
       public:
         class Entry;
         class Context;
+        class Transforms;
 
       public:
         /// Initializing constructor
         Calculator() = default;
         /// Default destructor
         ~Calculator() = default;
-        /// Compute all alignment conditions of the lower levels
-        Result compute(Context& context, Entry& entry) const;
+        /// Cache the input transformations and the previous alignment condition (serial part)
+        void prepare(Context& context, size_t index) const;
+        /// Attach the alignment condition to the mapping (serial part, parents before children)
+        void attach(Context& context, size_t index) const;
+        /// Compute the alignment transformations of one entry (thread safe part)
+        Result compute(Context& context, size_t index) const;
         /// Resolve child dependencies for a given context
         void resolve(Context& context, DetElement child) const;
+        /// Execute the computation of all deltas level by level
+        Result execute(Context& context, const AlignmentsCalculator::OrderedDeltas& deltas) const;
+        /// Debug printout of one entry
+        void print(Context& context, size_t index) const;
       };
 
       class Calculator::Entry  {
@@ -66,20 +93,85 @@ namespace dd4hep {
         DetElement::Object*         det   = 0;
         const Delta*                delta = 0;
         AlignmentCondition::Object* cond  = 0;
-        unsigned char               key   = 0, valid = 0, created = 0, _pad[1];
+        /// Previous alignment condition with identical delta (incremental mode only)
+        AlignmentCondition::Object* previous = 0;
+        long                        parent = -1;
+        unsigned char               key   = 0, valid = 0, created = 0, reused = 0;
         Entry(DetElement d, const Delta* del) : det(d.ptr()), delta(del), key(d.key())  {}
       };
 
+      /// Compact structure-of-arrays storage of 3x4 transformations
+      /**
+       *  Each transformation occupies 9 doubles of rotation (row major)
+       *  and 3 doubles of translation. Composition and conversion use plain
+       *  double arithmetic without any TGeoHMatrix temporaries.
+       */
+      class Calculator::Transforms  {
+      public:
+        std::vector<double> rot;
+        std::vector<double> tra;
+        /// Resize the arrays to hold n transformations
+        void resize(size_t n)   {
+          rot.resize(9*n);
+          tra.resize(3*n);
+        }
+        double* r(size_t i)              {  return &rot[9*i];  }
+        double* t(size_t i)              {  return &tra[3*i];  }
+        const double* r(size_t i) const  {  return &rot[9*i];  }
+        const double* t(size_t i) const  {  return &tra[3*i];  }
+        /// Copy a TGeoHMatrix to slot i
+        void set(size_t i, const TGeoHMatrix& m)   {
+          std::copy(m.GetRotationMatrix(), m.GetRotationMatrix()+9, r(i));
+          std::copy(m.GetTranslation(),    m.GetTranslation()+3,    t(i));
+        }
+        /// Copy a 3x4 matrix (rotation followed by translation) to slot i
+        void set(size_t i, const double* m)   {
+          std::copy(m,   m+9,  r(i));
+          std::copy(m+9, m+12, t(i));
+        }
+        /// Composition c = a * b of 3x4 transformations (c may not alias a or b)
+        static void multiply(const double* ra, const double* ta,
+                             const double* rb, const double* tb,
+                             double* rc, double* tc)   {
+          for( int k=0; k<3; ++k )   {
+            const double* a = ra + 3*k;
+            rc[3*k+0] = a[0]*rb[0] + a[1]*rb[3] + a[2]*rb[6];
+            rc[3*k+1] = a[0]*rb[1] + a[1]*rb[4] + a[2]*rb[7];
+            rc[3*k+2] = a[0]*rb[2] + a[1]*rb[5] + a[2]*rb[8];
+            tc[k]     = a[0]*tb[0] + a[1]*tb[1] + a[2]*tb[2] + ta[k];
+          }
+        }
+        /// Convert slot i to a TGeoHMatrix
+        void get(size_t i, TGeoHMatrix& m)  const  {
+          m.SetRotation(r(i));
+          m.SetTranslation(t(i));
+          m.SetBit(TGeoMatrix::kGeoRotation);
+          m.SetBit(TGeoMatrix::kGeoTranslation);
+        }
+      };
+
       class Calculator::Context  {
       public:
         typedef std::map<DetElement,size_t,AlignmentsCalculator::PathOrdering>  DetectorMap;
         typedef std::map<unsigned int,size_t>             Keys;
         typedef std::vector<Entry>                        Entries;
+        typedef std::map<int,std::vector<size_t> >        Levels;
 
         DetectorMap    detectors;
         Keys           keys;
         Entries        entries;
+        Levels         levels;
+        /// Nominal detector transformations of all entries
+        Transforms     nominal;
+        /// World transformation of the parent if the parent is not part of the entries
+        Transforms     parents;
+        /// Resulting detector transformations (nominal * delta)
+        Transforms     local;
+        /// Resulting world transformations
+        Transforms     world;
         ConditionsMap& mapping;
+        /// Previous alignments for incremental updates (optional)
+        const ConditionsMap* previous = 0;
         Context(ConditionsMap& m) : mapping(m)  {
           InstanceCount::increment(this);
         }
@@ -96,6 +188,14 @@ namespace dd4hep {
           }
           except("AlignContext","Failed to add entry: invalid detector handle!");
         }
+        /// Allocate the transformation arrays once all entries are known
+        void allocate()   {
+          size_t n = entries.size();
+          nominal.resize(n);
+          parents.resize(n);
+          local.resize(n);
+          world.resize(n);
+        }
       };
     }
   }       /* End namespace align */
@@ -120,75 +220,171 @@ int AlignmentsCalculator::Scanner::operator()(DetElement de, int)  const  {
   return 0;  
 }
 
-/// Compute all alignment conditions of the lower levels
-Result Calculator::compute(Context& context, Entry& e)   const  {
-  Result result;
+/// Cache the input transformations and the previous alignment condition (serial part)
+void Calculator::prepare(Context& context, size_t index)   const  {
+  Entry&     e   = context.entries[index];
   DetElement det = e.det;
 
-  if ( e.valid == 1 )  {
-    printout(DEBUG,"ComputeAlignment","================ IGNORE %s (already valid)",det.path().c_str());
-    return result;
-  }
   AlignmentCondition c = context.mapping.get(det, Keys::alignmentKey);
-  AlignmentCondition cond = c.isValid() ? c : AlignmentCondition(det.path()+"#alignment");
-  AlignmentData&     align = cond.data();
-  const Delta*       delta = e.delta ? e.delta : &identity_delta;
-  TGeoHMatrix        transform_for_delta;
-
-  printout(DEBUG,"ComputeAlignment",
-           "============================== Compute transformation of %s",det.path().c_str());
-  e.valid     = 1;
-  e.cond      = cond.ptr();
-  align.delta = *delta;
-  delta->computeMatrix(transform_for_delta);
-  result.multiply += 2;
+  if ( context.previous )  {
+    // Remember the previous result if the delta did not change (before overwriting it!)
+    const Delta*       delta = e.delta ? e.delta : &identity_delta;
+    AlignmentCondition prev  = context.previous == &context.mapping
+      ? c : AlignmentCondition(context.previous->get(det, Keys::alignmentKey));
+    if ( prev.isValid() && prev.data().delta == *delta )
+      e.previous = prev.ptr();
+  }
+  e.cond = c.ptr();
+  context.nominal.set(index, det.nominal().detectorTransformation());
 
   DetElement parent_det = det.parent();
-  AlignmentCondition parent_cond = context.mapping.get(parent_det, Keys::alignmentKey);
-  TGeoHMatrix parent_transform;
-  if (parent_cond.isValid()) {
-    AlignmentData&     parent_align = parent_cond.data();
-    parent_transform = parent_align.worldTrafo;
-  }
-  else if ( det.parent().isValid() )   {
-    parent_transform = parent_det.nominal().worldTransformation();
+  auto ip = parent_det.isValid() ? context.detectors.find(parent_det) : context.detectors.end();
+  if ( ip != context.detectors.end() )   {
+    // Parent is computed by the calculator: the world transformation is not yet known
+    e.parent = ip->second;
   }
-  else {
-    // The tranformation from the "world" to its parent is non-existing i.e. unity
+  else  {
+    AlignmentCondition parent_cond = context.mapping.get(parent_det, Keys::alignmentKey);
+    if ( !parent_cond.isValid() && context.previous && parent_det.isValid() )
+      parent_cond = context.previous->get(parent_det, Keys::alignmentKey);
+    if ( parent_cond.isValid() )
+      context.parents.set(index, parent_cond.data().worldTrafo);
+    else if ( parent_det.isValid() )
+      context.parents.set(index, parent_det.nominal().worldTransformation());
+    else  // The tranformation from the "world" to its parent is non-existing i.e. unity
+      context.parents.set(index, identity_trafo);
   }
+  context.levels[det.level()].emplace_back(index);
+}
 
-  align.detectorTrafo = det.nominal().detectorTransformation() * transform_for_delta;
-  align.worldTrafo    = parent_transform * align.detectorTrafo;
-  align.trToWorld     = detail::matrix::_transform(&align.worldTrafo);
-  ++result.computed;
-  result.multiply += 3;
-  // Update mapping if the condition is freshly created
-  if ( !c.isValid() )  {
+/// Attach the alignment condition to the mapping (serial part, parents before children)
+void Calculator::attach(Context& context, size_t index)   const  {
+  Entry&             e    = context.entries[index];
+  AlignmentCondition cond = e.cond;
+
+  // Incremental mode: unchanged delta and unchanged parent -> reuse the previous condition
+  e.reused = e.previous && (e.parent < 0 || context.entries[e.parent].reused);
+  if ( e.reused && e.previous == e.cond )  {
+    // Previous and new alignments are the same map: nothing to do
+    return;
+  }
+  if ( e.reused && !cond.isValid() && !context.mapping.adoptsConditions() )  {
+    // Share the previous condition: no new condition object is created
+    e.cond = e.previous;
+    context.mapping.insert(e.det, Keys::alignmentKey, AlignmentCondition(e.previous));
+    return;
+  }
+  // Conditions adopted by a pool (e.g. a ConditionsSlice) may not be shared between
+  // maps: a new condition is created and the transformations are copied by compute()
+  if ( !cond.isValid() )  {
+    DetElement det = e.det;
+    cond = AlignmentCondition(det.path()+"#alignment");
+    e.cond    = cond.ptr();
     e.created = 1;
     cond->flags |= Condition::ALIGNMENT_DERIVED;
-    cond->hash = ConditionKey(e.det,Keys::alignmentKey).hash;
-    context.mapping.insert(e.det, Keys::alignmentKey, cond);
+    cond->hash = ConditionKey(det,Keys::alignmentKey).hash;
+    context.mapping.insert(det, Keys::alignmentKey, cond);
   }
-  if ( s_PRINT <= INFO )  {
-    printout(INFO,"ComputeAlignment","Level:%d Path:%s DetKey:%08X: Cond:%s key:%16llX",
-             det.level(), det.path().c_str(), det.key(),
-             yes_no(e.delta != 0), (long long int)cond.key());
-    if ( s_PRINT <= DEBUG )  {
-      ::printf("Nominal:     '%s' ", det.path().c_str());
-      det.nominal().worldTransformation().Print();
-      ::printf("Parent: '%s' -> '%s' ", det.path().c_str(), parent_det.path().c_str());
-      parent_transform.Print();
-      ::printf("DetectorTrafo: '%s' -> '%s' ", det.path().c_str(), det.parent().path().c_str());
-      det.nominal().detectorTransformation().Print();
-      ::printf("Delta:       '%s' ", det.path().c_str());
-      transform_for_delta.Print();
-      ::printf("Result:      '%s' ", det.path().c_str());
-      align.worldTrafo.Print();
+  cond.data().delta = e.delta ? *e.delta : identity_delta;
+}
+
+/// Compute the alignment transformations of one entry (thread safe part)
+Result Calculator::compute(Context& context, size_t index)   const  {
+  Result result;
+  Entry& e = context.entries[index];
+
+  if ( e.valid == 1 )  {
+    printout(DEBUG,"ComputeAlignment","================ IGNORE %s (already valid)",
+             DetElement(e.det).path().c_str());
+    return result;
+  }
+  AlignmentData& align = AlignmentCondition(e.cond).data();
+  // Incremental mode: the transformations of reused entries are taken from the previous condition
+  if ( e.reused )  {
+    const AlignmentData& prev = AlignmentCondition(e.previous).data();
+    if ( e.previous != e.cond )  {
+      align.detectorTrafo = prev.detectorTrafo;
+      align.worldTrafo    = prev.worldTrafo;
+      align.trToWorld     = prev.trToWorld;
     }
+    context.world.set(index, prev.worldTrafo);
+    e.valid = 1;
+    ++result.reused;
+    return result;
+  }
+  const Delta&   delta = align.delta;
+  double         delta_trafo[12];
+
+  switch(delta.flags)   {
+  case Delta::HAVE_TRANSLATION+Delta::HAVE_ROTATION+Delta::HAVE_PIVOT:
+    Transform3D(Translation3D(delta.translation)*delta.pivot*delta.rotation*(delta.pivot.Inverse()))
+      .GetComponents(delta_trafo);
+    break;
+  case Delta::HAVE_TRANSLATION+Delta::HAVE_ROTATION:
+    Transform3D(delta.rotation,delta.translation).GetComponents(delta_trafo);
+    break;
+  case Delta::HAVE_ROTATION+Delta::HAVE_PIVOT:
+    Transform3D(delta.pivot*delta.rotation*(delta.pivot.Inverse())).GetComponents(delta_trafo);
+    break;
+  case Delta::HAVE_ROTATION:
+    Transform3D(delta.rotation).GetComponents(delta_trafo);
+    break;
+  case Delta::HAVE_TRANSLATION:
+    Transform3D(delta.translation).GetComponents(delta_trafo);
+    break;
+  default:
+    Transform3D().GetComponents(delta_trafo);
+    break;
   }
+  // Transform3D components are ordered row-wise as 3x4 matrix: unpack rotation/translation
+  const double d_rot[9] = { delta_trafo[0], delta_trafo[1], delta_trafo[2],
+                            delta_trafo[4], delta_trafo[5], delta_trafo[6],
+                            delta_trafo[8], delta_trafo[9], delta_trafo[10] };
+  const double d_tra[3] = { delta_trafo[3], delta_trafo[7], delta_trafo[11] };
+  const Transforms& parent = e.parent < 0 ? context.parents : context.world;
+  size_t            pidx   = e.parent < 0 ? index : size_t(e.parent);
+
+  e.valid = 1;
+  Transforms::multiply(context.nominal.r(index), context.nominal.t(index), d_rot, d_tra,
+                       context.local.r(index), context.local.t(index));
+  Transforms::multiply(parent.r(pidx), parent.t(pidx),
+                       context.local.r(index), context.local.t(index),
+                       context.world.r(index), context.world.t(index));
+  context.local.get(index, align.detectorTrafo);
+  context.world.get(index, align.worldTrafo);
+  detail::matrix::_transform(align.worldTrafo, align.trToWorld);
+  ++result.computed;
+  result.multiply += 5;
   return result;
 }
 
+/// Debug printout of one entry
+void Calculator::print(Context& context, size_t index)   const  {
+  const Entry&   e     = context.entries[index];
+  DetElement     det   = e.det;
+  DetElement     par   = det.parent();
+  AlignmentData& align = AlignmentCondition(e.cond).data();
+  printout(INFO,"ComputeAlignment","Level:%d Path:%s DetKey:%08X: Cond:%s key:%16llX",
+           det.level(), det.path().c_str(), det.key(),
+           yes_no(e.delta != 0), (long long int)e.cond->hash);
+  if ( s_PRINT <= DEBUG )  {
+    TGeoHMatrix parent_transform, transform_for_delta;
+    (e.parent < 0 ? context.parents : context.world)
+      .get(e.parent < 0 ? index : size_t(e.parent), parent_transform);
+    align.delta.computeMatrix(transform_for_delta);
+    ::printf("Nominal:     '%s' ", det.path().c_str());
+    det.nominal().worldTransformation().Print();
+    ::printf("Parent: '%s' -> '%s' ", det.path().c_str(), par.path().c_str());
+    parent_transform.Print();
+    ::printf("DetectorTrafo: '%s' -> '%s' ", det.path().c_str(), par.path().c_str());
+    det.nominal().detectorTransformation().Print();
+    ::printf("Delta:       '%s' ", det.path().c_str());
+    transform_for_delta.Print();
+    ::printf("Result:      '%s' ", det.path().c_str());
+    align.worldTrafo.Print();
+  }
+}
+
 /// Resolve child dependencies for a given context
 void Calculator::resolve(Context& context, DetElement detector) const   {
   auto children = detector.children();
@@ -198,20 +394,64 @@ void Calculator::resolve(Context& context, DetElement detector) const   {
     resolve(context, c.second);
 }
 
+/// Execute the computation of all deltas level by level
+Result Calculator::execute(Context& context, const AlignmentsCalculator::OrderedDeltas& deltas)  const  {
+  Result result;
+  for( const auto& i : deltas )
+    context.insert(i.first, i.second);
+  for( const auto& i : deltas )
+    resolve(context,i.first);
+
+  // Serial part: access and registration of the conditions and the nominal transformations
+  context.allocate();
+  for( size_t i=0; i < context.entries.size(); ++i )
+    prepare(context, i);
+  for( const auto& level : context.levels )   {
+    for( size_t i : level.second )
+      attach(context, i);
+  }
+
+  // Level by level: all parents are computed before their children.
+  // Within one level all entries are independent.
+  for( const auto& level : context.levels )   {
+    const std::vector<size_t>& items = level.second;
+    printout(DEBUG,"ComputeAlignment","++ Level %d: %ld detector elements",level.first,items.size());
+#ifdef DD4HEP_USE_TBB
+    result += tbb::parallel_reduce(tbb::blocked_range<size_t>(0, items.size(), 256), Result(),
+                                   [&](const tbb::blocked_range<size_t>& r, Result res)  {
+                                     for( size_t i=r.begin(); i != r.end(); ++i )
+                                       res += compute(context, items[i]);
+                                     return res;
+                                   },
+                                   [](Result a, const Result& b)  {  return a += b;  });
+#else
+    for( size_t i : items )
+      result += compute(context, i);
+#endif
+  }
+  if ( s_PRINT <= INFO )  {
+    for( size_t i=0; i < context.entries.size(); ++i )
+      print(context, i);
+  }
+  return result;
+}
+
 /// Optimized call using already properly ordered Deltas
 Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
                                      ConditionsMap& alignments)  const
 {
-  Result  result;
-  Calculator obj;
   Calculator::Context context(alignments);
-  for( const auto& i : deltas )
-    context.insert(i.first, i.second);
-  for( const auto& i : deltas )
-    obj.resolve(context,i.first);
-  for( auto& i : context.entries )
-    result += obj.compute(context, i);
-  return result;
+  return Calculator().execute(context, deltas);
+}
+
+/// Incremental update: only recompute detector elements with changed deltas and their children
+Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
+                                     const ConditionsMap& previous,
+                                     ConditionsMap& alignments)  const
+{
+  Calculator::Context context(alignments);
+  context.previous = &previous;
+  return Calculator().execute(context, deltas);
 }
 
 /// Compute all alignment conditions of the internal dependency list
@@ -160,6 +160,8 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
         DetectorData* src_data = dynamic_cast<DetectorData*>(source);
         if( tar_data != nullptr && src_data != nullptr )  {
           tar_data->adoptData(*src_data,false);
+          // The dispatch lists of the field overlay are not persistent
+          if ( description.field().isValid() ) description.field().compile();
           TTimeStamp stop;
           printout(ALWAYS,"DD4hepRootPersistency",
                    "+++ Successfully loaded detector description from file:%s  [%8.3f seconds]",
@@ -732,6 +732,8 @@ void DetectorImp::endDocument(bool close_geometry)    {
   ShapePatcher patcher(m_volManager, m_world);
   patcher.patchShapes();
   mapDetectorTypes();
+  // Flatten the field overlay with the final bounding boxes of the components
+  if ( m_field.isValid() ) m_field.compile();
   m_state = READY;
   //DetectorGuard(this).unlock();
 }
@@ -12,8 +12,18 @@
 //==========================================================================
 
 #include "DD4hep/FieldTypes.h"
+#include "DD4hep/Printout.h"
 #include "DD4hep/detail/Handle.inl"
 #include <cmath>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace dd4hep;
@@ -37,6 +47,27 @@ DD4HEP_INSTANTIATE_HANDLE(ConstantField);
 DD4HEP_INSTANTIATE_HANDLE(SolenoidField);
 DD4HEP_INSTANTIATE_HANDLE(DipoleField);
 DD4HEP_INSTANTIATE_HANDLE(MultipoleField);
+DD4HEP_INSTANTIATE_HANDLE(TabulatedField);
+
+namespace {
+  /// Identifier of the binary field map file format
+  const char   s_fieldMapMagic[16] = "DD4hep-fieldmap";
+  /// Number of field maps which may be cached simultaneously by one thread
+  const size_t s_numCachedCells    = 4;
+
+  /// Field values at the corners of the last grid cell accessed
+  struct FieldCell  {
+    long  owner   { 0 };
+    long  index   { -1 };
+    /// Corner values. Component 3 is padding to allow for vectorized access
+    alignas(16) float corner[8][4];
+  };
+  /// Per thread cache of the last grid cells accessed
+  thread_local FieldCell s_fieldCells[s_numCachedCells];
+  thread_local size_t    s_nextFieldCell = 0;
+  /// Instance counter of tabulated fields
+  std::atomic<long>      s_numTabulatedFields { 0 };
+}
 
 /// Compute  the field components at a given location and add to given field
 void ConstantField::fieldComponents(const double* /* pos */, double* field) {
@@ -135,3 +166,213 @@ void MultipoleField::fieldComponents(const double* pos, double* field) {
     field[2] += B_z;
   }
 }
+
+/// Initializing constructor
+TabulatedField::TabulatedField()  {
+  type = CartesianField::MAGNETIC;
+}
+
+/// Compute the grid parameters after the grid was defined
+void TabulatedField::initialize()   {
+  long stride = numComponents();
+  for( int i = 2; i >= 0; --i )   {
+    if ( num[i] < 1 || (num[i] > 1 && !(upper[i] > lower[i])) )   {
+      except("TabulatedField","+++ %s: Invalid grid along axis %d: %d points from %g to %g.",
+             GetName(), i, num[i], lower[i], upper[i]);
+    }
+    m_invStep[i] = num[i] > 1 ? double(num[i]-1) / (upper[i]-lower[i]) : 0e0;
+    m_stride[i]  = num[i] > 1 ? stride : 0;
+    stride *= num[i];
+  }
+  // New grid: invalidate all cached cells of this instance
+  m_id = ++s_numTabulatedFields;
+  // The field vanishes outside the grid: define the bounding box
+  double lo[3], up[3];
+  if ( coordinates == RZ )   {
+    lo[0] = offset.X() - upper[0]; up[0] = offset.X() + upper[0];
+    lo[1] = offset.Y() - upper[0]; up[1] = offset.Y() + upper[0];
+    lo[2] = offset.Z() + lower[1]; up[2] = offset.Z() + upper[1];
+  }
+  else   {
+    lo[0] = offset.X() + lower[0]; up[0] = offset.X() + upper[0];
+    lo[1] = offset.Y() + lower[1]; up[1] = offset.Y() + upper[1];
+    lo[2] = offset.Z() + lower[2]; up[2] = offset.Z() + upper[2];
+  }
+  setBoundingBox(lo, up);
+  if ( coordinates == RZ && (num[2] != 1 || lower[0] < 0e0) )   {
+    except("TabulatedField","+++ %s: Invalid RZ grid: r must be positive and num[2] must be 1.",
+           GetName());
+  }
+}
+
+/// Define the grid and the field values from memory. Values are copied
+void TabulatedField::setGrid(int coords, const int n[3], const double lo[3], const double up[3],
+                             const vector<float>& values)
+{
+  coordinates = coords;
+  for( int i = 0; i < 3; ++i )   {
+    num[i]   = n[i];
+    lower[i] = lo[i];
+    upper[i] = up[i];
+  }
+  if ( values.size() != numPoints() * numComponents() )   {
+    except("TabulatedField","+++ %s: Grid of %ld points requires %ld values, but %ld are given.",
+           GetName(), long(numPoints()), long(numPoints() * numComponents()), long(values.size()));
+  }
+  auto data = make_shared<vector<float> >(values);
+  initialize();
+  m_values  = data->data();
+  m_storage = data;
+}
+
+/// Load the field map from a binary file. Positions are scaled by lunit, values by funit
+void TabulatedField::load(const string& file_name, double lunit, double funit, bool use_mmap)  {
+  Header hdr;
+  struct stat st;
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &st) != 0 )   {
+    if ( fd >= 0 ) ::close(fd);
+    except("TabulatedField","+++ %s: Cannot open field map %s: %s",
+           GetName(), file_name.c_str(), ::strerror(errno));
+  }
+  if ( size_t(st.st_size) < sizeof(Header) ||
+       ::pread(fd, &hdr, sizeof(Header), 0) != ssize_t(sizeof(Header)) ||
+       ::memcmp(hdr.magic, s_fieldMapMagic, sizeof(s_fieldMapMagic)) != 0 || hdr.version != 1 ||
+       (hdr.coordinates != XYZ && hdr.coordinates != RZ) )   {
+    ::close(fd);
+    except("TabulatedField","+++ %s: %s is no valid field map file.",
+           GetName(), file_name.c_str());
+  }
+  coordinates = hdr.coordinates;
+  for( int i = 0; i < 3; ++i )   {
+    num[i]   = hdr.num[i];
+    lower[i] = hdr.lower[i] * lunit;
+    upper[i] = hdr.upper[i] * lunit;
+  }
+  size_t len = numPoints() * numComponents() * sizeof(float);
+  if ( size_t(st.st_size) != sizeof(Header) + len )   {
+    ::close(fd);
+    except("TabulatedField","+++ %s: Field map %s has a size of %ld bytes. Expected: %ld bytes.",
+           GetName(), file_name.c_str(), long(st.st_size), long(sizeof(Header) + len));
+  }
+  initialize();
+  void* addr = use_mmap ? ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  if ( addr != MAP_FAILED )   {
+    size_t map_len = st.st_size;
+    m_storage.reset(addr, [map_len](void* p) { ::munmap(p, map_len); });
+    m_values = (const float*)((const char*)addr + sizeof(Header));
+  }
+  else   {
+    auto data = make_shared<vector<float> >(len / sizeof(float));
+    if ( ::pread(fd, data->data(), len, sizeof(Header)) != ssize_t(len) )   {
+      ::close(fd);
+      except("TabulatedField","+++ %s: Failed to read field map %s: %s",
+             GetName(), file_name.c_str(), ::strerror(errno));
+    }
+    m_values  = data->data();
+    m_storage = data;
+  }
+  ::close(fd);
+  scale = funit;
+  printout(DEBUG,"TabulatedField","+++ %s: Loaded %s field map %s with %ld grid points [%s].",
+           GetName(), coordinates == RZ ? "RZ" : "XYZ", file_name.c_str(), long(numPoints()),
+           addr != MAP_FAILED ? "mapped" : "read");
+}
+
+/// Save the field map to a binary file
+void TabulatedField::save(const string& file_name)  const   {
+  Header hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_fieldMapMagic, sizeof(s_fieldMapMagic));
+  hdr.version     = 1;
+  hdr.coordinates = coordinates;
+  for( int i = 0; i < 3; ++i )   {
+    hdr.num[i]   = num[i];
+    hdr.lower[i] = lower[i];
+    hdr.upper[i] = upper[i];
+  }
+  ofstream out(file_name, ios::binary);
+  out.write((const char*)&hdr, sizeof(hdr));
+  if ( m_values )   {
+    out.write((const char*)m_values, numPoints() * numComponents() * sizeof(float));
+  }
+  if ( !out.good() )   {
+    except("TabulatedField","+++ %s: Failed to write field map %s.", GetName(), file_name.c_str());
+  }
+}
+
+/// Compute  the field components at a given location and add to given field
+void TabulatedField::fieldComponents(const double* pos, double* field) {
+  if ( !m_values ) return;
+  double x = pos[0] - offset.X(), y = pos[1] - offset.Y(), z = pos[2] - offset.Z(), r = 0e0;
+  double u[3];
+  if ( coordinates == RZ )   {
+    r    = std::sqrt(x*x + y*y);
+    u[0] = (r - lower[0]) * m_invStep[0];
+    u[1] = (z - lower[1]) * m_invStep[1];
+    u[2] = 0e0;
+  }
+  else   {
+    u[0] = (x - lower[0]) * m_invStep[0];
+    u[1] = (y - lower[1]) * m_invStep[1];
+    u[2] = (z - lower[2]) * m_invStep[2];
+  }
+  long   cell = 0;
+  float  frac[3];
+  for( int i = 0; i < 3; ++i )   {
+    // Outside the grid (or NaN): no contribution
+    if ( !(u[i] >= 0e0 && u[i] <= double(num[i]-1)) ) return;
+    int idx = num[i] > 1 ? std::min(int(u[i]), num[i]-2) : 0;
+    frac[i] = float(u[i] - idx);
+    cell = cell * num[i] + idx;
+  }
+  // Look for the cell in the thread local cache. Otherwise load the corner values.
+  FieldCell* c = s_fieldCells;
+  FieldCell* e = s_fieldCells + s_numCachedCells;
+  for( ; c != e && c->owner != m_id; ++c );
+  if ( c == e )   {
+    c = s_fieldCells + (s_nextFieldCell++ % s_numCachedCells);
+    c->owner = m_id;
+    c->index = -1;
+  }
+  if ( c->index != cell )   {
+    const int    ncomp = numComponents();
+    const float* base  = m_values + cell * ncomp;
+    for( int k = 0; k < 8; ++k )   {
+      const float* v = base
+        + ((k & 4) ? m_stride[0] : 0)
+        + ((k & 2) ? m_stride[1] : 0)
+        + ((k & 1) ? m_stride[2] : 0);
+      c->corner[k][0] = v[0];
+      c->corner[k][1] = v[1];
+      c->corner[k][2] = ncomp > 2 ? v[2] : 0e0f;
+      c->corner[k][3] = 0e0f;
+    }
+    c->index = cell;
+  }
+  // Trilinear interpolation: weighted sum over the 8 corners.
+  // Fixed trip counts and padded corner values so that the loops vectorize.
+  float w[8], b[4] = { 0e0f, 0e0f, 0e0f, 0e0f };
+  const float gx[2] = { 1e0f - frac[0], frac[0] };
+  const float gy[2] = { 1e0f - frac[1], frac[1] };
+  const float gz[2] = { 1e0f - frac[2], frac[2] };
+  for( int k = 0; k < 8; ++k )
+    w[k] = gx[(k>>2)&1] * gy[(k>>1)&1] * gz[k&1];
+  for( int k = 0; k < 8; ++k )   {
+    for( int j = 0; j < 4; ++j )
+      b[j] += w[k] * c->corner[k][j];
+  }
+  if ( coordinates == RZ )   {
+    // b[0] = Br, b[1] = Bz
+    if ( r > 0e0 )   {
+      double br = scale * b[0] / r;
+      field[0] += br * x;
+      field[1] += br * y;
+    }
+    field[2] += scale * b[1];
+    return;
+  }
+  field[0] += scale * b[0];
+  field[1] += scale * b[1];
+  field[2] += scale * b[2];
+}
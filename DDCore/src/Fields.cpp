@@ -15,6 +15,9 @@
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/detail/Handle.inl"
 
+// C/C++ include files
+#include <limits>
+
 using namespace std;
 using namespace dd4hep;
 
@@ -25,15 +28,30 @@ typedef OverlayedField::Object OverlayedFieldObject;
 DD4HEP_INSTANTIATE_HANDLE(OverlayedFieldObject);
 
 namespace {
-  void calculate_combined_field(vector<CartesianField>& v, const double* pos, double* field) {
+  void calculate_combined_field(const OverlayedField::Object::Components& v, const double* pos, double* field) {
     for (const auto& i : v ) i.value(pos, field);
   }
+  OverlayedField::Object::Component make_component(const CartesianField& f)  {
+    OverlayedField::Object::Component c;
+    CartesianField::Object* o = f.data<CartesianField::Object>();
+    c.object  = o;
+    c.bounded = o->bounded();
+    for( int i = 0; i < 3; ++i )  {
+      c.minimum[i] = o->minimum[i];
+      c.maximum[i] = o->maximum[i];
+    }
+    return c;
+  }
 }
 
 /// Default constructor
 CartesianField::Object::Object()
   : NamedObject(), type(UNKNOWN) {
   InstanceCount::increment(this);
+  for( int i = 0; i < 3; ++i )  {
+    minimum[i] = -numeric_limits<double>::infinity();
+    maximum[i] =  numeric_limits<double>::infinity();
+  }
 }
 
 /// Default destructor
@@ -41,6 +59,23 @@ CartesianField::Object::~Object() {
   InstanceCount::decrement(this);
 }
 
+/// Define the bounding box of the region with non-vanishing field
+void CartesianField::Object::setBoundingBox(const double* lower, const double* upper)  {
+  for( int i = 0; i < 3; ++i )  {
+    minimum[i] = lower[i];
+    maximum[i] = upper[i];
+  }
+}
+
+/// Check if the bounding box of the field is finite along any axis
+bool CartesianField::Object::bounded() const  {
+  const double inf = numeric_limits<double>::infinity();
+  for( int i = 0; i < 3; ++i )  {
+    if ( minimum[i] > -inf || maximum[i] < inf ) return true;
+  }
+  return false;
+}
+
 /// Access the field type (string)
 const char* CartesianField::type() const {
   return m_element->GetTitle();
@@ -110,12 +145,14 @@ void OverlayedField::add(CartesianField field) {
       if (isEle) {
         vector < CartesianField > &v = o->electric_components;
         v.emplace_back(field);
+        o->electric_dispatch.emplace_back(make_component(field));
         o->type |= field.ELECTRIC;
         o->electric = v.size() == 1 ? field : CartesianField();
       }
       if (isMag) {
         vector < CartesianField > &v = o->magnetic_components;
         v.emplace_back(field);
+        o->magnetic_dispatch.emplace_back(make_component(field));
         o->type |= field.MAGNETIC;
         o->magnetic = v.size() == 1 ? field : CartesianField();
       }
@@ -128,22 +165,35 @@ void OverlayedField::add(CartesianField field) {
   throw runtime_error("OverlayedField::add: Attempt to add an invalid field.");
 }
 
+/// Rebuild the dispatch lists from the field components
+void OverlayedField::compile() {
+  Object* o = data<Object>();
+  if ( !o )
+    throw runtime_error("OverlayedField::compile: Attempt to compile an invalid object.");
+  o->electric_dispatch.clear();
+  o->magnetic_dispatch.clear();
+  for( const auto& f : o->electric_components )
+    o->electric_dispatch.emplace_back(make_component(f));
+  for( const auto& f : o->magnetic_components )
+    o->magnetic_dispatch.emplace_back(make_component(f));
+}
+
 /// Returns the 3 electric field components (x, y, z).
 void OverlayedField::combinedElectric(const double* pos, double* field) const {
   field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->electric_components, pos, field);
+  calculate_combined_field(data<Object>()->electric_dispatch, pos, field);
 }
 
 /// Returns the 3  magnetic field components (x, y, z).
 void OverlayedField::combinedMagnetic(const double* pos, double* field) const {
   field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(data<Object>()->magnetic_components, pos, field);
+  calculate_combined_field(data<Object>()->magnetic_dispatch, pos, field);
 }
 
 /// Returns the 3 electric (val[0]-val[2]) and magnetic field components (val[3]-val[5]).
 void OverlayedField::electromagneticField(const double* pos, double* field) const {
   Object* o = data<Object>();
   field[0] = field[1] = field[2] = 0.;
-  calculate_combined_field(o->electric_components, pos, field);
-  calculate_combined_field(o->magnetic_components, pos, field + 3);
+  calculate_combined_field(o->electric_dispatch, pos, field);
+  calculate_combined_field(o->magnetic_dispatch, pos, field + 3);
 }
@@ -29,11 +29,13 @@ namespace {
     BitFieldCoder& bf = o->decoder;
     o->fieldIDs.clear();
     o->fieldMap.clear();
+    o->fieldKeys.clear();
     o->description = dsc;
     for (size_t i = 0; i < bf.size(); ++i) {
       const BitFieldElement* f = &bf[i];
       o->fieldIDs.emplace_back(i, f->name());
       o->fieldMap.emplace_back(f->name(), f);
+      o->fieldKeys.emplace_back(VolIDName::intern(f->name()), f);
     }
   }
 }
@@ -105,6 +107,17 @@ const BitFieldElement* IDDescriptor::field(size_t identifier) const {
   return fm[identifier].second;
 }
 
+/// Get the field descriptor of one field by its interned name
+const BitFieldElement* IDDescriptor::field(const VolIDName& field_name) const {
+  const auto& keys = data<Object>()->fieldKeys;
+  for (const auto& i : keys )
+    if (i.first == field_name.key())
+      return i.second;
+  except("IDDescriptor","dd4hep: %s: This ID descriptor has no field with the name: %s",
+         name(),field_name.c_str());
+  throw runtime_error("dd4hep");  // Never called. Simply make the compiler happy!
+}
+
 /// Get the field identifier of one field by name
 size_t IDDescriptor::fieldID(const string& field_name) const {
   const FieldIDs& fm = ids();   // This already checks the object validity
@@ -147,6 +160,96 @@ VolumeID IDDescriptor::encode_reverse(const std::vector<std::pair<std::string, i
   return detail::reverseBits<VolumeID>(encode(id_vector));
 }
 
+/// Compute the submask for a given set of volume IDs with interned field names
+VolumeID IDDescriptor::get_mask(const PlacedVolume::VolIDs& ids) const   {
+  VolumeID mask = 0ULL;
+  for (const auto& i : ids )   {
+    const auto* fld = field(i.first);
+    mask |= fld->mask();
+  }
+  return mask;
+}
+
+/// Encode a set of volume identifiers with interned field names to a volumeID.
+VolumeID IDDescriptor::encode(const PlacedVolume::VolIDs& ids) const
+{
+  VolumeID id = 0;
+  for (const auto& i : ids )  {
+    const BitFieldElement* fld = field(i.first);
+    int      off = fld->offset();
+    VolumeID val = i.second;
+    id |= ((fld->value(val << off) << off)&fld->mask());
+  }
+  return id;
+}
+
+/// Encode a set of volume identifiers with interned field names to a volumeID with the system ID on the top bits
+VolumeID IDDescriptor::encode_reverse(const PlacedVolume::VolIDs& ids) const
+{
+  return detail::reverseBits<VolumeID>(encode(ids));
+}
+
+/// Create a precompiled encoder for a fixed sequence of fields
+IDDescriptor::Encoder IDDescriptor::encoder(const vector<string>& field_names) const   {
+  return Encoder(*this, field_names);
+}
+
+namespace {
+  /// Fill the encoding parameters of one field
+  IDDescriptor::Encoder::Field _encoder_field(const BitFieldElement* fld)   {
+    IDDescriptor::Encoder::Field f;
+    f.mask     = fld->mask();
+    f.offset   = int(fld->offset());
+    f.minValue = fld->minValue();
+    f.maxValue = fld->maxValue();
+    return f;
+  }
+}
+
+/// Initializing constructor from a sequence of field names
+IDDescriptor::Encoder::Encoder(const IDDescriptor& descriptor, const vector<string>& field_names)  {
+  m_fields.reserve(field_names.size());
+  for (const auto& n : field_names )   {
+    m_fields.emplace_back(_encoder_field(descriptor.field(n)));
+    m_mask |= m_fields.back().mask;
+  }
+}
+
+/// Initializing constructor from the field names of a set of volume identifiers
+IDDescriptor::Encoder::Encoder(const IDDescriptor& descriptor, const PlacedVolume::VolIDs& ids)  {
+  m_fields.reserve(ids.size());
+  for (const auto& i : ids )   {
+    m_fields.emplace_back(_encoder_field(descriptor.field(i.first)));
+    m_mask |= m_fields.back().mask;
+  }
+}
+
+/// Check if all values fit into their fields. Returns the index of the first bad value or -1
+int IDDescriptor::Encoder::inRange(const int* values)  const   {
+  for (size_t i = 0; i < m_fields.size(); ++i )   {
+    const Field& f = m_fields[i];
+    if ( values[i] < f.minValue || values[i] > f.maxValue )
+      return int(i);
+  }
+  return -1;
+}
+
+/// Encode num_ids volumeIDs. The values are stored row-wise: values[num_ids][size()]
+void IDDescriptor::Encoder::encode(const int* values, size_t num_ids, VolumeID* ids)  const   {
+  const size_t n = m_fields.size();
+  const Field* f = m_fields.data();
+  for (size_t j = 0; j < num_ids; ++j )
+    ids[j] = 0;
+  // Field-major loop: the inner loop has a constant shift and mask and vectorizes
+  for (size_t i = 0; i < n; ++i )   {
+    const VolumeID mask = f[i].mask;
+    const int      off  = f[i].offset;
+    const int*     v    = values + i;
+    for (size_t j = 0; j < num_ids; ++j )
+      ids[j] |= (VolumeID(v[j*n]) << off) & mask;
+  }
+}
+
 /// Decode volume IDs and return filled descriptor with all fields
 void IDDescriptor::decodeFields(VolumeID vid,
                                 vector<pair<const BitFieldElement*, VolumeID> >& flds)  const
@@ -19,6 +19,7 @@
 
 // C/C++ header files
 #include <cstring>
+#include <cstddef>
 
 using namespace std;
 using namespace dd4hep;
@@ -180,5 +181,65 @@ void* OpaqueDataBlock::bind(void* ptr, size_t size, const BasicGrammar* g)   {
   return 0;
 }
 
+/// Bind data value. Payloads not fitting the inline buffer are allocated from the arena
+void* OpaqueDataBlock::bind(const BasicGrammar* g, OpaqueDataArena& arena)   {
+  if ( (type&EXTERN_DATA) == EXTERN_DATA )  {
+    except("OpaqueData","Extern data may not be bound!");
+  }
+  else if ( !grammar )  {
+    size_t len = g->sizeOf();
+    grammar = g;
+    // Arena memory is owned by the arena: same treatment as stack data
+    (len > sizeof(data))
+      ? (pointer=arena.allocate(len),type=STACK_DATA)
+      : (pointer=data,type=PLAIN_DATA);
+    return pointer;
+  }
+  else if ( grammar == g )  {
+    // We cannot ingore secondary requests for data bindings.
+    // This leads to memory leaks in the caller!
+    except("OpaqueData","You may not bind opaque data multiple times!");
+  }
+  typeinfoCheck(grammar->type(),g->type(),"Opaque data blocks may not be assigned.");
+  return 0;
+}
+
+/// Initializing constructor
+OpaqueDataArena::OpaqueDataArena(size_t chunk_size) : m_chunkSize(chunk_size)  {
+  InstanceCount::increment(this);
+}
+
+/// Default destructor. Releases all memory chunks
+OpaqueDataArena::~OpaqueDataArena()   {
+  for( unsigned char* c : m_chunks ) ::operator delete(c);
+  m_chunks.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Allocate a memory block (aligned to alignof(std::max_align_t))
+void* OpaqueDataArena::allocate(size_t len)   {
+  constexpr size_t align = alignof(std::max_align_t);
+  len = (len + align - 1) & ~(align - 1);
+  if ( len > m_free )  {
+    if ( len > m_chunkSize/4 )  {
+      // Large blocks get their own chunk. Keep the current chunk for small ones
+      unsigned char* c = (unsigned char*)::operator new(len);
+      m_chunks.emplace_back(c);
+      m_reserved  += len;
+      m_allocated += len;
+      return c;
+    }
+    m_next = (unsigned char*)::operator new(m_chunkSize);
+    m_free = m_chunkSize;
+    m_reserved += m_chunkSize;
+    m_chunks.emplace_back(m_next);
+  }
+  void* ptr    = m_next;
+  m_next      += len;
+  m_free      -= len;
+  m_allocated += len;
+  return ptr;
+}
+
 #include "DD4hep/GrammarUnparsed.h"
 static auto s_registry = GrammarRegistry::pre_note<OpaqueDataBlock>(1);
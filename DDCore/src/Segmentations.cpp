@@ -87,6 +87,11 @@ void Segmentation::neighbours(const CellID& cell, std::set<CellID>& nb) const  {
   access()->segmentation->neighbours(cell, nb);
 }
 
+/// Fills the neighbours of the given cell ID into a caller supplied buffer. Returns the number of neighbours
+size_t Segmentation::findNeighbours(const CellID& cell, int type, CellID* buffer, size_t capacity) const  {
+  return access()->segmentation->findNeighbours(cell, type, buffer, capacity);
+}
+
 /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
  *  in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
  *
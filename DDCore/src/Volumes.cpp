@@ -31,13 +31,17 @@
 #include "TGeoShapeAssembly.h"
 #include "TGeoScaledShape.h"
 #include "TMap.h"
+#include "TBuffer.h"
 
 // C/C++ include files
+#include <mutex>
+#include <atomic>
 #include <climits>
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <unordered_map>
 
 using namespace std;
 using namespace dd4hep;
@@ -379,28 +383,177 @@ void PlacedVolumeExtension::Release() const  {
   if ( 0 == ext->refCount ) delete ext;
 }
 
+namespace {
+
+  /// Process wide pool of the volume identifier names
+  /**
+   *  The names are stored in chunks, which are never moved nor released.
+   *  Hence the lookup by key needs no lock.
+   */
+  class VolIDNamePool  {
+  public:
+    enum { CHUNK_BITS = 8, CHUNK_SIZE = 1<<CHUNK_BITS, NUM_CHUNKS = 256 };
+    typedef VolIDName::key_type key_type;
+
+    mutex                            lock;
+    unordered_map<string, key_type>  keys;
+    atomic<string*>                  chunks[NUM_CHUNKS];
+    atomic<size_t>                   count  { 0 };
+    atomic<size_t>                   bytes  { 0 };
+
+    /// Default constructor. Key 0 is the empty name
+    VolIDNamePool()   {
+      for( auto& c : chunks ) c.store(nullptr);
+      intern("");
+    }
+    /// Access the pool. The pool is intentionally never deleted
+    static VolIDNamePool& instance()   {
+      static VolIDNamePool* pool = new VolIDNamePool();
+      return *pool;
+    }
+    /// Intern a name and return its key
+    key_type intern(const string& nam)   {
+      lock_guard<mutex> guard(lock);
+      auto i = keys.find(nam);
+      if ( i != keys.end() )   {
+        return i->second;
+      }
+      size_t key = count.load();
+      if ( key >= size_t(NUM_CHUNKS*CHUNK_SIZE) )   {
+        except("VolIDName","+++ Too many volume identifier names [%ld]. Cannot intern: %s",
+               long(key), nam.c_str());
+      }
+      string* chunk = chunks[key>>CHUNK_BITS].load(memory_order_acquire);
+      if ( !chunk )   {
+        chunk = new string[CHUNK_SIZE];
+        chunks[key>>CHUNK_BITS].store(chunk, memory_order_release);
+        bytes += CHUNK_SIZE*sizeof(string);
+      }
+      chunk[key&(CHUNK_SIZE-1)] = nam;
+      keys.emplace(nam, key_type(key));
+      bytes += 2*(nam.capacity() > 15 ? nam.capacity()+1 : 0) + sizeof(string) + sizeof(key_type) + 2*sizeof(void*);
+      count.store(key+1, memory_order_release);
+      return key_type(key);
+    }
+    /// Access the name corresponding to a key
+    const string& name(key_type key)  const  {
+      return chunks[key>>CHUNK_BITS].load(memory_order_acquire)[key&(CHUNK_SIZE-1)];
+    }
+  };
+}
+
+/// Intern a name and return its key
+VolIDName::key_type VolIDName::intern(const string& nam)   {
+  return VolIDNamePool::instance().intern(nam);
+}
+
+/// Access the name corresponding to a key
+const string& VolIDName::name(key_type key)   {
+  return VolIDNamePool::instance().name(key);
+}
+
+/// Number of names in the pool
+size_t VolIDName::size()   {
+  return VolIDNamePool::instance().count.load();
+}
+
+/// Memory used by the pool in bytes (approximate)
+size_t VolIDName::memoryUsage()   {
+  return VolIDNamePool::instance().bytes.load();
+}
+
+/// Stream interned name
+ostream& dd4hep::operator<<(ostream& os, const VolIDName& nam)   {
+  return os << nam.str();
+}
+
+/// Move constructor
+PlacedVolumeExtension::VolIDs::VolIDs(VolIDs&& copy)   {
+  *this = move(copy);
+}
+
+/// Copy constructor
+PlacedVolumeExtension::VolIDs::VolIDs(const VolIDs& copy)   {
+  *this = copy;
+}
+
+/// Default destructor
+PlacedVolumeExtension::VolIDs::~VolIDs()   {
+  if ( m_data != m_inline ) delete [] m_data;
+}
+
+/// Move assignment
+PlacedVolumeExtension::VolIDs& PlacedVolumeExtension::VolIDs::operator=(VolIDs&& copy)   {
+  if ( this != &copy )   {
+    if ( copy.m_data != copy.m_inline )   {
+      if ( m_data != m_inline ) delete [] m_data;
+      m_data          = copy.m_data;
+      m_size          = copy.m_size;
+      m_capacity      = copy.m_capacity;
+      copy.m_data     = copy.m_inline;
+      copy.m_capacity = INLINE_CAPACITY;
+    }
+    else   {
+      *this = static_cast<const VolIDs&>(copy);
+    }
+    copy.m_size = 0;
+  }
+  return *this;
+}
+
+/// Assignment operator
+PlacedVolumeExtension::VolIDs& PlacedVolumeExtension::VolIDs::operator=(const VolIDs& copy)   {
+  if ( this != &copy )   {
+    m_size = 0;
+    reserve(copy.m_size);
+    std::copy(copy.begin(), copy.end(), m_data);
+    m_size = copy.m_size;
+  }
+  return *this;
+}
+
+/// Ensure the storage can hold the requested number of identifiers
+void PlacedVolumeExtension::VolIDs::grow(size_type num)   {
+  size_type cap  = std::max(size_type(2*m_capacity), num);
+  VolID*    data = new VolID[cap];
+  std::copy(begin(), end(), data);
+  if ( m_data != m_inline ) delete [] m_data;
+  m_data     = data;
+  m_capacity = (unsigned int)cap;
+}
+
 /// Lookup volume ID
-vector<PlacedVolumeExtension::VolID>::const_iterator
+PlacedVolumeExtension::VolIDs::const_iterator
 PlacedVolumeExtension::VolIDs::find(const string& name) const {
-  for (Base::const_iterator i = this->Base::begin(); i != this->Base::end(); ++i)
+  for (const_iterator i = this->begin(); i != this->end(); ++i)
+    if (name == (*i).first)
+      return i;
+  return this->end();
+}
+
+/// Lookup volume ID
+PlacedVolumeExtension::VolIDs::const_iterator
+PlacedVolumeExtension::VolIDs::find(const VolIDName& name) const {
+  for (const_iterator i = this->begin(); i != this->end(); ++i)
     if (name == (*i).first)
       return i;
   return this->end();
 }
 
 /// Insert a new value into the volume ID container
-std::pair<vector<PlacedVolumeExtension::VolID>::iterator, bool>
+std::pair<PlacedVolumeExtension::VolIDs::iterator, bool>
 PlacedVolumeExtension::VolIDs::insert(const string& name, int value) {
-  Base::iterator i = this->Base::begin();
-  for (; i != this->Base::end(); ++i)
-    if (name == (*i).first)
+  VolIDName nam(name);
+  iterator i = this->begin();
+  for (; i != this->end(); ++i)
+    if (nam == (*i).first)
       break;
   //
-  if (i != this->Base::end()) {
+  if (i != this->end()) {
     return make_pair(i, false);
   }
-  i = this->Base::emplace(this->Base::end(), name, value);
-  return make_pair(i, true);
+  this->push_back(VolID(nam, value));
+  return make_pair(this->end()-1, true);
 }
 
 /// String representation for debugging
@@ -414,6 +567,43 @@ string PlacedVolumeExtension::VolIDs::str()  const   {
   return str.str();
 }
 
+/// ROOT I/O: The field names are streamed as strings. The keys are local to the process
+void PlacedVolumeExtension::VolIDs::Streamer(TBuffer& buff)   {
+  if ( buff.IsReading() )   {
+    UInt_t start = 0, count = 0;
+    Version_t version = buff.ReadVersion(&start, &count, Class());
+    this->clear();
+    if ( version < 2 )   {
+      // Files written before the compact representation: std::vector<std::pair<std::string,int> >
+      // (see the test Persist_Legacy_VolIDs_Restore reading examples/DDCodex/Upgrade.root)
+      vector<pair<string, int> > ids;
+      TClass::GetClass(typeid(ids))->Streamer(&ids, buff);
+      this->insert(ids.begin(), ids.end());
+    }
+    else   {
+      Int_t num = 0;
+      buff >> num;
+      this->reserve(num);
+      for( Int_t i = 0; i < num; ++i )   {
+        string nam;
+        Int_t  value = 0;
+        buff.ReadStdString(&nam);
+        buff >> value;
+        this->push_back(VolID(nam, value));
+      }
+    }
+    buff.CheckByteCount(start, count, Class());
+    return;
+  }
+  UInt_t count = buff.WriteVersion(Class(), kTRUE);
+  buff << Int_t(m_size);
+  for( const auto& i : *this )   {
+    buff.WriteStdString(&i.first.str());
+    buff << Int_t(i.second);
+  }
+  buff.SetByteCount(count, kTRUE);
+}
+
 /// Check if placement is properly instrumented
 PlacedVolume::Object* PlacedVolume::data() const   {
   PlacedVolume::Object* o = _userExtension(*this);
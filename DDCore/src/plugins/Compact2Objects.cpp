@@ -40,6 +40,7 @@
 // Root/TGeo include files
 #include <TGeoManager.h>
 #include <TGeoMaterial.h>
+#include <TGeoBBox.h>
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
 #include <TGeoPhysicalConstants.h>
 #endif
@@ -49,7 +50,9 @@
 #include <TMath.h>
 
 // C/C++ include files
+#include <cmath>
 #include <climits>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <set>
@@ -186,6 +189,10 @@ static Ref_t create_SolenoidField(Detector& description, xml_h e) {
     ptr->minZ = c.attr<double>(_U(zmin));
   else
     ptr->minZ = -ptr->maxZ;
+  // The field vanishes outside the solenoid: define the bounding box
+  double rmax = ptr->outerField == 0e0 ? ptr->innerRadius : ptr->outerRadius;
+  double lower[3] = { -rmax, -rmax, ptr->minZ }, upper[3] = { rmax, rmax, ptr->maxZ };
+  ptr->setBoundingBox(lower, upper);
   obj.assign(ptr, c.nameStr(), c.typeStr());
   return obj;
 }
@@ -217,6 +224,8 @@ static Ref_t create_DipoleField(Detector& /* description */, xml_h e) {
       val = _multiply<double>(coll.text(), mult);
     ptr->coefficents.emplace_back(val);
   }
+  double lower[3] = { -ptr->rmax, -ptr->rmax, ptr->zmin }, upper[3] = { ptr->rmax, ptr->rmax, ptr->zmax };
+  ptr->setBoundingBox(lower, upper);
   obj.assign(ptr, c.nameStr(), c.typeStr());
   return obj;
 }
@@ -245,6 +254,27 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
   }
   ptr->B_z = bz;
   ptr->transform = Transform3D(rot,pos).Inverse();
+  if ( ptr->volume.isValid() )  {
+    // The field vanishes outside the shape: bounding box of the placed shape
+    TGeoBBox* bbox = dynamic_cast<TGeoBBox*>(ptr->volume.ptr());
+    if ( bbox )  {
+      Transform3D placement(rot,pos);
+      const Double_t* o = bbox->GetOrigin();
+      double d[3] = { bbox->GetDX(), bbox->GetDY(), bbox->GetDZ() };
+      double lower[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL }, upper[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL };
+      for( int k = 0; k < 8; ++k )  {
+        Transform3D::Point p = placement * Transform3D::Point(o[0] + ((k&1) ? d[0] : -d[0]),
+                                                              o[1] + ((k&2) ? d[1] : -d[1]),
+                                                              o[2] + ((k&4) ? d[2] : -d[2]));
+        double corner[3] = { p.X(), p.Y(), p.Z() };
+        for( int i = 0; i < 3; ++i )  {
+          lower[i] = std::min(lower[i], corner[i]);
+          upper[i] = std::max(upper[i], corner[i]);
+        }
+      }
+      ptr->setBoundingBox(lower, upper);
+    }
+  }
   for (xml_coll_t coll(c, _U(coefficient)); coll; ++coll, mult /= lunit) {
     xml_dim_t coeff = coll;
     if ( coll.hasAttr(_U(value)) )
@@ -260,6 +290,30 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+/** Create a tabulated magnetic field from a binary field map file
+ *
+ *  <field name="Map" type="FieldMap" file="map.bin" lunit="mm" funit="tesla" mmap="true">
+ *    <position x="0" y="0" z="0"/>
+ *  </field>
+ */
+static Ref_t create_TabulatedField(Detector& /* description */, xml_h e) {
+  xml_dim_t c(e), child;
+  CartesianField obj;
+  TabulatedField* ptr = new TabulatedField();
+  double lunit = c.hasAttr(_U(lunit)) ? c.attr<double>(_U(lunit)) : 1.0;
+  double funit = c.hasAttr(_U(funit)) ? c.attr<double>(_U(funit)) : 1.0;
+  bool   mmap  = c.hasAttr(_Unicode(mmap)) ? c.attr<bool>(_Unicode(mmap)) : true;
+  string file  = c.attr<string>(_U(file));
+
+  if ((child = c.child(_U(position), false))) {   // Position is not mandatory!
+    ptr->offset.SetXYZ(child.x(), child.y(), child.z());
+  }
+  obj.assign(ptr, c.nameStr(), c.typeStr());
+  ptr->load(file, lunit, funit, mmap);
+  return obj;
+}
+DECLARE_XMLELEMENT(FieldMap,create_TabulatedField)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
@@ -825,7 +825,7 @@ xml_h LCDDConverter::handlePlacement(const string& name,PlacedVolume node) const
         const PlacedVolume::VolIDs& ids = node.volIDs();
         for (PlacedVolume::VolIDs::const_iterator i = ids.begin(); i != ids.end(); ++i) {
           xml_h pvid = xml_elt_t(geo.doc, _U(physvolid));
-          pvid.setAttr(_U(field_name), (*i).first);
+          pvid.setAttr(_U(field_name), (*i).first.str());
           pvid.setAttr(_U(value), (*i).second);
           place.append(pvid);
         }
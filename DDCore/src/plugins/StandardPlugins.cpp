@@ -1522,6 +1522,57 @@ static long detectortype_cache(Detector& description, int , char** ) {
 }
 DECLARE_APPLY(DD4hep_DetectorTypes,detectortype_cache)
 
+/// Basic entry point to measure the memory used by the volume identifiers of all placements
+/**
+ *  Factory: DD4hep_VolIDMemory
+ *
+ *  Compares the memory used by the compact volume identifiers with interned field
+ *  names to the former representation std::vector<std::pair<std::string,int> >.
+ *  The heap usage is estimated assuming 16 byte aligned blocks with 8 bytes overhead.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long volid_memory(Detector& description, int , char** ) {
+  typedef PlacedVolumeExtension::VolIDs VolIDs;
+  typedef pair<string, int>             LegacyID;
+  auto heap_block = [](size_t len)  {  return len == 0 ? 0 : ((len + 8 + 15) / 16) * 16;  };
+  size_t num_placements = 0, num_ids = 0, num_heap = 0;
+  size_t legacy = 0, compact = 0;
+  size_t common = sizeof(PlacedVolumeExtension) - sizeof(VolIDs);
+  TObjArray* vols = description.manager().GetListOfVolumes();
+  for( Int_t i = 0; i < vols->GetEntriesFast(); ++i )   {
+    TGeoVolume* vol = (TGeoVolume*)vols->At(i);
+    for( Int_t j = 0, n = vol->GetNdaughters(); j < n; ++j )   {
+      PlacedVolume pv = vol->GetNode(j);
+      if ( !pv.data() ) continue;
+      const VolIDs& ids = pv.volIDs();
+      ++num_placements;
+      num_ids += ids.size();
+      legacy  += common + sizeof(vector<LegacyID>) + heap_block(ids.size()*sizeof(LegacyID));
+      for( const auto& id : ids )   {
+        if ( id.first.str().length() > 15 )   // Beyond the small string buffer of libstdc++
+          legacy += heap_block(id.first.str().length()+1);
+      }
+      compact += common + sizeof(VolIDs) + heap_block(ids.heapUsage());
+      num_heap += ids.heapUsage() > 0 ? 1 : 0;
+    }
+  }
+  compact += VolIDName::memoryUsage();
+  printout(ALWAYS,"VolIDMemory","+++ Placements: %ld with %ld volume identifiers. "
+           "%ld containers exceed the inline capacity of %d identifiers.",
+           long(num_placements), long(num_ids), long(num_heap), int(VolIDs::INLINE_CAPACITY));
+  printout(ALWAYS,"VolIDMemory","+++ Interned field names: %ld using %ld bytes.",
+           long(VolIDName::size()), long(VolIDName::memoryUsage()));
+  printout(ALWAYS,"VolIDMemory","+++ Placement extensions: before: %.3f MB [std::vector<std::pair<std::string,int> >] "
+           "after: %.3f MB [interned] saved: %.1f %%",
+           double(legacy)/1024e0/1024e0, double(compact)/1024e0/1024e0,
+           legacy > 0 ? 100e0*(double(legacy)-double(compact))/double(legacy) : 0e0);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_VolIDMemory,volid_memory)
+
 /// Basic entry point to print out detector type map
 /**
  *  Factory: TestSurfaces
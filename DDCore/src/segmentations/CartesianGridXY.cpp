@@ -64,6 +64,12 @@ Vector3D CartesianGridXY::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// fill the neighbours of the cell ID into a caller supplied buffer
+size_t CartesianGridXY::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+	const GridAxis axes[] = { (*_decoder)[_xId], (*_decoder)[_yId] };
+	return gridNeighbours(cID, type, axes, 2, buffer, capacity);
+}
+
 std::vector<double> CartesianGridXY::cellDimensions(const CellID&) const {
 #if __cplusplus >= 201103L
   return {_gridSizeX, _gridSizeY};
@@ -59,6 +59,12 @@ Vector3D CartesianGridXYZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// fill the neighbours of the cell ID into a caller supplied buffer
+size_t CartesianGridXYZ::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+	const GridAxis axes[] = { (*_decoder)[_xId], (*_decoder)[_yId], (*_decoder)[_zId] };
+	return gridNeighbours(cID, type, axes, 3, buffer, capacity);
+}
+
 std::vector<double> CartesianGridXYZ::cellDimensions(const CellID&) const {
 #if __cplusplus >= 201103L
   return {_gridSizeX, _gridSizeY, _gridSizeZ};
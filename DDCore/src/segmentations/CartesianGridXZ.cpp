@@ -67,6 +67,12 @@ Vector3D CartesianGridXZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// fill the neighbours of the cell ID into a caller supplied buffer
+size_t CartesianGridXZ::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+	const GridAxis axes[] = { (*_decoder)[_xId], (*_decoder)[_zId] };
+	return gridNeighbours(cID, type, axes, 2, buffer, capacity);
+}
+
 std::vector<double> CartesianGridXZ::cellDimensions(const CellID&) const {
 #if __cplusplus >= 201103L
   return {_gridSizeX, _gridSizeZ};
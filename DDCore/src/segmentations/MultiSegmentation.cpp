@@ -94,6 +94,19 @@ namespace dd4hep {
     CellID MultiSegmentation::cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& vID) const {
       return subsegmentation(vID).cellID(localPosition, globalPosition, vID);
     }
+    /// fill the neighbours of the cell ID into a caller supplied buffer
+    size_t MultiSegmentation::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+      // Same lookup as subsegmentation(cID), but without exception if the identifier is invalid
+      if ( m_discriminator )  {
+        long seg_id = m_discriminator->value(cID);
+        for( const auto& e : m_segmentations )   {
+          if ( e.key_min<= seg_id && e.key_max >= seg_id )
+            return e.segmentation->findNeighbours(cID, type, buffer, capacity);
+        }
+      }
+      return 0;
+    }
+
 
     vector<double> MultiSegmentation::cellDimensions(const CellID& cID) const {
       return subsegmentation(cID).cellDimensions(cID);
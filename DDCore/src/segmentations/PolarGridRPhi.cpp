@@ -7,6 +7,8 @@
 
 #include "DDSegmentation/PolarGridRPhi.h"
 
+#include <algorithm>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -68,6 +70,14 @@ Vector3D PolarGridRPhi::position(const CellID& cID) const {
 	_decoder->set(cID,_phiId, positionToBin(phi, _gridSizePhi, _offsetPhi));
 	return cID;
 }
+/// fill the neighbours of the cell ID into a caller supplied buffer
+size_t PolarGridRPhi::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+	GridAxis axes[] = { (*_decoder)[_rId], (*_decoder)[_phiId] };
+	// No cells at negative radius. Phi does not wrap: the bins at -pi and pi are distinct cell IDs
+	axes[0].minBin = std::max(axes[0].minBin, long64(positionToBin(0., _gridSizeR, _offsetR)));
+	return gridNeighbours(cID, type, axes, 2, buffer, capacity);
+}
+
 
 std::vector<double> PolarGridRPhi::cellDimensions(const CellID& cID) const {
   const double rPhiSize = binToPosition(_decoder->get(cID,_rId), _gridSizeR, _offsetR)*_gridSizePhi;
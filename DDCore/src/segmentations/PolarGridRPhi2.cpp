@@ -7,6 +7,8 @@
 
 #include "DDSegmentation/PolarGridRPhi2.h"
 
+#include <algorithm>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -83,6 +85,52 @@ Vector3D PolarGridRPhi2::position(const CellID& cID) const {
 
 	return cID;
 }
+/// fill the neighbours of the cell ID into a caller supplied buffer
+size_t PolarGridRPhi2::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+	const BitFieldElement& rField   = (*_decoder)[_rId];
+	const BitFieldElement& phiField = (*_decoder)[_phiId];
+	const long64 numR = std::min(long64(_gridRValues.size()) - 1, long64(_gridPhiValues.size()));
+	const long64 rBin = rField.value(cID);
+	const long64 pBin = phiField.value(cID);
+	// number of phi bins of a ring: the last bin may be partial
+	auto numPhiBins = [](double phiSize) { return std::max(long64(std::ceil(2*M_PI/phiSize - 1e-9)), 1LL); };
+	size_t count = 0;
+	auto add = [&count, buffer, capacity](CellID nID) {
+		if ( count < capacity ) buffer[count] = nID;
+		++count;
+	};
+	if ( rBin < 0 || rBin >= numR || pBin < 0 || pBin >= numPhiBins(_gridPhiValues[rBin]) ) {
+		return 0;
+	}
+	// neighbours in the same ring: phi wraps around
+	const double phiSize = _gridPhiValues[rBin];
+	const long64 numPhi  = numPhiBins(phiSize);
+	if ( numPhi > 1 ) add(setBin(cID, phiField, (pBin + numPhi - 1) % numPhi));
+	if ( numPhi > 2 ) add(setBin(cID, phiField, (pBin + 1) % numPhi));
+
+	// neighbours in the adjacent rings, which may have a different phi binning
+	for ( long64 r = rBin - 1; r <= rBin + 1; r += 2 ) {
+		if ( r < 0 || r >= numR || r < rField.minValue() || r > rField.maxValue() ) continue;
+		const double ringSize = _gridPhiValues[r];
+		const long64 ringPhi  = numPhiBins(ringSize);
+		long64 first, last;
+		if ( type == AllNeighbours ) {
+			// all cells touching the phi range of the cell, including the corners
+			first = long64(std::ceil(pBin*phiSize/ringSize - 1e-9)) - 1;
+			last  = long64(std::floor((pBin+1)*phiSize/ringSize + 1e-9));
+		} else {
+			// the cell containing the phi centre of the cell
+			first = last = long64(std::floor((pBin+0.5)*phiSize/ringSize));
+		}
+		last = std::min(last, first + ringPhi - 1);
+		const CellID rID = setBin(cID, rField, r);
+		for ( long64 p = first; p <= last; ++p ) {
+			add(setBin(rID, phiField, ((p % ringPhi) + ringPhi) % ringPhi));
+		}
+	}
+	return count;
+}
+
 
 
 std::vector<double> PolarGridRPhi2::cellDimensions(const CellID& cID) const {
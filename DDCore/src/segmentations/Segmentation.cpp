@@ -65,25 +65,66 @@ namespace dd4hep {
 
     /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
     void Segmentation::neighbours(const CellID& cID, std::set<CellID>& cellNeighbours) const {
-      map<std::string, StringParameter>::const_iterator it;
-      for (it = _indexIdentifiers.begin(); it != _indexIdentifiers.end(); ++it) {
-        const std::string& identifier = it->second->typedValue();
-        CellID nID = cID ;
-        int currentValue = _decoder->get(cID,identifier);
+      for (const auto& it : _indexIdentifiers) {
+        const BitFieldElement& field = (*_decoder)[it.second->typedValue()];
+        CellID nID[2];
+        GridAxis axis(field);
         // add both neighbouring cell IDs, don't add out of bound indices
-        try {
-          _decoder->set(nID,identifier,currentValue - 1);
-          cellNeighbours.insert(nID);
-        } catch (runtime_error& e) {
-          // nothing to do
+        size_t num = gridNeighbours(cID, FaceNeighbours, &axis, 1, nID, 2);
+        cellNeighbours.insert(nID, nID + num);
+      }
+    }
+
+    /// Fills the neighbours of the given cell ID into a caller supplied buffer
+    size_t Segmentation::findNeighbours(const CellID& cID, int type, CellID* buffer, size_t capacity) const {
+      GridAxis axes[8];
+      size_t   num_axes = 0;
+      for (const auto& it : _indexIdentifiers) {
+        if ( num_axes == sizeof(axes)/sizeof(axes[0]) ) break;
+        axes[num_axes++] = GridAxis((*_decoder)[it.second->typedValue()]);
+      }
+      return gridNeighbours(cID, type, axes, num_axes, buffer, capacity);
+    }
+
+    /// Helper method to fill the neighbours of a cell on a regular grid of index fields
+    size_t Segmentation::gridNeighbours(const CellID& cID, int type, const GridAxis* axes, size_t num_axes,
+                                        CellID* buffer, size_t capacity) {
+      size_t count = 0;
+      if ( type == AllNeighbours ) {
+        // Loop over all 3^num_axes index offsets. All digits 1 is the cell itself.
+        size_t total = 1;
+        for (size_t i = 0; i < num_axes; ++i) total *= 3;
+        const size_t self = (total - 1) / 2;
+        for (size_t combination = 0; combination < total; ++combination) {
+          if ( combination == self ) continue;
+          CellID nID   = cID;
+          bool   valid = true;
+          for (size_t i = 0, digits = combination; i < num_axes && valid; ++i, digits /= 3) {
+            const GridAxis& a = axes[i];
+            long64 bin = a.field->value(cID) + long64(digits % 3) - 1;
+            valid = bin >= a.minBin && bin <= a.maxBin;
+            nID   = setBin(nID, *a.field, bin);
+          }
+          if ( valid ) {
+            if ( count < capacity ) buffer[count] = nID;
+            ++count;
+          }
+        }
+        return count;
+      }
+      for (size_t i = 0; i < num_axes; ++i) {
+        const GridAxis& a = axes[i];
+        long64 bin = a.field->value(cID);
+        if ( bin - 1 >= a.minBin ) {
+          if ( count < capacity ) buffer[count] = setBin(cID, *a.field, bin - 1);
+          ++count;
         }
-        try {
-          _decoder->set(nID,identifier,currentValue + 1);
-          cellNeighbours.insert(nID);
-        } catch (runtime_error& e) {
-          // nothing to do
+        if ( bin + 1 <= a.maxBin ) {
+          if ( count < capacity ) buffer[count] = setBin(cID, *a.field, bin + 1);
+          ++count;
         }
       }
+      return count;
     }
 
     /// Set the underlying decoder
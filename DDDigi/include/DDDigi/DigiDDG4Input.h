@@ -1,5 +1,5 @@
 //==========================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------------
 // Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
 // All rights reserved.
@@ -15,10 +15,15 @@
 
 /// Framework include files
 #include "DDDigi/DigiInputAction.h"
+#include "DDDigi/DigiData.h"
+
+/// C/C++ include files
+#include <memory>
 
 // Forward declarations
 class TFile;
 class TTree;
+class TClass;
 class TBranch;
 
 /// Namespace for the AIDA detector description toolkit
@@ -30,19 +35,91 @@ namespace dd4hep {
     // Forward declarations
     class DigiDDG4Input;
 
-    /// Base class for input actions to the digitization
+    /// Raw DDG4 event data read by the DigiDDG4Input action
     /**
+     *  The object is attached as an extension to the DigiEvent and owns
+     *  the containers read from the input file. The energy deposits
+     *  registered to DigiEvent::energyDeposits point to the hits of these
+     *  containers. Other containers (e.g. the MC particles) are only
+     *  accessible through this object.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDDG4InputData   {
+    public:
+      /// Raw container as read from the branch of the event tree
+      struct Container  {
+        std::string name;
+        TClass*     clazz = 0;
+        void*       data  = 0;
+      };
+      /// Raw containers of the event
+      std::vector<Container>  containers;
+      /// Energy deposit handles of the hits
+      std::vector<std::unique_ptr<EnergyDeposit> >  deposits;
+      /// Hit containers ready to be moved to DigiEvent::energyDeposits
+      std::map<unsigned long, std::shared_ptr<DigiEnergyDeposits> >  energyDeposits;
+      /// Columnar copies of the hit containers ready to be moved to DigiEvent::depositColumns
+      std::map<unsigned long, std::shared_ptr<DigiDepositColumns> >  depositColumns;
+      /// Sequence number of the event in the input stream
+      long entry = -1;
+
+    public:
+      /// Default constructor
+      DigiDDG4InputData() = default;
+      /// Inhibit copy constructor
+      DigiDDG4InputData(const DigiDDG4InputData& copy) = delete;
+      /// Default destructor. Deletes the hits and the containers
+      ~DigiDDG4InputData();
+      /// Inhibit assignment
+      DigiDDG4InputData& operator=(const DigiDDG4InputData& copy) = delete;
+      /// Access a raw container by name. Returns null if not present
+      const Container* container(const std::string& name)  const;
+    };
+
+    /// Input action reading the event data written by Geant4Output2ROOT
+    /**
+     *  The input files are read by a read-ahead thread, which decodes the
+     *  events into a bounded queue. The digitization event loop hence only
+     *  waits for I/O if the queue is empty. Reading is optimized using the
+     *  TTreeCache and (optionally) the parallel decompression of the baskets.
+     *
+     *  Hit containers (branches with elements having a "cellID" data member)
+     *  are registered to DigiEvent::energyDeposits using the key built from
+     *  the property "Mask" and the branch name.
+     *  If the property "DepositColumns" is set (default: off), the read-ahead
+     *  thread also fills columnar copies of the hit containers, which are
+     *  registered to DigiEvent::depositColumns with the same keys.
+     *  The background pool of DigiOverlayInput enables it.
      *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_DIGITIZATION
      */
     class DigiDDG4Input : public DigiInputAction {
+    public:
+      /// Internal reader implementation (read-ahead thread and event queue)
+      class internals_t;
+
     protected:
-      /// Reference to the current ROOT file to be read
-      TFile*                   m_current;
-      /// List of input sources to be worked down
-      std::vector<std::string> m_todo;
+      /// Property: Name of the event tree
+      std::string              m_treeName;
+      /// Property: Names of the containers (branches) to be read. Empty: all
+      std::vector<std::string> m_containers;
+      /// Property: Maximal number of decoded events in the read-ahead queue
+      int                      m_readAhead;
+      /// Property: Size of the TTreeCache in bytes
+      long                     m_cacheSize;
+      /// Property: Enable parallel decompression of the baskets
+      bool                     m_parallelUnzip;
+      /// Property: Mask to build the keys of the energy deposit containers
+      int                      m_mask;
+      /// Property: Fill columnar copies of the hit containers
+      bool                     m_depositColumns;
+      /// Reader implementation
+      std::unique_ptr<internals_t> imp;
 
     protected:
       /// Define standard assignments and constructors
@@ -53,6 +130,10 @@ namespace dd4hep {
       DigiDDG4Input(const DigiKernel& kernel, const std::string& nam);
       /// Default destructor
       virtual ~DigiDDG4Input();
+      /// Access the next decoded event. Blocks until available. Null at end of input
+      std::unique_ptr<DigiDDG4InputData> next()  const;
+      /// Check if all input events were consumed. Further events stay empty
+      bool endOfInput()  const;
       /// Callback to read event input
       virtual void execute(DigiContext& context)  const override;
     };
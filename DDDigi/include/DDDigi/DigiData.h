@@ -25,6 +25,8 @@
 #include <stdexcept>
 #include <cstdint>
 #include <memory>
+#include <vector>
+#include <mutex>
 #include <map>
 
 /// Namespace for the AIDA detector description toolkit
@@ -72,11 +74,14 @@ namespace dd4hep {
      */
     class EnergyDeposit   {
     public:
+      /// Accessors common to all deposit types. Sub-classes only add specific accessors
       class FunctionTable   {
         friend class EnergyDeposit;
       public:
-        std::function<long long int(const void*)> cellID;
-        std::function<long(const void*)>          flag;
+        std::function<long long int(const void*)>   cellID;
+        std::function<long(const void*)>            flag;
+        std::function<double(const void*)>          deposit;
+        std::function<const Position& (const void*)> position;
         FunctionTable() = default;
         ~FunctionTable() = default;
       };
@@ -86,6 +91,8 @@ namespace dd4hep {
     public:
       /// Initializing constructor
       template <typename T> EnergyDeposit(const T* object);
+      /// Initializing constructor with explicit function table (e.g. for types known only at run-time)
+      EnergyDeposit(const void* ptr, const FunctionTable* table) : object(ptr, table) {}
       /// Default constructor
       EnergyDeposit() = delete;
       /// Disable move constructor
@@ -99,8 +106,10 @@ namespace dd4hep {
       /// Disable copy assignment
       EnergyDeposit& operator=(const EnergyDeposit& copy) = default;      
 
-      long long int cellID()  const    {   return object.second->cellID(object.first);     }
-      long          flag()  const      {   return object.second->flag(object.first);       }
+      long long int   cellID()  const    {   return object.second->cellID(object.first);     }
+      long            flag()  const      {   return object.second->flag(object.first);       }
+      double          deposit()  const   {   return object.second->deposit(object.first);    }
+      const Position& position()  const  {   return object.second->position(object.first);   }
     };
 
     template <typename T> inline EnergyDeposit::EnergyDeposit(const T* ptr)
@@ -121,9 +130,7 @@ namespace dd4hep {
         friend class TrackerDeposit;
         friend class EnergyDeposit;
       public:
-        std::function<const Position& (const void*)>  position;
         std::function<const Direction& (const void*)> momentum;
-        std::function<double(const void*)>            deposit;
         std::function<double(const void*)>            length;
         FunctionTable() = default;
         ~FunctionTable() = default;
@@ -170,8 +177,6 @@ namespace dd4hep {
         friend class CaloDeposit;
         friend class EnergyDeposit;
       public:
-        std::function<const Position& (const void*)>  position;
-        std::function<double(const void*)>            deposit;
         FunctionTable() = default;
         ~FunctionTable() = default;
       };
@@ -228,6 +233,120 @@ namespace dd4hep {
     typedef DigiContainer<EnergyDeposit*> DigiEnergyDeposits;
     typedef DigiContainer<DigiCount*>     DigiCounts;
 
+    /// Columnar (structure-of-arrays) container of the energy deposits of one detector segment
+    /**
+     *  Each deposit attribute is stored in a separate contiguous column.
+     *  Signal processing and spillover merging stream through these
+     *  columns instead of dereferencing polymorphic EnergyDeposit objects.
+     *
+     *  Filling with emplace_back is not protected: it is meant for the
+     *  single thread owning the segment. append() and merge() lock the
+     *  segment and may be called concurrently from several threads.
+     *
+     *  The container remembers if it is compacted (sorted by cell without
+     *  duplicates). Appending only marks it unsorted; the sort is done once
+     *  by compact() when a consumer needs the cell order. The columns should
+     *  therefore only be modified through the member functions.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiDepositColumns   {
+    public:
+      typedef std::uint64_t CellID;
+
+      /// Column: cell identifiers
+      std::vector<CellID>   cellID;
+      /// Column: deposited energy
+      std::vector<double>   energy;
+      /// Column: time of the deposit
+      std::vector<double>   time;
+      /// Column: position of the deposit
+      std::vector<Position> position;
+
+    private:
+      /// Unique name within the event
+      std::string           m_name;
+      /// Segment lock for concurrent append/merge
+      mutable std::mutex    m_lock;
+      /// Flag if the columns are sorted by cell without duplicates
+      bool                  m_sorted = true;
+
+      /// Append all deposits of another container, shifted in time. Caller must hold the lock
+      void append_unlocked(const DigiDepositColumns& other, double time_offset);
+      /// Sum deposits of identical cells. Caller must hold the lock
+      void compact_unlocked();
+      /// Merge compacted containers into this compacted container. Caller must hold the lock
+      void merge_unlocked(const std::vector<std::pair<const DigiDepositColumns*, double> >& inputs);
+
+    public:
+      /// Default constructor
+      DigiDepositColumns() = default;
+      /// Initializing constructor
+      DigiDepositColumns(const std::string& nam) : m_name(nam) {}
+      /// Disable move constructor
+      DigiDepositColumns(DigiDepositColumns&& copy) = delete;
+      /// Disable copy constructor
+      DigiDepositColumns(const DigiDepositColumns& copy) = delete;
+      /// Default destructor
+      virtual ~DigiDepositColumns() = default;
+      /// Disable move assignment
+      DigiDepositColumns& operator=(DigiDepositColumns&& copy) = delete;
+      /// Disable copy assignment
+      DigiDepositColumns& operator=(const DigiDepositColumns& copy) = delete;
+
+      /// Access the container name
+      const std::string& name()  const   {  return m_name;           }
+      /// Number of deposits
+      std::size_t size()  const          {  return cellID.size();    }
+      /// Check if the container is empty
+      bool empty()  const                {  return cellID.empty();   }
+      /// Check if the container is compacted (sorted by cell without duplicates)
+      bool sorted()  const               {  return m_sorted;         }
+      /// Access the segment lock (e.g. to append many deposits in one go)
+      std::mutex& lock()  const          {  return m_lock;           }
+      /// Reserve space in all columns
+      void reserve(std::size_t len);
+      /// Remove all deposits
+      void clear();
+      /// Add a single deposit. Not thread safe
+      void emplace_back(CellID cell, double e, double t, const Position& pos)   {
+        if ( m_sorted && !cellID.empty() && cell <= cellID.back() ) m_sorted = false;
+        cellID.emplace_back(cell);
+        energy.emplace_back(e);
+        time.emplace_back(t);
+        position.emplace_back(pos);
+      }
+      /// Thread safe: append all deposits of another container, shifted in time
+      void append(const DigiDepositColumns& other, double time_offset = 0e0);
+      /// Thread safe: append legacy energy deposits, shifted in time
+      void append(const DigiEnergyDeposits& deposits, double time_offset = 0e0);
+      /// Thread safe: merge another container, shifted in time
+      /**
+       *  If both containers are compacted, the sorted cell columns are
+       *  merged in linear time and deposits of identical cells are summed.
+       *  Otherwise the deposits are appended and the container is marked
+       *  unsorted: compact() sorts it once when the cell order is needed.
+       */
+      void merge(const DigiDepositColumns& other, double time_offset = 0e0);
+      /// Thread safe: merge several containers, each shifted by its time offset
+      /**
+       *  The inputs must be compacted (sorted by cell). The deposits are
+       *  joined with a k-way merge over the sorted cell columns, the work
+       *  is proportional to N log(k) for N deposits in k inputs.
+       *  The result is compacted.
+       */
+      void merge(const std::vector<std::pair<const DigiDepositColumns*, double> >& inputs);
+      /// Thread safe: sort by cell and sum deposits of identical cells
+      /**
+       *  Energies are summed, the earliest time is kept and the position
+       *  is the energy weighted mean. Nothing is done if the container
+       *  is already compacted.
+       */
+      void compact();
+    };
+
     ///  Key defintion to access the event data
     /**
      *  Helper to convert item and mask to a 64 bit integer
@@ -283,6 +402,7 @@ namespace dd4hep {
       typedef Key::key_type key_type;
       std::map<unsigned long, std::shared_ptr<DigiEnergyDeposits> >  energyDeposits;
       std::map<unsigned long, std::shared_ptr<DigiCounts> >          digitizations;
+      std::map<unsigned long, std::shared_ptr<DigiDepositColumns> >  depositColumns;
 
       int eventNumber = 0;
 #if defined(DD4HEP_INTERPRETER_MODE)
@@ -290,6 +410,10 @@ namespace dd4hep {
 #else
       std::map<key_type, dd4hep::any>  data;
 #endif
+    private:
+      /// Lock to protect the creation of the columnar deposit containers
+      std::mutex m_lock;
+
     public:
 #if defined(DD4HEP_INTERPRETER_MODE) || defined(G__ROOT)
       /// Inhibit default constructor
@@ -337,6 +461,8 @@ namespace dd4hep {
         throw std::runtime_error("DigiEvent"); // Will never get here!
       }
 #endif
+      /// Thread safe access to the columnar deposits of a detector segment. Created if not present
+      DigiDepositColumns& columns(const Key& key, const std::string& name);
       /// Add an extension object to the detector element
       void* addExtension(unsigned long long int k, ExtensionEntry* e)  {
         return ObjectExtensions::addExtension(k, e);
@@ -44,6 +44,8 @@ namespace dd4hep {
       virtual ~DigiExponentialNoise();
       /// Callback to read event exponentialnoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch processing: add exponential noise to all cells of the batch
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
@@ -58,6 +58,8 @@ namespace dd4hep {
       
       /// Execute one single event
       virtual void executeEvent(DigiContext* context);
+      /// Execute a single action. Optionally the execution is profiled below the parent node
+      void executeAction(DigiEventAction* action, DigiContext& context, int parent, double submitted)  const;
       /// Notify kernel that the execution of one single event finished
       void notify(DigiContext* context);
       /// Notify kernel that the execution of one single event finished
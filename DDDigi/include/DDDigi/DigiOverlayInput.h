@@ -0,0 +1,136 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIOVERLAYINPUT_H
+#define DDDIGI_DIGIOVERLAYINPUT_H
+
+/// Framework include files
+#include "DDDigi/DigiInputAction.h"
+#include "DDDigi/DigiData.h"
+
+/// C/C++ include files
+#include <memory>
+#include <mutex>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Memory resident pool of background events for the overlay
+    /**
+     *  The deposit columns of every pool event are compacted (sorted by
+     *  cell) when added. After loading the pool is read-only and may be
+     *  accessed randomly from any number of threads. Pool events are
+     *  reused as often as requested.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiOverlayPool   {
+    public:
+      /// Deposit columns of one background event by container key
+      typedef std::map<unsigned long, std::shared_ptr<DigiDepositColumns> > event_t;
+
+    protected:
+      /// Background events
+      std::vector<event_t> m_events;
+      /// Total number of deposits in the pool
+      std::size_t          m_numDeposits = 0;
+
+    public:
+      /// Default constructor
+      DigiOverlayPool() = default;
+      /// Inhibit copy constructor
+      DigiOverlayPool(const DigiOverlayPool& copy) = delete;
+      /// Default destructor
+      ~DigiOverlayPool() = default;
+      /// Inhibit assignment
+      DigiOverlayPool& operator=(const DigiOverlayPool& copy) = delete;
+      /// Add a background event. The columns are compacted
+      void add(event_t&& event);
+      /// Number of events in the pool
+      std::size_t size()  const                   {  return m_events.size();  }
+      /// Total number of deposits in the pool
+      std::size_t numDeposits()  const            {  return m_numDeposits;    }
+      /// Access a background event
+      const event_t& event(std::size_t which)  const  {  return m_events[which];  }
+    };
+
+    /// Input action overlaying pile-up and spillover on the signal event
+    /**
+     *  For every bunch crossing in the property "BunchCrossings" a number of
+     *  background events is taken randomly from the pool: Poisson distributed
+     *  with mean "Mu" or fixed. The deposits are shifted in time by the
+     *  bunch crossing times "BunchSpacing" and merged per cell into the
+     *  columnar deposits of the signal event (DigiEvent::depositColumns)
+     *  using a k-way join over the sorted cell columns.
+     *
+     *  The pool is loaded on first use from the DDG4 files given with
+     *  the property "Input" (at most "PoolSize" events) unless it was set
+     *  explicitly using setPool(). The random selection uses a counter based
+     *  stream of seed, event number and action: the overlay of an event
+     *  does not depend on the number of threads.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiOverlayInput : public DigiInputAction {
+    protected:
+      /// Property: Name of the event tree of the pool input
+      std::string              m_treeName;
+      /// Property: Names of the containers to be overlaid. Empty: all
+      std::vector<std::string> m_containers;
+      /// Property: Maximal number of events in the pool. 0: all
+      long                     m_poolSize;
+      /// Property: Mean number of background events per bunch crossing
+      double                   m_mu;
+      /// Property: Poisson distributed number of events (otherwise fixed Mu)
+      bool                     m_poisson;
+      /// Property: Bunch crossings to be overlaid relative to the signal
+      std::vector<int>         m_bunchCrossings;
+      /// Property: Time between bunch crossings
+      double                   m_bunchSpacing;
+      /// Property: Mask of the signal deposit containers
+      int                      m_mask;
+      /// Property: Random seed
+      long                     m_seed;
+      /// Background event pool
+      mutable std::shared_ptr<DigiOverlayPool> m_pool;
+      /// Pool load guard
+      mutable std::once_flag   m_poolLoaded;
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiOverlayInput);
+      /// Load the background pool from the input files
+      void load_pool()  const;
+
+    public:
+      /// Standard constructor
+      DigiOverlayInput(const DigiKernel& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiOverlayInput();
+      /// Set the background pool explicitly (e.g. shared between several overlay actions)
+      void setPool(std::shared_ptr<DigiOverlayPool> pool);
+      /// Access the background pool. Loaded if not yet present
+      const DigiOverlayPool& pool()  const;
+      /// Callback to overlay the background on the event
+      virtual void execute(DigiContext& context)  const override;
+    };
+
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIOVERLAYINPUT_H
@@ -49,6 +49,8 @@ namespace dd4hep {
       virtual ~DigiPoissonNoise();
       /// Callback to read event poissonnoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch processing: add poisson noise to all cells of the batch
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
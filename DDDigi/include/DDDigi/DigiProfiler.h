@@ -0,0 +1,160 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIPROFILER_H
+#define DDDIGI_DIGIPROFILER_H
+
+/// C/C++ include files
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <map>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Forward declarations
+    class DigiEventAction;
+
+    /// Profiler of the action execution in the digitization kernel
+    /**
+     *  Every action execution is a node in the call tree of the event:
+     *  the path of nested sequences down to the action. For every node
+     *  the wall time, the CPU time of the executing thread and the queue
+     *  wait time (time between the submission of a parallel task and its
+     *  start) are accumulated.
+     *
+     *  Measurements are accumulated in thread local buffers without locks.
+     *  The buffers are only combined at the end of the job. Optionally
+     *  every single execution is kept to export a trace.
+     *
+     *  Output formats:
+     *  - Chrome trace (JSON): chrome://tracing, Perfetto or speedscope.
+     *  - Folded stacks: flamegraph.pl or speedscope. The values are
+     *    the exclusive wall times in microseconds.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiProfiler   {
+    public:
+      /// Node in the call tree: parent node and action. The root of each event has no action
+      struct Node  {
+        int                    parent = -1;
+        const DigiEventAction* action = 0;
+        std::string            name;
+      };
+      /// Single execution record (kept only if tracing is enabled)
+      struct Record  {
+        int    node;
+        int    event;
+        int    thread;
+        double start;
+        double wall;
+        double cpu;
+        double wait;
+      };
+      /// Accumulated statistics of a node
+      struct Stat  {
+        long   calls = 0;
+        double wall  = 0e0;
+        double cpu   = 0e0;
+        double wait  = 0e0;
+        double max   = 0e0;
+      };
+
+      /// Measurement scope of one action execution
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class Scope  {
+        DigiProfiler* profiler = 0;
+        int           node     = -1;
+        int           saved    = -1;
+        int           event    = 0;
+        double        start    = 0e0;
+        double        cpu      = 0e0;
+        double        wait     = 0e0;
+      public:
+        /// Start measurement. submitted < 0: no queue wait
+        Scope(DigiProfiler& prof, int parent, const DigiEventAction* action,
+              const char* name, int event, double submitted);
+        /// Inhibit copy constructor
+        Scope(const Scope& copy) = delete;
+        /// Stop measurement and record
+        ~Scope();
+        /// Inhibit assignment
+        Scope& operator=(const Scope& copy) = delete;
+      };
+
+    private:
+      struct Buffer;
+      /// Lock for the node table and the buffer registry
+      std::mutex                             m_lock;
+      /// Call tree nodes
+      std::vector<Node>                      m_nodes;
+      /// Node lookup: (parent, action) -> node
+      std::map<std::pair<int, const void*>, int> m_nodeIndex;
+      /// Thread buffers
+      std::vector<std::unique_ptr<Buffer> >  m_buffers;
+      /// Start of the profiling period
+      std::chrono::steady_clock::time_point  m_start;
+      /// Generation counter to invalidate the thread local buffer caches
+      long                                   m_generation = 0;
+      /// Flag: keep every execution record
+      bool                                   m_trace   = false;
+      /// Flag: profiling enabled
+      bool                                   m_enabled = false;
+
+      /// Access the buffer of the calling thread
+      Buffer& buffer();
+      /// Access (create) the node of an action below a parent node
+      int node(Buffer& buf, int parent, const DigiEventAction* action, const char* name);
+      /// Combine the statistics of all threads
+      std::vector<Stat> statistics();
+
+    public:
+      /// Default constructor
+      DigiProfiler();
+      /// Inhibit copy constructor
+      DigiProfiler(const DigiProfiler& copy) = delete;
+      /// Default destructor
+      ~DigiProfiler();
+      /// Inhibit assignment
+      DigiProfiler& operator=(const DigiProfiler& copy) = delete;
+
+      /// Start a new profiling period. All previous measurements are dropped
+      void start(bool enable, bool trace);
+      /// Check if profiling is enabled
+      bool enabled()  const   {  return m_enabled;  }
+      /// Time since the start of the profiling period in seconds
+      double now()  const;
+      /// Current node of the calling thread (parent of tasks submitted now)
+      int current()  const;
+      /// Print the summary per action
+      void print();
+      /// Write the execution records in the chrome trace event format
+      bool writeTrace(const std::string& file_name);
+      /// Write the call tree in the folded stack format for flame graphs
+      bool writeFolded(const std::string& file_name);
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIPROFILER_H
@@ -0,0 +1,137 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIRANDOMSTREAM_H
+#define DDDIGI_DIGIRANDOMSTREAM_H
+
+/// C/C++ include files
+#include <cstdint>
+#include <cstddef>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Counter based random number stream (Philox4x32-10)
+    /**
+     *  The random numbers are a pure function of the stream key and a
+     *  128 bit counter made of the cell index and the draw number within
+     *  the cell. There is no internal state: cells may be processed in
+     *  any order and partitioned between any number of threads, the
+     *  result is always identical.
+     *
+     *  The stream key is built from the job seed, the event number and
+     *  the subdetector. Independent sub-streams (e.g. one per signal
+     *  processor) are obtained with derive().
+     *
+     *  Reference: J.Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+     *  Proceedings of SC'11.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiRandomStream  {
+    public:
+      typedef std::uint64_t key_type;
+
+      /// Sequential engine for one cell (e.g. for rejection methods)
+      /**
+       *  Behaves like the std::function engine of DigiRandomGenerator:
+       *  every call returns the next uniform number in ]0,1[ of the cell.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class cell_engine  {
+        const DigiRandomStream& stream;
+        std::uint64_t           cell;
+        std::uint64_t           draw = 0;
+        std::uint32_t           buffer[4];
+        int                     used = 4;
+      public:
+        /// Initializing constructor
+        cell_engine(const DigiRandomStream& s, std::uint64_t c) : stream(s), cell(c) {}
+        /// Next uniform random number of the cell in ]0,1[
+        double operator()()   {
+          if ( used > 2 )   {
+            stream.block(cell, draw++, buffer);
+            used = 0;
+          }
+          double r = to_double(buffer[used], buffer[used+1]);
+          used += 2;
+          return r;
+        }
+      };
+
+    protected:
+      /// Philox key
+      std::uint32_t m_key[2];
+
+    public:
+      /// Initializing constructor from the raw key
+      explicit DigiRandomStream(key_type key);
+      /// Initializing constructor: stream of one subdetector in a given event
+      DigiRandomStream(key_type seed, key_type event, key_type subdetector);
+      /// Default copy constructor
+      DigiRandomStream(const DigiRandomStream& copy) = default;
+      /// Default destructor
+      ~DigiRandomStream() = default;
+      /// Default assignment
+      DigiRandomStream& operator=(const DigiRandomStream& copy) = default;
+
+      /// Access the stream key
+      key_type key()  const   {  return (key_type(m_key[1])<<32) | m_key[0];  }
+      /// Derive an independent stream (e.g. for a signal processor)
+      DigiRandomStream derive(key_type sub_key)  const;
+      /// Access an engine for sequential draws within one cell
+      cell_engine engine(std::uint64_t cell)  const  {  return cell_engine(*this, cell); }
+
+      /// Convert 2 x 32 random bits to a double in ]0,1[ with 53 bits precision
+      static double to_double(std::uint32_t hi, std::uint32_t lo)  {
+        return (double((std::uint64_t(hi>>5)<<26) | (lo>>6)) + 0.5) * (1.0/9007199254740992.0);
+      }
+      /// Raw Philox4x32-10 output for the counter (cell, draw)
+      inline void block(std::uint64_t cell, std::uint64_t draw, std::uint32_t out[4])  const;
+      /// Single uniform random number in ]0,1[ of a cell
+      double uniform(std::uint64_t cell)  const;
+      /// Fill uniform random numbers in ]0,1[ for the cells [first, first+n[
+      void fill_uniform(std::uint64_t first, double* out, std::size_t n)  const;
+      /// Fill unit gaussian random numbers for the cells [first, first+n[
+      void fill_gaussian(std::uint64_t first, double* out, std::size_t n)  const;
+    };
+
+    /// Raw Philox4x32-10 output for the counter (cell, draw)
+    inline void DigiRandomStream::block(std::uint64_t cell, std::uint64_t draw, std::uint32_t out[4])  const  {
+      std::uint32_t c0 = std::uint32_t(cell), c1 = std::uint32_t(cell>>32);
+      std::uint32_t c2 = std::uint32_t(draw), c3 = std::uint32_t(draw>>32);
+      std::uint32_t k0 = m_key[0], k1 = m_key[1];
+      for( int r=0; r < 10; ++r )   {
+        std::uint64_t p0 = std::uint64_t(0xD2511F53u) * c0;
+        std::uint64_t p1 = std::uint64_t(0xCD9E8D57u) * c2;
+        std::uint32_t n0 = std::uint32_t(p1>>32) ^ c1 ^ k0;
+        std::uint32_t n2 = std::uint32_t(p0>>32) ^ c3 ^ k1;
+        c0 = n0;
+        c1 = std::uint32_t(p1);
+        c2 = n2;
+        c3 = std::uint32_t(p0);
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+      }
+      out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIRANDOMSTREAM_H
@@ -20,6 +20,7 @@
 
 /// C/C++ include files
 #include <functional>
+#include <cstdint>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -65,6 +66,14 @@ namespace dd4hep {
     template <typename SEGMENTATION> 
     void init_segmentation_data(segmentation_data<SEGMENTATION>& data, const Segmentation& seg);
 
+    /// Number of cells of the segmentation grid covering the bounding box of a solid
+    template <typename SEGMENTATION>
+    std::uint64_t grid_num_cells(const segmentation_data<SEGMENTATION>& data, const Box& bbox);
+
+    /// Cell identifier and local cell center of the grid cell with the given linear index
+    template <typename SEGMENTATION>
+    CellID grid_cell(const segmentation_data<SEGMENTATION>& data, const Box& bbox, std::uint64_t index, double pos[3]);
+
     /// 
     /**
      *
@@ -78,7 +87,12 @@ namespace dd4hep {
     public:
       DigiCellScanner() = default;
       virtual ~DigiCellScanner() = default;
+      /// Dense scan: invoke the cell handler for every cell of the placement
       virtual void operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler) = 0;
+      /// Sparse access: number of grid cells of the placement (including cells outside the solid)
+      virtual std::uint64_t num_cells(PlacedVolume pv)  const = 0;
+      /// Sparse access: fill the data of the grid cell with the given index. False if outside the solid
+      virtual bool cell(PlacedVolume pv, VolumeID vid, std::uint64_t index, DigiCellData& data)  const = 0;
     };
     std::shared_ptr<DigiCellScanner> create_cell_scanner(Solid solid, Segmentation segment);
     std::shared_ptr<DigiCellScanner> create_cell_scanner(const std::string& typ, Segmentation segment);
@@ -16,6 +16,7 @@
 /// Framework include files
 #include "DDDigi/DigiAction.h"
 #include "DDDigi/DigiData.h"
+#include "DDDigi/DigiRandomStream.h"
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -44,6 +45,38 @@ namespace dd4hep {
       ~DigiCellContext() = default;
     };
 
+    /// Batch of cells processed by a signal processor in one call
+    /**
+     *  Signal processors add their contribution for all cells of the batch
+     *  to the output values. The random numbers are taken from a counter
+     *  based stream seeded per event and subdetector, which is indexed
+     *  with the cell number: the result does not depend on the way the
+     *  cells are split into batches nor on the number of threads.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiCellBatch  final  {
+    public:
+      /// Reference to the event context
+      DigiContext&      context;
+      /// Random stream of the subdetector in this event
+      DigiRandomStream  random;
+      /// Index of the first cell of the batch within the subdetector
+      std::uint64_t     first;
+      /// Number of cells in the batch
+      std::size_t       size;
+      /// Input: signals of the cells
+      const double*     signals;
+      /// Output: the contributions of the processors are added to these values
+      double*           values;
+      /// Initializing constructor
+      DigiCellBatch(DigiContext& c, const DigiRandomStream& r, std::uint64_t f, std::size_t n, const double* s, double* v)
+        : context(c), random(r), first(f), size(n), signals(s), values(v) {}
+      ~DigiCellBatch() = default;
+    };
+
     /// Base class for signal processing actions to the digitization
     /**
      *
@@ -55,6 +88,8 @@ namespace dd4hep {
     protected:
       /// Flag to check if initialized was called
       bool  m_initialized = false;
+      /// Key to derive the private random stream of this processor
+      DigiRandomStream::key_type m_streamKey = 0;
 
       /// Define standard assignments and constructors
       DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiSignalProcessor);
@@ -68,6 +103,12 @@ namespace dd4hep {
       virtual void initialize();
       /// Callback to read event signalprocessor
       virtual double operator()(DigiCellContext& context)  const = 0;
+      /// Process a batch of cells. The default implementation calls operator() for each cell
+      virtual void process(DigiCellBatch& batch)  const;
+      /// Access the private random stream of this processor for a given batch
+      DigiRandomStream stream(const DigiCellBatch& batch)  const  {
+        return batch.random.derive(m_streamKey);
+      }
     };
   }    // End namespace digi
 }      // End namespace dd4hep
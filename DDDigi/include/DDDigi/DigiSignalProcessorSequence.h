@@ -58,6 +58,8 @@ namespace dd4hep {
       void adopt(DigiSignalProcessor* action);
       /// Begin-of-event callback
       virtual double operator()(DigiCellContext& context)  const override;
+      /// Process a batch of cells: signal plus the contributions of all members
+      virtual void process(DigiCellBatch& batch)  const override;
     };
 
   }    // End namespace digi
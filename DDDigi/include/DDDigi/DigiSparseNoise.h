@@ -0,0 +1,78 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGISPARSENOISE_H
+#define DDDIGI_DIGISPARSENOISE_H
+
+/// C/C++ include files
+#include <cstdint>
+#include <limits>
+#include <cmath>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Statistical generation of gaussian noise above a zero-suppression threshold
+    /**
+     *  Instead of generating noise for every cell and applying the threshold,
+     *  only the cells with noise above threshold are generated:
+     *
+     *  - Each cell exceeds the threshold with probability p = P(noise > threshold).
+     *    The distance to the next noisy cell is geometrically distributed.
+     *    Skipping the quiet cells yields exactly the binomial number of noisy
+     *    cells at uniformly distributed positions with work proportional to
+     *    the occupancy.
+     *  - The amplitude of a noisy cell is drawn from the gaussian tail above
+     *    threshold by inversion.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiSparseNoise  {
+    protected:
+      /// Width of the gaussian noise
+      double m_sigma       = 1e0;
+      /// Zero-suppression threshold
+      double m_threshold   = 0e0;
+      /// Probability of a cell to have noise above threshold
+      double m_probability = 0e0;
+      /// Cache: log(1-p) for the geometric gap sampling
+      double m_logq        = 0e0;
+
+    public:
+      /// Initializing constructor
+      DigiSparseNoise(double sigma, double threshold);
+      /// Default destructor
+      ~DigiSparseNoise() = default;
+      /// Access the noise width
+      double sigma()  const        {  return m_sigma;        }
+      /// Access the zero-suppression threshold
+      double threshold()  const    {  return m_threshold;    }
+      /// Probability of a cell to have noise above threshold
+      double probability()  const  {  return m_probability;  }
+      /// Number of quiet cells before the next noisy cell for a uniform random number u in ]0,1[
+      std::uint64_t gap(double u)  const   {
+        if ( m_probability <= 0e0 ) return std::numeric_limits<std::uint64_t>::max();
+        if ( m_probability >= 1e0 ) return 0;
+        double g = std::floor(std::log(u) / m_logq);
+        return g < 1.8e19 ? std::uint64_t(g) : std::numeric_limits<std::uint64_t>::max();
+      }
+      /// Noise amplitude above threshold for a uniform random number u in ]0,1[
+      double tail(double u)  const;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGISPARSENOISE_H
@@ -21,6 +21,7 @@
 
 /// C/C++ include files
 #include <functional>
+#include <vector>
 #include <map>
 
 class TClass;
@@ -38,6 +39,7 @@ namespace dd4hep {
     class DigiCellData;
     class DigiCellScanner;
     class DigiEventAction;
+    class DigiSignalProcessor;
     class DigiSubdetectorSequence;
 
     /// Concrete implementation of the Digitization event action sequence
@@ -65,6 +67,18 @@ namespace dd4hep {
         Context& operator=(const Context& copy) = default;
       };
 
+      /// Sensitive placement for the sparse scan
+      class Sensor  {
+      public:
+        PlacedVolume     placement;
+        VolumeID         volume_id;
+        DigiCellScanner* scanner;
+        /// Index of the first grid cell of this sensor within the subdetector
+        std::uint64_t    first;
+        /// Number of grid cells of this sensor
+        std::uint64_t    count;
+      };
+
       typedef std::map<std::pair<const TClass*,Segmentation>, std::shared_ptr<DigiCellScanner> > Scanners;
       std::string                    m_detectorName;
       std::string                    m_segmentName;
@@ -75,6 +89,28 @@ namespace dd4hep {
       std::map<DetElement, VolumeID> m_parallelDet;
       std::map<VolumeID, Context>    m_parallelVid;
       Scanners                       m_scanners;
+      /// Sensitive placements with consecutive grid cell ranges (sparse mode)
+      std::vector<Sensor>            m_sensors;
+      /// Index of the sensors by volume identifier
+      std::map<VolumeID, std::size_t> m_sensorIndex;
+      /// Mask of the volume identifier bits of the sensors
+      VolumeID                       m_volumeMask = 0;
+      /// Total number of grid cells of the subdetector (sparse mode)
+      std::uint64_t                  m_numCells = 0;
+      /// Property: Sparse zero-suppressed scanning: only cells with deposits or noise above threshold
+      bool                           m_sparse = false;
+      /// Property: Width of the gaussian cell noise (sparse mode)
+      double                         m_noiseSigma = 0e0;
+      /// Property: Zero-suppression threshold (sparse mode)
+      double                         m_threshold = 0e0;
+      /// Property: Mask of the energy deposit container of the subdetector (sparse mode)
+      int                            m_mask = 0;
+      /// Property: Random seed of the noise generation
+      long                           m_seed = 0;
+      /// Property: Number of cells per batch of the signal processors (dense mode)
+      long                           m_batchSize = 4096;
+      /// Signal processors applied to batches of cells (dense mode)
+      Actors<DigiSignalProcessor>    m_processors;
 
       std::function<void(DigiContext& context, const DigiCellScanner&, const DigiCellData&)> m_cellHandler;
 
@@ -96,12 +132,29 @@ namespace dd4hep {
       void scan_detector(DetElement de, VolumeID vid, VolumeID mask);
       void scan_sensitive(PlacedVolume pv, VolumeID vid, VolumeID mask);
       void process_context(DigiContext& context, const Context& c, PlacedVolume pv, VolumeID vid, VolumeID mask)   const;
+      void collect_sensors(PlacedVolume pv, VolumeID vid, VolumeID mask);
+      /// Access the sensor owning a cell. Null if the cell belongs to no sensor
+      const Sensor* sensor(CellID cell)  const;
+      /// Sum the energy deposits of the subdetector per cell
+      void collect_signals(DigiContext& context, std::map<CellID, double>& signals)  const;
+      /// Sparse scan: invoke the cell handler only for cells with deposits or noise above threshold
+      void process_sparse(DigiContext& context)  const;
+      /// Dense scan with signal processors: process the cells of every sensor in batches
+      void process_batches(DigiContext& context)  const;
       
     public:
       /// Standard constructor
       DigiSubdetectorSequence(const DigiKernel& kernel, const std::string& nam);
       /// Default destructor
       virtual ~DigiSubdetectorSequence();
+      /// Adopt a signal processor. The sequence takes ownership.
+      /** If signal processors are present, the dense scan processes the cells
+       *  sensor by sensor in batches: the cell value is the signal plus the
+       *  contributions of all processors. Cells above threshold are passed to
+       *  the cell handler. The sparse scan generates its noise statistically
+       *  and ignores the processors.
+       */
+      void adoptProcessor(DigiSignalProcessor* processor);
       /// Iniitalize subdetector sequencer
       virtual void initialize()  override;
       /// Begin-of-event callback
@@ -46,6 +46,8 @@ namespace dd4hep {
       virtual ~DigiUniformNoise();
       /// Callback to read event uniformnoise
       virtual double operator()(DigiCellContext& context)  const  override;
+      /// Batch processing: add uniform noise to all cells of the batch
+      virtual void process(DigiCellBatch& batch)  const  override;
     };
   }    // End namespace digi
 }      // End namespace dd4hep
@@ -17,14 +17,33 @@
 #include <DDDigi/DigiSegmentation.h>
 #include <DDDigi/DigiFactories.h>
 
+/// C/C++ include files
+#include <cmath>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
   /// Namespace for the Digitization part of the AIDA detector description toolkit
   namespace digi {
 
+    /// Segmentation bins covering the interval [center-half_length, center+half_length]
+    /** The bins are numbered like DDSegmentation::Segmentation::positionToBin:
+     *  the center of bin k is at k*grid_size + offset.
+     */
+    inline void grid_bins(double center, double half_length, double grid_size, double offset,
+                          long& first_bin, std::uint64_t& num_bins)
+    {
+      first_bin = long(std::floor((center - half_length + 0.5*grid_size - offset) / grid_size));
+      long last = long(std::floor((center + half_length + 0.5*grid_size - offset) / grid_size));
+      num_bins  = std::uint64_t(last - first_bin + 1);
+    }
+
     /// 
     /**
+     *  The cells of a placement are the bins of the segmentation grid covering
+     *  the bounding box of the solid. Cells with the center outside the solid
+     *  are skipped. The cell identifiers are computed by the segmentation, so
+     *  they match the identifiers of the energy deposits.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -44,7 +63,41 @@ namespace dd4hep {
         init_segmentation_data<segmentation_t>(segment, seg);
       }
       virtual void operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler)  override;
+      /// Sparse access: number of grid cells of the placement (including cells outside the solid)
+      virtual std::uint64_t num_cells(PlacedVolume pv)  const  override;
+      /// Sparse access: fill the data of the grid cell with the given index. False if outside the solid
+      virtual bool cell(PlacedVolume pv, VolumeID vid, std::uint64_t index, DigiCellData& data)  const  override;
     };
+
+    /// Dense scan: invoke the cell handler for every cell of the placement
+    template <typename SEGMENTATION, typename SOLID>
+    void CellScanner<SEGMENTATION,SOLID>::operator()(DigiContext& context, PlacedVolume pv, VolumeID vid, const cell_handler_t& cell_handler)  {
+      cell_data_t e;
+      for( std::uint64_t index = 0, n = num_cells(pv); index < n; ++index )   {
+        if ( cell(pv, vid, index, e) )
+          cell_handler(context, *this, e);
+      }
+    }
+
+    /// Sparse access: number of grid cells of the placement (including cells outside the solid)
+    template <typename SEGMENTATION, typename SOLID>
+    std::uint64_t CellScanner<SEGMENTATION,SOLID>::num_cells(PlacedVolume pv)  const  {
+      return grid_num_cells<segmentation_t>(segment, pv.volume().solid());
+    }
+
+    /// Sparse access: fill the data of the grid cell with the given index. False if outside the solid
+    template <typename SEGMENTATION, typename SOLID>
+    bool CellScanner<SEGMENTATION,SOLID>::cell(PlacedVolume pv, VolumeID vid, std::uint64_t index, DigiCellData& data)  const  {
+      Solid  sol    = pv.volume().solid();
+      double pos[3] = {0e0, 0e0, 0e0};
+      CellID cid    = grid_cell<segmentation_t>(segment, sol, index, pos);
+      if ( !sol->Contains(pos) ) return false;
+      data.placement = pv;
+      data.volume    = pv.volume();
+      data.solid     = sol;
+      data.cell_id   = vid | cid;
+      return true;
+    }
   }    // End namespace digi
 }      // End namespace dd4hep
 #endif // DDDIGI_SEGMENTATIONS_SEGMENTATIONSCANNER_H
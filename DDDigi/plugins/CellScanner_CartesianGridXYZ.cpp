@@ -45,72 +45,32 @@ namespace dd4hep {
       data.z_mask           = z_f.mask();
     }
 
-    template <typename SEGMENTATION, typename SOLID> void
-    CellScanner<SEGMENTATION,SOLID>::operator()(DigiContext&          ct,
-                                                PlacedVolume          pv,
-                                                VolumeID              vid,
-                                                const cell_handler_t& cell_handler) {
-      typename self_t::cell_data_t e;
-      e.placement     = pv;
-      e.volume        = pv.volume();
-      e.solid         = e.volume.solid();
-      Box           b = e.solid;
-      double   pos[3] = {0e0, 0e0, 0e0};
-      typename self_t::solid_t sol = e.solid;
-      long nx = 2e0 * b->GetDX() / segment.x_grid_size;
-      long ny = 2e0 * b->GetDY() / segment.y_grid_size;
-      long nz = 2e0 * b->GetDZ() / segment.z_grid_size;
-      for ( e.x_bin = 0; e.x_bin < nx; ++e.x_bin )   {
-        pos[0] = (e.x_bin + 0.5) * segment.x_grid_size;
-        e.x_cid = (e.x_bin << segment.x_f_offset) & segment.x_mask;
-        for ( e.y_bin = 0; e.y_bin < ny; ++e.y_bin )   {
-          pos[1] = (e.x_bin + 0.5) * segment.x_grid_size;
-          e.y_cid = (e.y_bin << segment.y_f_offset) & segment.y_mask;
-          for ( e.z_bin=0; e.z_bin < nz; ++e.z_bin )   {
-            e.z_cid = (e.z_bin << segment.z_f_offset) & segment.z_mask;
-            pos[2] = (e.z_bin + 0.5) * segment.z_grid_size;
-            if ( !sol->Contains(pos) ) continue;
-            e.cell_id = vid | e.x_cid | e.y_cid | e.z_cid;
-            //e.cell_id = vid | e.x_cid | e.y_cid;
-            cell_handler(ct, *this, e);
-          }
-        }
-      }
+    template <> std::uint64_t
+    grid_num_cells<CartesianGridXYZ>(const segmentation_data<CartesianGridXYZ>& data, const Box& b)   {
+      const double* o = b->GetOrigin();
+      long first_x, first_y, first_z;
+      std::uint64_t nx, ny, nz;
+      grid_bins(o[0], b->GetDX(), data.x_grid_size, data.x_offset, first_x, nx);
+      grid_bins(o[1], b->GetDY(), data.y_grid_size, data.y_offset, first_y, ny);
+      grid_bins(o[2], b->GetDZ(), data.z_grid_size, data.z_offset, first_z, nz);
+      return nx * ny * nz;
     }
-  }    // End namespace digi
-}      // End namespace dd4hep
-
-/// Namespace for the AIDA detector description toolkit
-namespace dd4hep {
-
-  /// Namespace for the Digitization part of the AIDA detector description toolkit
-  namespace digi {
 
-    template <> void
-    CellScanner<CartesianGridXYZ,Box>::operator()(DigiContext& ct,
-                                                  PlacedVolume pv,
-                                                  VolumeID vid,
-                                                  const cell_handler_t& cell_handler)
+    template <> CellID
+    grid_cell<CartesianGridXYZ>(const segmentation_data<CartesianGridXYZ>& data, const Box& b,
+                                std::uint64_t index, double pos[3])
     {
-      cell_data_t e;
-      e.placement = pv;
-      e.volume    = pv.volume();
-      e.solid     = e.volume.solid();
-      Box       b = e.solid;
-      long nx = 2e0 * b->GetDX() / segment.x_grid_size;
-      long ny = 2e0 * b->GetDY() / segment.y_grid_size;
-      long nz = 2e0 * b->GetDZ() / segment.z_grid_size;
-      for ( e.x_bin=0; e.x_bin < nx; ++e.x_bin )   {
-        e.x_cid = (e.x_bin << segment.x_f_offset) & segment.x_mask;
-        for ( e.y_bin=0; e.y_bin < ny; ++e.y_bin )   {
-          e.y_cid = (e.y_bin << segment.y_f_offset) & segment.y_mask;
-          for ( e.z_bin=0; e.z_bin < nz; ++e.z_bin )   {
-            e.z_cid = (e.z_bin << segment.z_f_offset) & segment.z_mask;
-            e.cell_id = vid | e.x_cid | e.y_cid | e.y_cid;
-            cell_handler(ct, *this, e);
-          }
-        }
-      }
+      const double* o = b->GetOrigin();
+      long first_x, first_y, first_z;
+      std::uint64_t nx, ny, nz;
+      grid_bins(o[0], b->GetDX(), data.x_grid_size, data.x_offset, first_x, nx);
+      grid_bins(o[1], b->GetDY(), data.y_grid_size, data.y_offset, first_y, ny);
+      grid_bins(o[2], b->GetDZ(), data.z_grid_size, data.z_offset, first_z, nz);
+      pos[0] = double(first_x + long(index / (nz * ny))) * data.x_grid_size + data.x_offset;
+      pos[1] = double(first_y + long((index / nz) % ny)) * data.y_grid_size + data.y_offset;
+      pos[2] = double(first_z + long(index % nz)) * data.z_grid_size + data.z_offset;
+      DDSegmentation::Vector3D local(pos[0], pos[1], pos[2]);
+      return data.segmentation_xyz->cellID(local, local, 0);
     }
   }    // End namespace digi
 }      // End namespace dd4hep
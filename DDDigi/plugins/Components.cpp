@@ -27,6 +27,9 @@ DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiInputAction)
 #include "DDDigi/DigiDDG4Input.h"
 DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiDDG4Input)
 
+#include "DDDigi/DigiOverlayInput.h"
+DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiOverlayInput)
+
 #include "DDDigi/DigiSynchronize.h"
 DECLARE_DIGIEVENTACTION_NS(dd4hep::digi,DigiSynchronize)
 
@@ -1,5 +1,5 @@
 //==========================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------------
 // Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
 // All rights reserved.
@@ -13,31 +13,359 @@
 
 // Framework include files
 #include "DD4hep/InstanceCount.h"
+#include "DDDigi/DigiContext.h"
 #include "DDDigi/DigiDDG4Input.h"
 
+// ROOT include files
+#include "TROOT.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TClass.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include "TTreeCacheUnzip.h"
+#include "TVirtualCollectionProxy.h"
+
 // C/C++ include files
+#include <condition_variable>
+#include <atomic>
 #include <stdexcept>
-#include <unistd.h>
+#include <algorithm>
+#include <thread>
+#include <deque>
+#include <mutex>
 
 using namespace std;
 using namespace dd4hep::digi;
 
+namespace  {
+
+  /// Iterate over the elements of a ROOT collection (vector<T*> or vector<T>)
+  template <typename FCN> void for_each_element(TClass* cl, void* coll, FCN fcn)   {
+    unique_ptr<TVirtualCollectionProxy> proxy(cl->GetCollectionProxy()->Generate());
+    TVirtualCollectionProxy::TPushPop helper(proxy.get(), coll);
+    bool   pointers = proxy->HasPointers();
+    UInt_t len = proxy->Size();
+    for( UInt_t i=0; i<len; ++i )   {
+      void* elt = proxy->At(i);
+      fcn(pointers ? *(void**)elt : elt);
+    }
+  }
+}
+
+/// Internal reader implementation: read-ahead thread and bounded event queue
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiDDG4Input::internals_t   {
+public:
+  typedef EnergyDeposit::FunctionTable FunctionTable;
+
+  /// Branch descriptor of the current input tree
+  struct Branch  {
+    TBranch*             branch = 0;
+    TClass*              clazz  = 0;
+    void*                data   = 0;
+    unsigned long        key    = 0;
+    const FunctionTable* table  = 0;
+  };
+
+  /// Reference to the parent action
+  const DigiDDG4Input&          input;
+  /// Guard for the event queue
+  mutex                         lock;
+  /// Signal consumers: new event available or end of input
+  condition_variable            not_empty;
+  /// Signal the producer: free space in the queue
+  condition_variable            not_full;
+  /// Decoded events ready for processing
+  deque<DigiDDG4InputData*>     queue;
+  /// Function tables for all hit classes encountered
+  map<TClass*, unique_ptr<FunctionTable> > tables;
+  /// Read-ahead thread
+  unique_ptr<thread>            reader;
+  /// Startup guard
+  once_flag                     started;
+  /// Flag: producer finished reading all input files
+  bool                          finished = false;
+  /// Flag: consumer requests the producer to stop
+  bool                          stop     = false;
+  /// Error message of the reader thread
+  string                        error;
+  /// Number of events decoded
+  long                          num_events = 0;
+  /// Flag: all input events were consumed
+  atomic<bool>                  end_of_input { false };
+
+public:
+  /// Initializing constructor. The reader thread uses ROOT concurrently to the main thread
+  internals_t(const DigiDDG4Input& i) : input(i)  {
+    ROOT::EnableThreadSafety();
+  }
+  /// Default destructor: stop the reader and drop pending events
+  ~internals_t()   {
+    {
+      lock_guard<mutex> guard(lock);
+      stop = true;
+    }
+    not_full.notify_all();
+    if ( reader ) reader->join();
+    for( auto* e : queue ) delete e;
+    queue.clear();
+  }
+  /// Start the read-ahead thread
+  void start()   {
+    reader.reset(new thread([this]  { this->run(); }));
+  }
+  /// Access the function table of a hit class. Null if the class is no hit class
+  const FunctionTable* table(TClass* cl);
+  /// Decode one event of the current tree
+  DigiDDG4InputData* decode(long entry, vector<Branch>& branches);
+  /// Read one input file
+  void read(const string& fname);
+  /// Thread function of the read-ahead thread
+  void run();
+  /// Queue decoded event. Blocks while the queue is full
+  bool push(DigiDDG4InputData* data);
+  /// Access the next event. Blocks until an event is available. Null at end of input
+  DigiDDG4InputData* next();
+};
+
+/// Default destructor. Deletes the hits and the containers
+DigiDDG4InputData::~DigiDDG4InputData()   {
+  deposits.clear();
+  for( auto& c : containers )   {
+    if ( c.clazz && c.data )   {
+      TClass* value = c.clazz->GetCollectionProxy()->GetValueClass();
+      if ( value && c.clazz->GetCollectionProxy()->HasPointers() )
+        for_each_element(c.clazz, c.data, [value](void* p) { if ( p ) value->Destructor(p); });
+      c.clazz->Destructor(c.data);
+    }
+  }
+  containers.clear();
+}
+
+/// Access a raw container by name. Returns null if not present
+const DigiDDG4InputData::Container* DigiDDG4InputData::container(const string& nam)  const   {
+  for( const auto& c : containers )
+    if ( c.name == nam ) return &c;
+  return 0;
+}
+
+/// Access the function table of a hit class. Null if the class is no hit class
+const DigiDDG4Input::internals_t::FunctionTable*
+DigiDDG4Input::internals_t::table(TClass* cl)   {
+  auto it = tables.find(cl);
+  if ( it != tables.end() ) return it->second.get();
+  Long_t cell_off = cl ? cl->GetDataMemberOffset("cellID") : 0;
+  Long_t flag_off = cl ? cl->GetDataMemberOffset("flag") : 0;
+  Long_t pos_off  = cl ? cl->GetDataMemberOffset("position") : 0;
+  Long_t dep_off  = cl ? cl->GetDataMemberOffset("energyDeposit") : 0;
+  unique_ptr<FunctionTable> tab;
+  // Offsets of zero are legal for the first data member: check the existence explicitly
+  if ( cl && cl->GetRealData("cellID") )   {
+    static const Position null_position;
+    tab.reset(new FunctionTable());
+    tab->cellID   = [cell_off](const void* p)  { return *(const long long int*)((const char*)p+cell_off); };
+    tab->flag     = [flag_off](const void* p)  { return *(const long*)((const char*)p+flag_off);          };
+    tab->deposit  = [dep_off] (const void* p)  { return *(const double*)((const char*)p+dep_off);         };
+    tab->position = [pos_off] (const void* p) -> const Position&
+      { return *(const Position*)((const char*)p+pos_off); };
+    if ( !cl->GetRealData("flag") )
+      tab->flag = [](const void*)  { return 0L; };
+    if ( !cl->GetRealData("energyDeposit") )
+      tab->deposit = [](const void*)  { return 0e0; };
+    if ( !cl->GetRealData("position") )
+      tab->position = [](const void*) -> const Position&  { return null_position; };
+  }
+  return (tables[cl] = std::move(tab)).get();
+}
+
+/// Decode one event of the current tree
+DigiDDG4InputData* DigiDDG4Input::internals_t::decode(long entry, vector<Branch>& branches)  {
+  unique_ptr<DigiDDG4InputData> data(new DigiDDG4InputData());
+  data->entry = num_events;
+  for( auto& b : branches )   {
+    b.data = b.clazz->New();
+    b.branch->SetAddress(&b.data);
+    b.branch->GetEntry(entry);
+    data->containers.emplace_back(DigiDDG4InputData::Container{b.branch->GetName(), b.clazz, b.data});
+    if ( b.table )   {
+      auto deposits = make_shared<DigiEnergyDeposits>(b.branch->GetName());
+      const FunctionTable* tab = b.table;
+      for_each_element(b.clazz, b.data, [&data,&deposits,tab](void* p)  {
+          data->deposits.emplace_back(new EnergyDeposit(p, tab));
+          deposits->emplace_back(data->deposits.back().get());
+        });
+      data->energyDeposits.emplace(b.key, deposits);
+      if ( input.m_depositColumns )   {
+        auto cols = make_shared<DigiDepositColumns>(b.branch->GetName());
+        cols->append(*deposits);
+        data->depositColumns.emplace(b.key, cols);
+      }
+    }
+    // Ownership of the container passed to the event data
+    b.data = 0;
+  }
+  ++num_events;
+  return data.release();
+}
+
+/// Read one input file
+void DigiDDG4Input::internals_t::read(const string& fname)   {
+  unique_ptr<TFile> file(TFile::Open(fname.c_str()));
+  if ( !file || file->IsZombie() )   {
+    error = "Failed to open input file: " + fname;
+    return;
+  }
+  TTree* tree = (TTree*)file->Get(input.m_treeName.c_str());
+  if ( !tree )   {
+    error = "No tree " + input.m_treeName + " present in input file: " + fname;
+    return;
+  }
+  vector<Branch> branches;
+  TObjArray* list = tree->GetListOfBranches();
+  tree->SetCacheSize(input.m_cacheSize);
+  for( Int_t i=0; i < list->GetEntriesFast(); ++i )   {
+    TBranch* br = (TBranch*)list->At(i);
+    const auto& c = input.m_containers;
+    if ( !c.empty() && find(c.begin(), c.end(), br->GetName()) == c.end() )
+      continue;
+    TClass* cl = TClass::GetClass(br->GetClassName());
+    if ( !cl || !cl->GetCollectionProxy() )   {
+      input.warning("+++ Ignore branch %s of type %s: no collection.", br->GetName(), br->GetClassName());
+      continue;
+    }
+    Branch b;
+    b.branch = br;
+    b.clazz  = cl;
+    b.key    = Key(input.m_mask, br->GetName()).toLong();
+    b.table  = table(cl->GetCollectionProxy()->GetValueClass());
+    branches.emplace_back(b);
+    tree->AddBranchToCache(br, kTRUE);
+  }
+  tree->StopCacheLearningPhase();
+  input.info("+++ Reading %lld events with %ld containers from %s",
+             tree->GetEntries(), branches.size(), fname.c_str());
+  for( Long64_t entry=0, n=tree->GetEntries(); entry < n; ++entry )   {
+    if ( !push(decode(entry, branches)) ) break;
+  }
+  tree->ResetBranchAddresses();
+}
+
+/// Thread function of the read-ahead thread
+void DigiDDG4Input::internals_t::run()   {
+  try  {
+    if ( input.m_parallelUnzip )
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    for( const auto& fname : input.m_input )   {
+      read(fname);
+      if ( stop || !error.empty() ) break;
+    }
+  }
+  catch(const exception& e)   {
+    error = e.what();
+  }
+  {
+    lock_guard<mutex> guard(lock);
+    finished = true;
+  }
+  not_empty.notify_all();
+}
+
+/// Queue decoded event. Blocks while the queue is full
+bool DigiDDG4Input::internals_t::push(DigiDDG4InputData* data)  {
+  unique_lock<mutex> guard(lock);
+  size_t max_len = size_t(std::max(1, input.m_readAhead));
+  not_full.wait(guard, [this,max_len]  { return stop || queue.size() < max_len; });
+  if ( stop )   {
+    delete data;
+    return false;
+  }
+  queue.emplace_back(data);
+  guard.unlock();
+  not_empty.notify_one();
+  return true;
+}
+
+/// Access the next event. Blocks until an event is available. Null at end of input
+DigiDDG4InputData* DigiDDG4Input::internals_t::next()   {
+  unique_lock<mutex> guard(lock);
+  not_empty.wait(guard, [this]  { return finished || !queue.empty(); });
+  if ( queue.empty() ) return 0;
+  DigiDDG4InputData* data = queue.front();
+  queue.pop_front();
+  guard.unlock();
+  not_full.notify_one();
+  return data;
+}
+
 /// Standard constructor
 DigiDDG4Input::DigiDDG4Input(const DigiKernel& kernel, const string& nam)
   : DigiInputAction(kernel, nam)
 {
+  declareProperty("TreeName",      m_treeName = "EVENT");
+  declareProperty("Containers",    m_containers);
+  declareProperty("ReadAhead",     m_readAhead = 8);
+  declareProperty("CacheSize",     m_cacheSize = 30*1024*1024);
+  declareProperty("ParallelUnzip", m_parallelUnzip = true);
+  declareProperty("Mask",          m_mask = 0);
+  declareProperty("DepositColumns",m_depositColumns = false);
+  imp.reset(new internals_t(*this));
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 DigiDDG4Input::~DigiDDG4Input()   {
+  imp.reset();
   InstanceCount::decrement(this);
 }
 
-/// Pre-track action callback
-void DigiDDG4Input::execute(DigiContext& /* context */)  const   {
-  ::sleep(1);
-  info("+++ Virtual method execute()");
-  return;
-  //except("DigiDDG4Input","+++ Virtual method execute() MUST be overloaded!");
+/// Access the next decoded event. Blocks until available. Null at end of input
+unique_ptr<DigiDDG4InputData> DigiDDG4Input::next()  const   {
+  if ( m_input.empty() )   {
+    except("+++ No input files specified!");
+  }
+  call_once(imp->started, [this]  { imp->start(); });
+  unique_ptr<DigiDDG4InputData> data(imp->next());
+  if ( !data && !imp->error.empty() )   {
+    except("+++ Input error: %s", imp->error.c_str());
+  }
+  return data;
+}
+
+/// Check if all input events were consumed
+bool DigiDDG4Input::endOfInput()  const   {
+  return imp->end_of_input;
+}
+
+/// Callback to read event input
+void DigiDDG4Input::execute(DigiContext& context)  const   {
+  unique_ptr<DigiDDG4InputData> data(next());
+  if ( !data )   {
+    // Normal end of the input: the event stays empty. Report it once
+    if ( !imp->end_of_input.exchange(true) )   {
+      info("+++ End of input: all %ld events of %ld input files processed.",
+             imp->num_events, m_input.size());
+    }
+    return;
+  }
+  DigiEvent& event = context.event();
+  for( auto& d : data->energyDeposits )   {
+    if ( !event.energyDeposits.emplace(d.first, d.second).second )
+      warning("+++ Event %d: Energy deposit container %016lX already present.",
+              event.eventNumber, d.first);
+  }
+  data->energyDeposits.clear();
+  for( auto& d : data->depositColumns )   {
+    if ( !event.depositColumns.emplace(d.first, d.second).second )
+      warning("+++ Event %d: Deposit columns %016lX already present.",
+              event.eventNumber, d.first);
+  }
+  data->depositColumns.clear();
+  debug("+++ Event %d: Read input entry %ld with %ld containers and %ld deposits.",
+        event.eventNumber, data->entry, data->containers.size(), data->deposits.size());
+  event.addExtension(data.release());
 }
@@ -19,6 +19,8 @@
 #include "DDDigi/DigiData.h"
 
 // C/C++ include files
+#include <algorithm>
+#include <numeric>
 #include <mutex>
 
 using namespace std;
@@ -60,6 +62,182 @@ void Key::set(const std::string& name, int mask)    {
   values.item = detail::hash32(name);
 }
 
+/// Reserve space in all columns
+void DigiDepositColumns::reserve(std::size_t len)   {
+  cellID.reserve(len);
+  energy.reserve(len);
+  time.reserve(len);
+  position.reserve(len);
+}
+
+/// Remove all deposits
+void DigiDepositColumns::clear()   {
+  m_sorted = true;
+  cellID.clear();
+  energy.clear();
+  time.clear();
+  position.clear();
+}
+
+/// Append all deposits of another container, shifted in time. Caller must hold the lock
+void DigiDepositColumns::append_unlocked(const DigiDepositColumns& other, double time_offset)   {
+  if ( &other == this )   {
+    except("DigiDepositColumns","+++ %s: Cannot append a container to itself.", m_name.c_str());
+  }
+  if ( other.empty() ) return;
+  size_t len = cellID.size();
+  m_sorted = other.m_sorted && (len == 0 || (m_sorted && cellID.back() < other.cellID.front()));
+  cellID.insert(cellID.end(), other.cellID.begin(), other.cellID.end());
+  energy.insert(energy.end(), other.energy.begin(), other.energy.end());
+  time.insert(time.end(), other.time.begin(), other.time.end());
+  position.insert(position.end(), other.position.begin(), other.position.end());
+  if ( time_offset != 0e0 )   {
+    for( size_t i = len, n = time.size(); i < n; ++i )
+      time[i] += time_offset;
+  }
+}
+
+/// Thread safe: append all deposits of another container, shifted in time
+void DigiDepositColumns::append(const DigiDepositColumns& other, double time_offset)   {
+  lock_guard<mutex> lock(m_lock);
+  append_unlocked(other, time_offset);
+}
+
+/// Thread safe: append legacy energy deposits, shifted in time
+void DigiDepositColumns::append(const DigiEnergyDeposits& deposits, double time_offset)   {
+  lock_guard<mutex> lock(m_lock);
+  reserve(cellID.size() + deposits.size());
+  for( const EnergyDeposit* dep : deposits )
+    emplace_back(dep->cellID(), dep->deposit(), time_offset, dep->position());
+}
+
+/// Thread safe: merge another container, shifted in time
+void DigiDepositColumns::merge(const DigiDepositColumns& other, double time_offset)   {
+  lock_guard<mutex> lock(m_lock);
+  if ( &other != this && m_sorted && other.m_sorted && !empty() )
+    merge_unlocked({ { &other, time_offset } });
+  else
+    append_unlocked(other, time_offset);
+}
+
+/// Thread safe: merge several containers, each shifted by its time offset
+void DigiDepositColumns::merge(const vector<pair<const DigiDepositColumns*, double> >& inputs)   {
+  lock_guard<mutex> lock(m_lock);
+  compact_unlocked();
+  merge_unlocked(inputs);
+}
+
+/// Merge compacted containers into this compacted container. Caller must hold the lock
+void DigiDepositColumns::merge_unlocked(const vector<pair<const DigiDepositColumns*, double> >& inputs)   {
+  typedef pair<CellID, size_t> entry_t;   // (cell, run)
+
+  // Sorted runs: this container first, then the inputs
+  vector<pair<const DigiDepositColumns*, double> > runs;
+  runs.reserve(inputs.size()+1);
+  runs.emplace_back(this, 0e0);
+  size_t total = cellID.size();
+  for( const auto& in : inputs )   {
+    if ( in.first == this )   {
+      except("DigiDepositColumns","+++ %s: Cannot merge a container with itself.", m_name.c_str());
+    }
+    if ( in.first && !in.first->empty() )   {
+      if ( !in.first->m_sorted )   {
+        except("DigiDepositColumns","+++ %s: Cannot merge the unsorted container %s. Call compact() first.",
+               m_name.c_str(), in.first->m_name.c_str());
+      }
+      runs.emplace_back(in);
+      total += in.first->size();
+    }
+  }
+  if ( runs.size() < 2 ) return;
+
+  vector<size_t>  cursor(runs.size(), 0);
+  vector<entry_t> heap;
+  heap.reserve(runs.size());
+  auto greater = [](const entry_t& a, const entry_t& b)  { return a.first > b.first; };
+  for( size_t r = 0; r < runs.size(); ++r )   {
+    if ( !runs[r].first->empty() )
+      heap.emplace_back(runs[r].first->cellID[0], r);
+  }
+  make_heap(heap.begin(), heap.end(), greater);
+
+  vector<CellID>   c;
+  vector<double>   e, t;
+  vector<Position> p;
+  c.reserve(total); e.reserve(total); t.reserve(total); p.reserve(total);
+  while( !heap.empty() )   {
+    pop_heap(heap.begin(), heap.end(), greater);
+    entry_t top = heap.back();
+    heap.pop_back();
+    const DigiDepositColumns& run = *runs[top.second].first;
+    size_t i    = cursor[top.second]++;
+    double dep  = run.energy[i];
+    double tim  = run.time[i] + runs[top.second].second;
+    if ( !c.empty() && c.back() == top.first )   {
+      double sum = e.back() + dep;
+      if ( sum != 0e0 ) p.back() = (e.back() * p.back() + dep * run.position[i]) / sum;
+      e.back() = sum;
+      t.back() = std::min(t.back(), tim);
+    }
+    else   {
+      c.emplace_back(top.first);
+      e.emplace_back(dep);
+      t.emplace_back(tim);
+      p.emplace_back(run.position[i]);
+    }
+    if ( ++i < run.size() )   {
+      heap.emplace_back(run.cellID[i], top.second);
+      push_heap(heap.begin(), heap.end(), greater);
+    }
+  }
+  cellID.swap(c);
+  energy.swap(e);
+  time.swap(t);
+  position.swap(p);
+}
+
+/// Thread safe: sort by cell and sum deposits of identical cells
+void DigiDepositColumns::compact()   {
+  lock_guard<mutex> lock(m_lock);
+  compact_unlocked();
+}
+
+/// Sum deposits of identical cells. Caller must hold the lock
+void DigiDepositColumns::compact_unlocked()   {
+  size_t len = cellID.size();
+  if ( m_sorted ) return;
+  m_sorted = true;
+  if ( len < 2 ) return;
+  vector<size_t> order(len);
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)  { return cellID[a] < cellID[b]; });
+
+  vector<CellID>   c;
+  vector<double>   e, t;
+  vector<Position> p;
+  c.reserve(len); e.reserve(len); t.reserve(len); p.reserve(len);
+  for( size_t i = 0; i < len; )   {
+    size_t   j    = order[i];
+    CellID   cell = cellID[j];
+    double   sum  = 0e0, first = time[j];
+    Position pos;
+    for( ; i < len && cellID[order[i]] == cell; ++i )   {
+      j      = order[i];
+      sum   += energy[j];
+      pos   += energy[j] * position[j];
+      first  = std::min(first, time[j]);
+    }
+    c.emplace_back(cell);
+    e.emplace_back(sum);
+    t.emplace_back(first);
+    p.emplace_back(sum != 0e0 ? pos / sum : position[j]);
+  }
+  cellID.swap(c);
+  energy.swap(e);
+  time.swap(t);
+  position.swap(p);
+}
+
 /// Intializing constructor
 DigiEvent::DigiEvent()
   : ObjectExtensions(typeid(DigiEvent))
@@ -79,3 +257,11 @@ DigiEvent::~DigiEvent()
 {
   InstanceCount::decrement(this);
 }
+
+/// Thread safe access to the columnar deposits of a detector segment. Created if not present
+DigiDepositColumns& DigiEvent::columns(const Key& key, const std::string& name)   {
+  lock_guard<mutex> lock(m_lock);
+  auto& cols = depositColumns[key.toLong()];
+  if ( !cols ) cols = make_shared<DigiDepositColumns>(name);
+  return *cols;
+}
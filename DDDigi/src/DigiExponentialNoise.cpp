@@ -17,6 +17,10 @@
 #include "DDDigi/DigiRandomGenerator.h"
 #include "DDDigi/DigiExponentialNoise.h"
 
+// C/C++ include files
+#include <vector>
+#include <cmath>
+
 using namespace dd4hep::digi;
 
 /// Standard constructor
@@ -36,3 +40,11 @@ DigiExponentialNoise::~DigiExponentialNoise() {
 double DigiExponentialNoise::operator()(DigiCellContext& context)  const  {
   return context.context.randomGenerator().exponential(m_tau);
 }
+
+/// Batch processing: add exponential noise to all cells of the batch
+void DigiExponentialNoise::process(DigiCellBatch& batch)  const  {
+  std::vector<double> rndm(batch.size);
+  stream(batch).fill_uniform(batch.first, rndm.data(), batch.size);
+  for( std::size_t i=0; i < batch.size; ++i )
+    batch.values[i] += -m_tau * std::log(rndm[i]);
+}
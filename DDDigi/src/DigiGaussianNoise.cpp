@@ -17,6 +17,9 @@
 #include "DDDigi/DigiRandomGenerator.h"
 #include "DDDigi/DigiGaussianNoise.h"
 
+// C/C++ include files
+#include <vector>
+
 using namespace dd4hep::digi;
 
 /// Standard constructor
@@ -40,3 +43,11 @@ double DigiGaussianNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().gaussian(m_mean,m_sigma);
 }
+
+/// Batch processing: add gaussian noise to all cells of the batch
+void DigiGaussianNoise::process(DigiCellBatch& batch)  const  {
+  std::vector<double> rndm(batch.size);
+  stream(batch).fill_gaussian(batch.first, rndm.data(), batch.size);
+  for( std::size_t i=0; i < batch.size; ++i )
+    batch.values[i] += batch.signals[i] < m_cutoff ? 0e0 : m_mean + m_sigma * rndm[i];
+}
@@ -21,10 +21,12 @@
 
 #include "DDDigi/DigiKernel.h"
 #include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiProfiler.h"
 #include "DDDigi/DigiActionSequence.h"
 
 #ifdef DD4HEP_USE_TBB
-#include "tbb/tbb.h"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 #endif
 
 // C/C++ include files
@@ -32,6 +34,7 @@
 #include <algorithm>
 #include <memory>
 #include <chrono>
+#include <map>
 
 using namespace std;
 using namespace dd4hep;
@@ -62,8 +65,12 @@ public:
   DigiActionSequence*   eventAction = 0;
   /// The main data output action sequence
   DigiActionSequence*   outputAction = 0;
-  /// TBB initializer (If TBB is used)
-  void*                 tbbInit = 0;
+#ifdef DD4HEP_USE_TBB
+  /// TBB task arena hosting all event and action tasks (If TBB is used)
+  std::unique_ptr<tbb::task_arena> arena;
+#endif
+  /// Profiler of the action execution
+  DigiProfiler          profiler;
   /// Property: Output level
   int                   outputLevel;
   /// Property: maximum number of events to be processed (if < 0: infinite)
@@ -74,6 +81,12 @@ public:
   int                   numThreads;
   /// Property: Allow to stop execution from interactive prompt
   bool                  stop = false;
+  /// Property: Measure the execution time of each action
+  bool                  actionTiming = false;
+  /// Property: Output file of the execution trace (chrome trace format)
+  std::string           profileTrace;
+  /// Property: Output file of the folded call stacks (flame graph format)
+  std::string           profileFolded;
   Internals() = default;
   ~Internals() = default;
 };
@@ -87,16 +100,21 @@ public:
  */
 class DigiKernel::Wrapper  {
 public:
+  const DigiKernel& kernel;
   DigiContext& context;
   DigiEventAction*  action = 0;
-  Wrapper(DigiContext& c, DigiEventAction* a)
-    : context(c), action(a) {}
+  /// Profiler node of the submitting sequence
+  int               parent = -1;
+  /// Submission time for the queue wait measurement
+  double            submitted = -1e0;
+  Wrapper(const DigiKernel& k, DigiContext& c, DigiEventAction* a, int p, double t)
+    : kernel(k), context(c), action(a), parent(p), submitted(t) {}
   Wrapper(Wrapper&& copy) = default;
   Wrapper(const Wrapper& copy) = default;
   Wrapper& operator=(Wrapper&& copy) = delete;
   Wrapper& operator=(const Wrapper& copy) = delete;
   void operator()() const {
-    action->execute(context);
+    kernel.executeAction(action, context, parent, submitted);
   }
 };
 
@@ -140,7 +158,7 @@ DigiKernel::DigiKernel(Detector& description_ref)
 {
   internals = new Internals();
 #ifdef DD4HEP_USE_TBB
-  internals->numThreads = tbb::task_scheduler_init::default_num_threads();
+  internals->numThreads = tbb::this_task_arena::max_concurrency();
 #else
   internals->numThreads = -1;
 #endif
@@ -148,6 +166,9 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->numThreads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("actionTiming",     internals->actionTiming = false);
+  declareProperty("profileTrace",     internals->profileTrace);
+  declareProperty("profileFolded",    internals->profileFolded);
   declareProperty("OutputLevel",      internals->outputLevel = DEBUG);
   declareProperty("OutputLevels",     internals->clientLevels);
   internals->inputAction  = new DigiActionSequence(*this, "InputAction");
@@ -161,10 +182,6 @@ DigiKernel::DigiKernel(Detector& description_ref)
 
 /// Default destructor
 DigiKernel::~DigiKernel() {
-#ifdef DD4HEP_USE_TBB
-  tbb::task_scheduler_init* init = (tbb::task_scheduler_init*)internals->tbbInit;
-  if ( init ) delete init;
-#endif
   detail::releasePtr(internals->outputAction);
   detail::releasePtr(internals->eventAction);
   detail::releasePtr(internals->inputAction);
@@ -266,22 +283,39 @@ DigiActionSequence& DigiKernel::outputAction() const    {
   return *internals->outputAction;
 }
 
+/// Execute a single action. Optionally the execution is profiled
+void DigiKernel::executeAction(DigiEventAction* action, DigiContext& context, int parent, double submitted)   const  {
+  if ( !internals->profiler.enabled() )   {
+    action->execute(context);
+    return;
+  }
+  DigiProfiler::Scope scope(internals->profiler, parent, action, action->c_name(),
+                            context.event().eventNumber, submitted);
+  action->execute(context);
+}
+
 void DigiKernel::submit(const DigiAction::Actors<DigiEventAction>& actions, DigiContext& context)   const  {
   chrono::system_clock::time_point start = chrono::system_clock::now();
-  bool parallel = 0 != internals->tbbInit && internals->numThreads>0;
+  bool parallel = false;
 #ifdef DD4HEP_USE_TBB
+  // Called from within the kernel's task arena: the tasks are spawned to the
+  // same arena and hence share the worker threads with the events in flight.
+  parallel = internals->arena && internals->numThreads>0 && actions.size() > 1;
   if ( parallel )   {
+    DigiProfiler& prof = internals->profiler;
+    int    parent = prof.current();
+    double now    = prof.enabled() ? prof.now() : -1e0;
     tbb::task_group que;
     for ( auto* i : actions )
-      que.run(Wrapper(context, i));
+      que.run(Wrapper(*this, context, i, parent, now));
     que.wait();
-    goto print_stamp;
   }
 #endif
-  actions(&DigiEventAction::execute,context);
-  goto print_stamp;
-
- print_stamp:
+  if ( !parallel )   {
+    int parent = internals->profiler.current();
+    for ( auto* i : actions )
+      executeAction(i, context, parent, -1e0);
+  }
   chrono::duration<double> secs = chrono::system_clock::now() - start;
   printout(DEBUG,"DigiKernel","+++ Event: %8d Executed %s task group with %3ld members [%8.3g sec]",
            context.event().eventNumber, parallel ? "parallel" : "serial", actions.size(),
@@ -289,7 +323,9 @@ void DigiKernel::submit(const DigiAction::Actors<DigiEventAction>& actions, Digi
 }
 
 void DigiKernel::execute(const DigiAction::Actors<DigiEventAction>& actions, DigiContext& context)   const  {
-  actions(&DigiEventAction::execute,context);
+  int parent = internals->profiler.current();
+  for ( auto* i : actions )
+    executeAction(i, context, parent, -1e0);
 }
 
 void DigiKernel::wait(DigiContext& context)   const  {
@@ -300,9 +336,14 @@ void DigiKernel::wait(DigiContext& context)   const  {
 void DigiKernel::executeEvent(DigiContext* context)    {
   DigiContext& refContext = *context;
   try {
-    inputAction().execute(refContext);
-    eventAction().execute(refContext);
-    outputAction().execute(refContext);
+    {
+      // The event is the root of the profiled call tree
+      DigiProfiler::Scope scope(internals->profiler, -1, 0, "Event", refContext.event().eventNumber, -1e0);
+      int event_node = internals->profiler.current();
+      executeAction(internals->inputAction,  refContext, event_node, -1e0);
+      executeAction(internals->eventAction,  refContext, event_node, -1e0);
+      executeAction(internals->outputAction, refContext, event_node, -1e0);
+    }
     notify(context);
   }
   catch(const exception& e)   {
@@ -332,26 +373,31 @@ int DigiKernel::run()   {
   chrono::system_clock::time_point start = chrono::system_clock::now();
   internals->stop = false;
   internals->eventsToDo = internals->numEvents;
+  bool profile = internals->actionTiming || !internals->profileTrace.empty() || !internals->profileFolded.empty();
+  internals->profiler.start(profile, !internals->profileTrace.empty());
   printout(INFO,
            "DigiKernel","+++ Total number of events:    %d",internals->numEvents);
 #ifdef DD4HEP_USE_TBB
-  if ( 0 == internals->tbbInit && internals->numThreads>=0 )   {
+  if ( internals->numThreads>=0 )   {
     if ( 0 == internals->numThreads )
-      internals->numThreads = tbb::task_scheduler_init::default_num_threads();
+      internals->numThreads = tbb::this_task_arena::max_concurrency();
     printout(INFO,
              "DigiKernel","+++ Number of TBB threads to:  %d",internals->numThreads);
     printout(INFO,
              "DigiKernel","+++ Number of parallel events: %d",internals->maxEventsParallel);
-    internals->tbbInit = new tbb::task_scheduler_init(internals->numThreads);
-    if ( internals->maxEventsParallel > 1 )   {
-      int todo_evt = internals->eventsToDo;
-      int num_proc = std::min(todo_evt,internals->maxEventsParallel);
-      tbb::task_group main_group;
-      for(int i=0; i < num_proc; ++i)
-        main_group.run(Processor(*this));
-      main_group.wait();
-      printout(DEBUG,"DigiKernel","+++ All event processing threads Synchronized --- Done!");
-    }
+    internals->arena.reset(new tbb::task_arena(internals->numThreads));
+    // Inter-event parallelism: at most maxEventsParallel event processors are
+    // active. Intra-event parallelism: parallel sequences spawn their actions
+    // to the same arena (see submit).
+    int todo_evt = internals->eventsToDo;
+    int num_proc = std::max(1,std::min(todo_evt,internals->maxEventsParallel));
+    internals->arena->execute([this, num_proc]()  {
+        tbb::task_group main_group;
+        for(int i=0; i < num_proc; ++i)
+          main_group.run(Processor(*this));
+        main_group.wait();
+      });
+    printout(DEBUG,"DigiKernel","+++ All event processing threads Synchronized --- Done!");
   }
 #endif
   while ( internals->eventsToDo > 0 && !internals->stop )   {
@@ -359,11 +405,21 @@ int DigiKernel::run()   {
     proc();
   }
   chrono::duration<double> duration = chrono::system_clock::now() - start;
-  double sec = chrono::duration_cast<chrono::seconds>(duration).count();
+  double sec = duration.count();
+  int num_done = internals->numEvents-int(internals->eventsToDo);
   printout(DEBUG,"DigiKernel","+++ %d Events out of %d processed. "
            "Total: %7.1f seconds %7.3f seconds/event",
-           internals->numEvents, internals->numEvents-int(internals->eventsToDo),
+           internals->numEvents, num_done,
            sec, sec/double(std::max(1,internals->numEvents)));
+  printout(INFO,"DigiKernel","+++ Throughput: %d threads %d parallel events: %9.2f events/sec",
+           internals->numThreads, internals->maxEventsParallel,
+           sec > 0e0 ? double(num_done)/sec : 0e0);
+  if ( internals->actionTiming )
+    internals->profiler.print();
+  if ( !internals->profileTrace.empty() )
+    internals->profiler.writeTrace(internals->profileTrace);
+  if ( !internals->profileFolded.empty() )
+    internals->profiler.writeFolded(internals->profileFolded);
   return 1;
 }
 
@@ -16,6 +16,10 @@
 #include "DDDigi/DigiLandauNoise.h"
 #include "DDDigi/DigiSegmentation.h"
 #include "DDDigi/DigiRandomGenerator.h"
+#include "Math/QuantFuncMathCore.h"
+
+// C/C++ include files
+#include <vector>
 
 using namespace dd4hep::digi;
 
@@ -40,3 +44,14 @@ double DigiLandauNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().landau(m_mean,m_sigma);
 }
+
+/// Batch processing: add landau noise to all cells of the batch
+void DigiLandauNoise::process(DigiCellBatch& batch)  const  {
+  if ( m_sigma <= 0e0 ) return;
+  std::vector<double> rndm(batch.size);
+  stream(batch).fill_uniform(batch.first, rndm.data(), batch.size);
+  for( std::size_t i=0; i < batch.size; ++i )   {
+    if ( batch.signals[i] >= m_cutoff )
+      batch.values[i] += m_mean + ROOT::Math::landau_quantile(rndm[i], m_sigma);
+  }
+}
@@ -0,0 +1,138 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDDigi/DigiContext.h"
+#include "DDDigi/DigiDDG4Input.h"
+#include "DDDigi/DigiOverlayInput.h"
+#include "DDDigi/DigiRandomStream.h"
+#include "DDDigi/DigiRandomGenerator.h"
+
+// C/C++ include files
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+/// Add a background event. The columns are compacted
+void DigiOverlayPool::add(event_t&& evt)   {
+  for( auto& c : evt )   {
+    c.second->compact();
+    m_numDeposits += c.second->size();
+  }
+  m_events.emplace_back(std::move(evt));
+}
+
+/// Standard constructor
+DigiOverlayInput::DigiOverlayInput(const DigiKernel& kernel, const string& nam)
+  : DigiInputAction(kernel, nam)
+{
+  declareProperty("TreeName",       m_treeName = "EVENT");
+  declareProperty("Containers",     m_containers);
+  declareProperty("PoolSize",       m_poolSize = 0);
+  declareProperty("Mu",             m_mu = 0e0);
+  declareProperty("Poisson",        m_poisson = true);
+  declareProperty("BunchCrossings", m_bunchCrossings = { 0 });
+  declareProperty("BunchSpacing",   m_bunchSpacing = 25e0);
+  declareProperty("Mask",           m_mask = 0);
+  declareProperty("Seed",           m_seed = 0);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiOverlayInput::~DigiOverlayInput()   {
+  InstanceCount::decrement(this);
+}
+
+/// Set the background pool explicitly (e.g. shared between several overlay actions)
+void DigiOverlayInput::setPool(shared_ptr<DigiOverlayPool> pool)   {
+  if ( !pool )   {
+    except("+++ Invalid background pool.");
+  }
+  bool assigned = false;
+  call_once(m_poolLoaded, [this, &pool, &assigned]  { m_pool = std::move(pool); assigned = true; });
+  if ( !assigned )   {
+    except("+++ The background pool is already loaded and cannot be replaced.");
+  }
+}
+
+/// Access the background pool. Loaded if not yet present
+const DigiOverlayPool& DigiOverlayInput::pool()  const   {
+  call_once(m_poolLoaded, [this]  { this->load_pool(); });
+  return *m_pool;
+}
+
+/// Load the background pool from the input files
+void DigiOverlayInput::load_pool()  const   {
+  if ( m_input.empty() )   {
+    except("+++ No background input files specified!");
+  }
+  auto pool = make_shared<DigiOverlayPool>();
+  auto* reader = new DigiDDG4Input(m_kernel, m_name+"_Pool");
+  try   {
+    reader->property("Input").set(m_input);
+    reader->property("TreeName").set(m_treeName);
+    reader->property("Containers").set(m_containers);
+    reader->property("DepositColumns").set(true);
+    while( m_poolSize <= 0 || long(pool->size()) < m_poolSize )   {
+      unique_ptr<DigiDDG4InputData> data(reader->next());
+      if ( !data ) break;
+      pool->add(std::move(data->depositColumns));
+    }
+  }
+  catch(...)   {
+    reader->release();
+    throw;
+  }
+  reader->release();
+  if ( pool->size() == 0 )   {
+    except("+++ The background pool is empty. Check the input files.");
+  }
+  info("+++ Loaded background pool: %ld events with %ld deposits.",
+       pool->size(), pool->numDeposits());
+  m_pool = std::move(pool);
+}
+
+/// Callback to overlay the background on the event
+void DigiOverlayInput::execute(DigiContext& context)  const   {
+  typedef vector<pair<const DigiDepositColumns*, double> > inputs_t;
+  const DigiOverlayPool& background = pool();
+  DigiEvent&             event = context.event();
+  DigiRandomStream       random(m_seed, event.eventNumber, detail::hash64(m_name));
+  DigiRandomGenerator    generator;
+  map<unsigned long, inputs_t> inputs;
+  size_t num_events = 0;
+
+  for( size_t ibx = 0; ibx < m_bunchCrossings.size(); ++ibx )   {
+    double offset = double(m_bunchCrossings[ibx]) * m_bunchSpacing;
+    auto   engine = random.engine(ibx);
+    generator.engine = std::ref(engine);
+    long   count  = long(m_poisson ? generator.poisson(m_mu) : std::floor(m_mu + 0.5));
+    for( long i = 0; i < count; ++i )   {
+      size_t which = std::min(size_t(engine() * double(background.size())), background.size()-1);
+      for( const auto& c : background.event(which) )
+        inputs[c.first].emplace_back(c.second.get(), offset);
+    }
+    num_events += count;
+  }
+  for( const auto& in : inputs )   {
+    Key key;
+    key.key = in.first;
+    key.values.mask = Key::mask_type(m_mask);
+    event.columns(key, in.second.front().first->name()).merge(in.second);
+  }
+  debug("+++ Event: %8d Overlaid %ld background events in %ld bunch crossings on %ld containers.",
+        event.eventNumber, num_events, m_bunchCrossings.size(), inputs.size());
+}
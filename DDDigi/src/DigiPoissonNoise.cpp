@@ -39,3 +39,18 @@ double DigiPoissonNoise::operator()(DigiCellContext& context)  const  {
     return 0;
   return context.context.randomGenerator().poisson(m_mean);
 }
+
+/// Batch processing: add poisson noise to all cells of the batch
+void DigiPoissonNoise::process(DigiCellBatch& batch)  const  {
+  // The number of random numbers per cell varies: each cell draws
+  // sequentially from its own sub-stream of the counter based generator
+  DigiRandomStream    rndm = stream(batch);
+  DigiRandomGenerator generator;
+  for( std::size_t i=0; i < batch.size; ++i )   {
+    if ( batch.signals[i] < m_cutoff )   {
+      auto engine = rndm.engine(batch.first+i);
+      generator.engine = std::ref(engine);
+      batch.values[i] += generator.poisson(m_mean);
+    }
+  }
+}
@@ -0,0 +1,263 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDDigi/DigiProfiler.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <fstream>
+#include <ctime>
+
+using namespace std;
+using namespace dd4hep::digi;
+
+/// Per thread measurement buffer
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+struct DigiProfiler::Buffer  {
+  /// Sequential thread number
+  int                                   thread = 0;
+  /// Statistics per node
+  vector<Stat>                          stats;
+  /// Execution records (if tracing is enabled)
+  vector<Record>                        records;
+  /// Local node lookup cache: avoids the lock of the global node table
+  map<pair<int, const void*>, int>      cache;
+};
+
+namespace  {
+  /// Thread local state of the profiler
+  struct ThreadState  {
+    const DigiProfiler* owner      = 0;
+    long                generation = -1;
+    void*               buffer     = 0;
+    int                 current    = -1;
+  };
+  thread_local ThreadState t_state;
+
+  /// CPU time of the calling thread in seconds
+  inline double thread_cpu()   {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return double(ts.tv_sec) + 1e-9*double(ts.tv_nsec);
+  }
+
+  /// Escape a string for JSON output
+  string json_escape(const string& s)   {
+    string r;
+    r.reserve(s.length());
+    for( char c : s )   {
+      if ( c == '"' || c == '\\' ) r += '\\';
+      if ( (unsigned char)c < 0x20 ) continue;
+      r += c;
+    }
+    return r;
+  }
+}
+
+/// Start measurement. submitted < 0: no queue wait
+DigiProfiler::Scope::Scope(DigiProfiler& prof, int parent, const DigiEventAction* action,
+                           const char* nam, int evt, double submitted)
+{
+  if ( !prof.enabled() ) return;
+  profiler = &prof;
+  node     = prof.node(prof.buffer(), parent, action, nam);
+  saved    = t_state.current;
+  event    = evt;
+  t_state.current = node;
+  start    = prof.now();
+  cpu      = thread_cpu();
+  wait     = submitted >= 0e0 ? std::max(0e0, start - submitted) : 0e0;
+}
+
+/// Stop measurement and record
+DigiProfiler::Scope::~Scope()   {
+  if ( !profiler ) return;
+  double  wall = profiler->now() - start;
+  double  used = thread_cpu() - cpu;
+  Buffer& buf  = profiler->buffer();
+  t_state.current = saved;
+  if ( size_t(node) >= buf.stats.size() ) buf.stats.resize(node+1);
+  Stat& s = buf.stats[node];
+  ++s.calls;
+  s.wall += wall;
+  s.cpu  += used;
+  s.wait += wait;
+  s.max   = std::max(s.max, wall);
+  if ( profiler->m_trace )
+    buf.records.emplace_back(Record{node, event, buf.thread, start, wall, used, wait});
+}
+
+/// Default constructor
+DigiProfiler::DigiProfiler() : m_start(chrono::steady_clock::now())  {
+}
+
+/// Default destructor
+DigiProfiler::~DigiProfiler()   {
+  if ( t_state.owner == this ) t_state = ThreadState();
+}
+
+/// Start a new profiling period. All previous measurements are dropped
+void DigiProfiler::start(bool enable, bool trace)   {
+  lock_guard<mutex> lock(m_lock);
+  m_nodes.clear();
+  m_nodeIndex.clear();
+  m_buffers.clear();
+  ++m_generation;
+  m_enabled = enable;
+  m_trace   = enable && trace;
+  m_start   = chrono::steady_clock::now();
+}
+
+/// Time since the start of the profiling period in seconds
+double DigiProfiler::now()  const   {
+  return chrono::duration<double>(chrono::steady_clock::now() - m_start).count();
+}
+
+/// Current node of the calling thread (parent of tasks submitted now)
+int DigiProfiler::current()  const   {
+  return (t_state.owner == this && t_state.generation == m_generation) ? t_state.current : -1;
+}
+
+/// Access the buffer of the calling thread
+DigiProfiler::Buffer& DigiProfiler::buffer()   {
+  if ( t_state.owner != this || t_state.generation != m_generation )   {
+    lock_guard<mutex> lock(m_lock);
+    m_buffers.emplace_back(new Buffer());
+    m_buffers.back()->thread = int(m_buffers.size()) - 1;
+    t_state.owner      = this;
+    t_state.generation = m_generation;
+    t_state.buffer     = m_buffers.back().get();
+    t_state.current    = -1;
+  }
+  return *(Buffer*)t_state.buffer;
+}
+
+/// Access (create) the node of an action below a parent node
+int DigiProfiler::node(Buffer& buf, int parent, const DigiEventAction* action, const char* nam)   {
+  auto key = make_pair(parent, (const void*)action);
+  auto it  = buf.cache.find(key);
+  if ( it != buf.cache.end() ) return it->second;
+  lock_guard<mutex> lock(m_lock);
+  auto ig = m_nodeIndex.find(key);
+  int  id = 0;
+  if ( ig == m_nodeIndex.end() )   {
+    id = int(m_nodes.size());
+    m_nodes.emplace_back(Node{parent, action, nam ? nam : "Event"});
+    m_nodeIndex.emplace(key, id);
+  }
+  else   {
+    id = ig->second;
+  }
+  buf.cache.emplace(key, id);
+  return id;
+}
+
+/// Combine the statistics of all threads
+vector<DigiProfiler::Stat> DigiProfiler::statistics()   {
+  lock_guard<mutex> lock(m_lock);
+  vector<Stat> result(m_nodes.size());
+  for( const auto& b : m_buffers )   {
+    for( size_t i = 0; i < b->stats.size(); ++i )   {
+      Stat& s = result[i];
+      s.calls += b->stats[i].calls;
+      s.wall  += b->stats[i].wall;
+      s.cpu   += b->stats[i].cpu;
+      s.wait  += b->stats[i].wait;
+      s.max    = std::max(s.max, b->stats[i].max);
+    }
+  }
+  return result;
+}
+
+/// Print the summary per action
+void DigiProfiler::print()   {
+  if ( !m_enabled ) return;
+  vector<Stat> stats = statistics();
+  vector<int>  depth(m_nodes.size(), 0);
+  for( size_t i = 0; i < m_nodes.size(); ++i )   {
+    if ( m_nodes[i].parent >= 0 ) depth[i] = depth[m_nodes[i].parent] + 1;
+  }
+  printout(INFO,"DigiProfiler","+++ Profile of %ld threads. Times in seconds:", m_buffers.size());
+  printout(INFO,"DigiProfiler","+++ %-40s %8s %10s %10s %10s %10s %10s",
+           "Action", "Calls", "Wall", "Mean", "Max", "CPU", "Wait");
+  for( size_t i = 0; i < m_nodes.size(); ++i )   {
+    const Stat& s = stats[i];
+    string nam = string(2*depth[i], ' ') + m_nodes[i].name;
+    printout(INFO,"DigiProfiler","+++ %-40s %8ld %10.4f %10.4g %10.4g %10.4f %10.4f",
+             nam.c_str(), s.calls, s.wall, s.wall/double(std::max(1L, s.calls)),
+             s.max, s.cpu, s.wait);
+  }
+}
+
+/// Write the execution records in the chrome trace event format
+bool DigiProfiler::writeTrace(const string& file_name)   {
+  ofstream out(file_name);
+  if ( !out.good() )   {
+    printout(ERROR,"DigiProfiler","+++ Failed to open trace file %s", file_name.c_str());
+    return false;
+  }
+  lock_guard<mutex> lock(m_lock);
+  size_t num_records = 0;
+  bool   first = true;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for( const auto& b : m_buffers )   {
+    out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+        << b->thread << ",\"args\":{\"name\":\"DDDigi thread " << b->thread << "\"}}";
+    first = false;
+    for( const auto& r : b->records )   {
+      out << ",\n{\"name\":\"" << json_escape(m_nodes[r.node].name)
+          << "\",\"cat\":\"DDDigi\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.thread
+          << ",\"ts\":"  << long(1e6*r.start)
+          << ",\"dur\":" << long(1e6*r.wall)
+          << ",\"args\":{\"event\":" << r.event
+          << ",\"cpu_us\":"  << long(1e6*r.cpu)
+          << ",\"wait_us\":" << long(1e6*r.wait) << "}}";
+      ++num_records;
+    }
+  }
+  out << "\n]}\n";
+  printout(INFO,"DigiProfiler","+++ Wrote %ld trace records to %s", num_records, file_name.c_str());
+  return out.good();
+}
+
+/// Write the call tree in the folded stack format for flame graphs
+bool DigiProfiler::writeFolded(const string& file_name)   {
+  vector<Stat> stats = statistics();
+  ofstream out(file_name);
+  if ( !out.good() )   {
+    printout(ERROR,"DigiProfiler","+++ Failed to open folded stack file %s", file_name.c_str());
+    return false;
+  }
+  lock_guard<mutex> lock(m_lock);
+  vector<double> children(m_nodes.size(), 0e0);
+  vector<string> paths(m_nodes.size());
+  for( size_t i = 0; i < m_nodes.size(); ++i )   {
+    const Node& n = m_nodes[i];
+    // Nodes are created after their parents: the parent path is already known
+    paths[i] = n.parent >= 0 ? paths[n.parent] + ";" + n.name : n.name;
+    if ( n.parent >= 0 ) children[n.parent] += stats[i].wall;
+  }
+  for( size_t i = 0; i < m_nodes.size(); ++i )   {
+    // Parallel children may exceed the wall time of the parent
+    long self = long(1e6 * std::max(0e0, stats[i].wall - children[i]));
+    if ( self > 0 ) out << paths[i] << " " << self << "\n";
+  }
+  printout(INFO,"DigiProfiler","+++ Wrote %ld folded stacks to %s", m_nodes.size(), file_name.c_str());
+  return out.good();
+}
@@ -0,0 +1,87 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDDigi/DigiRandomStream.h"
+
+// C/C++ include files
+#include <algorithm>
+#include <cmath>
+
+using namespace dd4hep::digi;
+
+namespace {
+  /// Bit mixer to spread seed, event and subdetector over the full key
+  inline std::uint64_t splitmix64(std::uint64_t x)   {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+  /// Block size of the vectorizable fill loops
+  constexpr std::size_t BLOCK = 64;
+}
+
+/// Initializing constructor from the raw key
+DigiRandomStream::DigiRandomStream(key_type key)   {
+  m_key[0] = std::uint32_t(key);
+  m_key[1] = std::uint32_t(key>>32);
+}
+
+/// Initializing constructor: stream of one subdetector in a given event
+DigiRandomStream::DigiRandomStream(key_type seed, key_type event, key_type subdetector)
+  : DigiRandomStream(splitmix64(seed ^ splitmix64(event ^ splitmix64(subdetector))))
+{
+}
+
+/// Derive an independent stream (e.g. for a signal processor)
+DigiRandomStream DigiRandomStream::derive(key_type sub_key)  const   {
+  return DigiRandomStream(splitmix64(key() ^ splitmix64(sub_key)));
+}
+
+/// Single uniform random number in ]0,1[ of a cell
+double DigiRandomStream::uniform(std::uint64_t cell)  const   {
+  std::uint32_t b[4];
+  block(cell, 0, b);
+  return to_double(b[0], b[1]);
+}
+
+/// Fill uniform random numbers in ]0,1[ for the cells [first, first+n[
+void DigiRandomStream::fill_uniform(std::uint64_t first, double* out, std::size_t n)  const   {
+  // The loop body is branch free: the compiler can vectorize the Philox rounds
+  std::uint32_t b[BLOCK][4];
+  for( std::size_t i=0; i < n; i += BLOCK )   {
+    std::size_t len = std::min(BLOCK, n-i);
+    for( std::size_t j=0; j < len; ++j )
+      block(first+i+j, 0, b[j]);
+    for( std::size_t j=0; j < len; ++j )
+      out[i+j] = to_double(b[j][0], b[j][1]);
+  }
+}
+
+/// Fill unit gaussian random numbers for the cells [first, first+n[
+void DigiRandomStream::fill_gaussian(std::uint64_t first, double* out, std::size_t n)  const   {
+  // Box-Muller with both uniforms taken from the same Philox block
+  static constexpr double TWOPI = 2.0 * M_PI;
+  std::uint32_t b[BLOCK][4];
+  for( std::size_t i=0; i < n; i += BLOCK )   {
+    std::size_t len = std::min(BLOCK, n-i);
+    for( std::size_t j=0; j < len; ++j )
+      block(first+i+j, 0, b[j]);
+    for( std::size_t j=0; j < len; ++j )   {
+      double u1 = to_double(b[j][0], b[j][1]);
+      double u2 = to_double(b[j][2], b[j][3]);
+      out[i+j] = std::sqrt(-2.0*std::log(u1)) * std::cos(TWOPI*u2);
+    }
+  }
+}
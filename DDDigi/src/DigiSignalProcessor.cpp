@@ -14,11 +14,13 @@
 // Framework include files
 #include "DD4hep/InstanceCount.h"
 #include "DDDigi/DigiSignalProcessor.h"
+#include "DDDigi/DigiSegmentation.h"
 
 /// Standard constructor
 dd4hep::digi::DigiSignalProcessor::DigiSignalProcessor(const DigiKernel& krnl, const std::string& nam)
   : DigiAction(krnl, nam)
 {
+  m_streamKey = detail::hash64(nam);
   InstanceCount::increment(this);
 }
 
@@ -32,3 +34,13 @@ void dd4hep::digi::DigiSignalProcessor::initialize()   {
   m_initialized = true;
 }
 
+/// Process a batch of cells. The default implementation calls operator() for each cell
+void dd4hep::digi::DigiSignalProcessor::process(DigiCellBatch& batch)  const   {
+  for( std::size_t i=0; i < batch.size; ++i )   {
+    DigiCellData data;
+    data.signal = batch.signals[i];
+    DigiCellContext cell(batch.context, data);
+    batch.values[i] += (*this)(cell);
+  }
+}
+
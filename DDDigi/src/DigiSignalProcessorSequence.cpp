@@ -50,3 +50,11 @@ double DigiSignalProcessorSequence::operator()(DigiCellContext& context)  const
     result += p->operator()(context);
   return context.data.kill ? 0e0 : result;
 }
+
+/// Process a batch of cells: signal plus the contributions of all members
+void DigiSignalProcessorSequence::process(DigiCellBatch& batch)  const   {
+  for ( std::size_t i=0; i < batch.size; ++i )
+    batch.values[i] += batch.signals[i];
+  for ( const auto* p : m_actors )
+    p->process(batch);
+}
@@ -0,0 +1,36 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDDigi/DigiSparseNoise.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/QuantFuncMathCore.h"
+
+using namespace dd4hep::digi;
+
+/// Initializing constructor
+DigiSparseNoise::DigiSparseNoise(double sig, double thr)
+  : m_sigma(sig), m_threshold(thr)
+{
+  if ( m_sigma <= 0e0 )   {
+    except("DigiSparseNoise","Invalid noise width: %g. Must be positive.", m_sigma);
+  }
+  m_probability = ROOT::Math::normal_cdf_c(m_threshold, m_sigma);
+  m_logq        = std::log1p(-m_probability);
+}
+
+/// Noise amplitude above threshold for a uniform random number u in ]0,1[
+double DigiSparseNoise::tail(double u)  const   {
+  return ROOT::Math::normal_quantile_c(u * m_probability, m_sigma);
+}
@@ -13,7 +13,12 @@
 
 // Framework include files
 #include "DDDigi/DigiSubdetectorSequence.h"
+#include "DDDigi/DigiSignalProcessor.h"
 #include "DDDigi/DigiSegmentation.h"
+#include "DDDigi/DigiSparseNoise.h"
+#include "DDDigi/DigiRandomStream.h"
+#include "DDDigi/DigiRandomGenerator.h"
+#include "DDDigi/DigiContext.h"
 #include "DDDigi/DigiKernel.h"
 #include "DD4hep/InstanceCount.h"
 #include "DD4hep/Detector.h"
@@ -23,6 +28,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <algorithm>
 
 using namespace std;
 using namespace dd4hep::digi;
@@ -33,6 +39,12 @@ DigiSubdetectorSequence::DigiSubdetectorSequence(const DigiKernel& kernel, const
 {
   declareProperty("detector",m_detectorName);
   declareProperty("parallize_by",m_segmentName);
+  declareProperty("sparse",      m_sparse);
+  declareProperty("noise_sigma", m_noiseSigma);
+  declareProperty("threshold",   m_threshold);
+  declareProperty("mask",        m_mask);
+  declareProperty("seed",        m_seed);
+  declareProperty("batch_size",  m_batchSize);
   m_cellHandler = [this](DigiContext& context, const DigiCellScanner& scanner, const DigiCellData& data)  {
     this->process_cell(context, scanner, data);
   };
@@ -41,9 +53,21 @@ DigiSubdetectorSequence::DigiSubdetectorSequence(const DigiKernel& kernel, const
 
 /// Default destructor
 DigiSubdetectorSequence::~DigiSubdetectorSequence() {
+  m_processors(&DigiSignalProcessor::release);
+  m_processors.clear();
   InstanceCount::decrement(this);
 }
 
+/// Adopt a signal processor. The sequence takes ownership.
+void DigiSubdetectorSequence::adoptProcessor(DigiSignalProcessor* processor)   {
+  if ( processor )    {
+    processor->addRef();
+    m_processors.add(processor);
+    return;
+  }
+  except("+++ Attempt to add invalid signal processor!");
+}
+
 /// Initialize subdetector sequencer
 void DigiSubdetectorSequence::initialize()   {
   info("Initializing detector sequencer for detector: %s",m_detectorName.c_str());
@@ -51,6 +75,10 @@ void DigiSubdetectorSequence::initialize()   {
   m_sensDet      = sensitiveDetector(m_detectorName);
   m_parallelVid.clear();
   m_parallelDet.clear();
+  m_sensors.clear();
+  m_sensorIndex.clear();
+  m_volumeMask = 0;
+  m_numCells = 0;
   if ( m_detector.isValid() && m_sensDet.isValid() )   {
     m_idDesc       = m_sensDet.readout().idSpec();
     m_segmentation = m_sensDet.readout().segmentation();
@@ -58,7 +86,53 @@ void DigiSubdetectorSequence::initialize()   {
     VolumeID      vid = m_idDesc.encode(ids);
     VolumeID      msk = m_idDesc.get_mask(ids);
     scan_detector(m_detector, vid, msk);
+    if ( m_sparse || m_processors.size() > 0 )   {
+      for( const auto& d : m_parallelVid )
+        collect_sensors(d.second.detector.placement(), d.second.detector_id, d.second.detector_mask);
+    }
+    if ( m_sparse )   {
+      info("Sparse scanning: %ld sensors with %lld grid cells. Noise occupancy: %g",
+           m_sensors.size(), (long long)m_numCells,
+           m_noiseSigma > 0e0 ? DigiSparseNoise(m_noiseSigma, m_threshold).probability() : 0e0);
+    }
+    else if ( m_processors.size() > 0 )   {
+      for( auto* p : m_processors ) p->initialize();
+      info("Batch processing: %ld sensors with %lld grid cells. %ld signal processors. Batch size: %ld",
+           m_sensors.size(), (long long)m_numCells, m_processors.size(), m_batchSize);
+    }
+  }
+}
+
+/// Collect the sensitive placements and assign consecutive grid cell ranges
+void DigiSubdetectorSequence::collect_sensors(PlacedVolume pv, VolumeID vid, VolumeID mask)   {
+  Volume vol = pv.volume();
+  if ( vol.isSensitive() )    {
+    auto key = make_pair(vol->GetShape()->IsA(), m_segmentation);
+    auto is  = m_scanners.find(key);
+    if ( is == m_scanners.end() )   {
+      except("Fatal error in collect_sensors: Invalid cell scanner. vid: %016X",vid);
+    }
+    Sensor s { pv, vid, is->second.get(), m_numCells, is->second->num_cells(pv) };
+    m_numCells += s.count;
+    m_volumeMask |= mask;
+    m_sensorIndex.emplace(vid, m_sensors.size());
+    m_sensors.emplace_back(s);
+    return;
   }
+  for (int idau = 0, ndau = pv->GetNdaughters(); idau < ndau; ++idau) {
+    PlacedVolume p(pv->GetDaughter(idau));
+    const VolIDs& new_ids = p.volIDs();
+    if ( new_ids.empty() )
+      collect_sensors(p, vid, mask);
+    else
+      collect_sensors(p, vid | m_idDesc.encode(new_ids), mask | m_idDesc.get_mask(new_ids));
+  }
+}
+
+/// Access the sensor owning a cell. Null if the cell belongs to no sensor
+const DigiSubdetectorSequence::Sensor* DigiSubdetectorSequence::sensor(CellID cell)  const   {
+  auto is = m_sensorIndex.find(cell & m_volumeMask);
+  return is == m_sensorIndex.end() ? nullptr : &m_sensors[is->second];
 }
 
 void DigiSubdetectorSequence::scan_sensitive(PlacedVolume pv, VolumeID vid, VolumeID mask)   {
@@ -146,8 +220,148 @@ void DigiSubdetectorSequence::process_context(DigiContext& context,
   }
 }
 
+/// Sum the energy deposits of the subdetector per cell
+void DigiSubdetectorSequence::collect_signals(DigiContext& context, map<CellID, double>& signals)  const   {
+  // Prefer the columnar deposits: contiguous memory instead of polymorphic deposits
+  DigiEvent& event = context.event();
+  Key  key(m_mask, m_sensDet.readout().name());
+  auto icol = event.depositColumns.find(key.toLong());
+  if ( icol != event.depositColumns.end() )   {
+    const DigiDepositColumns& cols = *icol->second;
+    for( size_t i = 0, n = cols.size(); i < n; ++i )
+      signals[cols.cellID[i]] += cols.energy[i];
+    return;
+  }
+  auto iter = event.energyDeposits.find(key.toLong());
+  if ( iter != event.energyDeposits.end() )   {
+    for( const auto* dep : *iter->second )
+      signals[dep->cellID()] += dep->deposit();
+  }
+}
+
+/// Sparse scan: invoke the cell handler only for cells with deposits or noise above threshold
+void DigiSubdetectorSequence::process_sparse(DigiContext& context)  const   {
+  if ( m_sensors.empty() ) return;
+  DigiEvent& event = context.event();
+  DigiRandomStream    random(m_seed, event.eventNumber, m_detector.id());
+  DigiRandomStream    signal_random = random.derive(1);
+  DigiRandomGenerator generator;
+  map<CellID, double> signals;
+  size_t num_noise = 0, num_signal = 0, num_lost = 0;
+
+  // Cells with energy deposits: signal plus gaussian noise, zero suppressed
+  collect_signals(context, signals);
+  for( const auto& s : signals )   {
+    const Sensor* sensor = this->sensor(s.first);
+    if ( !sensor )   {
+      ++num_lost;
+      continue;
+    }
+    DigiCellData data;
+    data.placement = sensor->placement;
+    data.volume    = sensor->placement.volume();
+    data.solid     = data.volume.solid();
+    data.cell_id   = s.first;
+    data.signal    = s.second;
+    if ( m_noiseSigma > 0e0 )   {
+      auto engine = signal_random.engine(s.first);
+      generator.engine = std::ref(engine);
+      data.signal += generator.gaussian(0e0, m_noiseSigma);
+    }
+    if ( data.signal > m_threshold )   {
+      ++num_signal;
+      m_cellHandler(context, *sensor->scanner, data);
+    }
+  }
+  if ( num_lost > 0 )   {
+    warning("+++ Event: %8d Sparse scan: %ld cells with deposits belong to no sensor.",
+            event.eventNumber, num_lost);
+  }
+
+  // Cells with noise only: walk the noisy cells with geometric gaps
+  if ( m_noiseSigma > 0e0 )   {
+    DigiSparseNoise noise(m_noiseSigma, m_threshold);
+    auto engine = random.derive(2).engine(0);
+    // Saturate the step: a gap close to UINT64_MAX must not wrap around to a small index
+    auto next = [&noise, &engine, this](std::uint64_t i)  {
+      std::uint64_t gap = noise.gap(engine());
+      return gap >= m_numCells - i - 1 ? m_numCells : i + 1 + gap;
+    };
+    for( std::uint64_t idx = noise.gap(engine()); idx < m_numCells; idx = next(idx) )   {
+      auto is = std::upper_bound(m_sensors.begin(), m_sensors.end(), idx,
+                                 [](std::uint64_t i, const Sensor& s)  { return i < s.first; });
+      const Sensor& sensor = *(--is);
+      DigiCellData data;
+      if ( !sensor.scanner->cell(sensor.placement, sensor.volume_id, idx-sensor.first, data) )
+        continue;
+      if ( signals.find(data.cell_id) != signals.end() )
+        continue;
+      data.signal = noise.tail(engine());
+      ++num_noise;
+      m_cellHandler(context, *sensor.scanner, data);
+    }
+  }
+  debug("+++ Event: %8d Sparse scan: %ld signal cells %ld noise cells of %lld",
+        event.eventNumber, num_signal, num_noise, (long long)m_numCells);
+}
+
+/// Dense scan with signal processors: process the cells of every sensor in batches
+void DigiSubdetectorSequence::process_batches(DigiContext& context)  const   {
+  DigiEvent&          event = context.event();
+  DigiRandomStream    random(m_seed, event.eventNumber, m_detector.id());
+  size_t              batch_size = size_t(std::max(1L, m_batchSize));
+  size_t              num_cells = 0;
+  map<CellID, double> signals;
+  vector<double>      sig(batch_size), val(batch_size);
+  vector<CellID>      ids(batch_size);
+  vector<char>        inside(batch_size);
+
+  collect_signals(context, signals);
+  for( const auto& sensor : m_sensors )   {
+    for( std::uint64_t first = 0; first < sensor.count; first += batch_size )   {
+      size_t len = size_t(std::min(std::uint64_t(batch_size), sensor.count-first));
+      for( size_t i = 0; i < len; ++i )   {
+        DigiCellData data;
+        inside[i] = sensor.scanner->cell(sensor.placement, sensor.volume_id, first+i, data);
+        ids[i]    = data.cell_id;
+        auto is   = inside[i] ? signals.find(data.cell_id) : signals.end();
+        sig[i]    = is == signals.end() ? 0e0 : is->second;
+        val[i]    = sig[i];
+      }
+      // Random numbers are indexed by the grid cell number within the subdetector
+      DigiCellBatch batch(context, random, sensor.first+first, len, sig.data(), val.data());
+      for( const auto* p : m_processors )
+        p->process(batch);
+      for( size_t i = 0; i < len; ++i )   {
+        if ( inside[i] && val[i] > m_threshold )   {
+          DigiCellData data;
+          data.placement = sensor.placement;
+          data.volume    = sensor.placement.volume();
+          data.solid     = data.volume.solid();
+          data.cell_id   = ids[i];
+          data.signal    = val[i];
+          ++num_cells;
+          m_cellHandler(context, *sensor.scanner, data);
+        }
+      }
+    }
+  }
+  debug("+++ Event: %8d Batch processing: %ld cells above threshold of %lld",
+        event.eventNumber, num_cells, (long long)m_numCells);
+}
+
 /// Pre-track action callback
 void DigiSubdetectorSequence::execute(DigiContext& context)  const   {
+  if ( m_sparse )   {
+    process_sparse(context);
+    this->DigiSynchronize::execute(context);
+    return;
+  }
+  if ( m_processors.size() > 0 )   {
+    process_batches(context);
+    this->DigiSynchronize::execute(context);
+    return;
+  }
   for( const auto& d : m_parallelVid )   {
     const Context& c = d.second;
     auto vid = c.detector_id;
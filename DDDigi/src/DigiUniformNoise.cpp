@@ -16,6 +16,9 @@
 #include "DDDigi/DigiRandomGenerator.h"
 #include "DDDigi/DigiUniformNoise.h"
 
+// C/C++ include files
+#include <vector>
+
 using namespace dd4hep::digi;
 
 /// Standard constructor
@@ -36,3 +39,11 @@ DigiUniformNoise::~DigiUniformNoise() {
 double DigiUniformNoise::operator()(DigiCellContext& context)  const  {
   return context.context.randomGenerator().uniform(m_min,m_max);
 }
+
+/// Batch processing: add uniform noise to all cells of the batch
+void DigiUniformNoise::process(DigiCellBatch& batch)  const  {
+  std::vector<double> rndm(batch.size);
+  stream(batch).fill_uniform(batch.first, rndm.data(), batch.size);
+  for( std::size_t i=0; i < batch.size; ++i )
+    batch.values[i] += m_min + (m_max-m_min)*rndm[i];
+}
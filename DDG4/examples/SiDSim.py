@@ -197,6 +197,9 @@ def run():
   seq, act = geant4.setupTracker('SiVertexBarrel')
   seq.adopt(f1)
   act.adopt(f1)
+  # Evaluate particle and energy filters by table lookup and print the rejection statistics
+  act.FoldFilters = True
+  act.FilterStatistics = True
   #
   seq, act = geant4.setupTracker('SiVertexEndcap')
   seq.adopt(f1)
@@ -0,0 +1,129 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import time
+import logging
+import subprocess
+import DDG4
+#
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep simulation example setup DDG4
+
+   Thread scaling of the event input in multi-threaded mode with
+   and without the read-ahead pipeline of the Geant4InputAction.
+
+   Usage:
+     python readAheadMT.py -input <file> [-reader <type>] [-events <number>]
+                           [-threads <n1,n2,...>] [-readahead <depth>] [-compact <file>]
+
+   Every thread count is executed in a separate process.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+
+def setupWorker(geant4, opts):
+  kernel = geant4.kernel()
+  gen = DDG4.GeneratorAction(kernel, "Geant4GeneratorActionInit/GenerationInit")
+  kernel.generatorAction().adopt(gen)
+  # The input action is shared between all workers: the real instance lives in the master
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input", shared=True)
+  kernel.generatorAction().adopt(gen)
+  gen = DDG4.GeneratorAction(kernel, "Geant4InteractionMerger/InteractionMerger")
+  gen.OutputLevel = 4
+  kernel.generatorAction().adopt(gen)
+  gen = DDG4.GeneratorAction(kernel, "Geant4PrimaryHandler/PrimaryHandler")
+  gen.OutputLevel = 4
+  kernel.generatorAction().adopt(gen)
+  return 1
+
+
+def setupMaster(geant4, opts):
+  kernel = geant4.master()
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input")
+  gen.Input = opts['reader'] + '|' + opts['input']
+  gen.ReadAhead = int(opts['readahead'])
+  gen.OutputLevel = 3
+  kernel.generatorAction().adopt(gen)
+  logger.info('#PYTHON: +++ Input %s with read-ahead %d for %d workers',
+              gen.Input, int(opts['readahead']), int(kernel.NumberOfThreads))
+  return 1
+
+
+def execute(opts):
+  kernel = DDG4.Kernel()
+  kernel.loadGeometry(str("file:" + opts['compact']))
+  DDG4.importConstants(kernel.detectorDescription())
+  kernel.NumberOfThreads = int(opts['threads'])
+  kernel.RunManagerType = 'G4MTRunManager'
+  kernel.NumEvents = int(opts['events'])
+  geant4 = DDG4.Geant4(kernel)
+  geant4.setupUI(typ='tcsh', vis=False, macro=None, ui=False)
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4, opts),
+                               master=setupMaster, master_args=(geant4, opts))
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.setupTrackingFieldMT()
+  # The geometry is minimal: the event processing is dominated by the input
+  geant4.setupPhysics('QGSP_BERT')
+  start = time.time()
+  geant4.run()
+  elapsed = time.time() - start
+  logger.info('+++ Threads: %3d Read-ahead: %3d Events: %6d Throughput: %9.2f events/sec',
+              int(opts['threads']), int(opts['readahead']), int(opts['events']),
+              float(opts['events']) / max(elapsed, 1e-9))
+  return 0
+
+
+def run():
+  opts = {'input': None,
+          'reader': 'Geant4EventReaderHepMC',
+          'events': 200,
+          'threads': '1,2,4,8',
+          'readahead': 0,
+          'compact': os.environ['DD4hepExamplesINSTALL'] + '/examples/ClientTests/compact/SiliconBlock.xml',
+          'worker': False}
+  args = sys.argv[1:]
+  i = 0
+  while i < len(args):
+    if args[i] == '-worker':
+      opts['worker'] = True
+    elif args[i][0] == '-' and i + 1 < len(args):
+      opts[args[i][1:]] = args[i + 1]
+      i = i + 1
+    i = i + 1
+  if not opts['input']:
+    logger.error('+++ No input file given. Use: -input <file>')
+    return 1
+  if opts['worker']:
+    return execute(opts)
+
+  result = 0
+  for threads in str(opts['threads']).split(','):
+    cmd = [sys.executable, os.path.abspath(__file__), '-worker', '-threads', threads]
+    for k in ('input', 'reader', 'events', 'readahead', 'compact'):
+      cmd = cmd + ['-' + k, str(opts[k])]
+    logger.info('+++ Executing: %s', ' '.join(cmd))
+    result = result + subprocess.call(cmd)
+  return result
+
+
+if __name__ == "__main__":
+  sys.exit(run())
@@ -0,0 +1,87 @@
+"""
+
+dd4hep simulation example setup using the python configuration
+
+Parse throughput of the HepMC(2) event reader:
+  - All events are read sequentially and the throughput is printed.
+  - The events are then read in reverse order using direct access
+    and compared to the sequential reading.
+
+Usage:
+  python readHEPMCSpeed.py <input-file> [<number of passes>]
+
+@author  M.Frank
+@version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import os
+import time
+import logging
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+
+def read(gen, evtid, prim_vtx, parts):
+  parts.clear()
+  prim_vtx.clear()
+  try:
+    ret = gen.readParticles(evtid, prim_vtx, parts)
+  except Exception:
+    return None
+  if ret != 1:
+    return None
+  result = (len(parts), sum([len(v.out) for v in prim_vtx]))
+  parts.clear()
+  return result
+
+
+def run(input_file, passes):
+  import DDG4
+  from DDG4 import OutputLevel as Output
+  kernel = DDG4.Kernel()
+  kernel.detectorDescription()
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/Input")
+  kernel.generatorAction().adopt(gen)
+  gen.Input = "Geant4EventReaderHepMC|" + input_file
+  gen.OutputLevel = Output.WARNING
+  gen.HaveAbort = False
+  prim_vtx = DDG4.std_vector(str('dd4hep::sim::Geant4Vertex*'))()
+  parts = gen.new_particles()
+
+  events = []
+  num_parts = 0
+  start = time.time()
+  for _ in range(passes):
+    events = []
+    while True:
+      res = read(gen, len(events), prim_vtx, parts)
+      if res is None:
+        break
+      num_parts = num_parts + res[0]
+      events.append(res)
+  elapsed = max(time.time() - start, 1e-9)
+  size = passes * os.path.getsize(input_file) / 1024.0 / 1024.0
+  logger.info('+++ Read %d events with %d particles in %d passes.', len(events), num_parts, passes)
+  logger.info('+++ Throughput: %9.2f events/sec %9.2f particles/sec %8.2f MB/sec',
+              passes * len(events) / elapsed, num_parts / elapsed, size / elapsed)
+
+  # Direct access: read the events in reverse order
+  ok = len(events) > 0
+  for evtid in reversed(range(len(events))):
+    if read(gen, evtid, prim_vtx, parts) != events[evtid]:
+      logger.error('+++ Event %d differs when read using direct access.', evtid)
+      ok = False
+  logger.info('+++ Direct access consistent: %s', 'YES' if ok else 'NO')
+  return 0 if ok else 1
+
+
+if __name__ == "__main__":
+  import sys
+  if len(sys.argv) > 1:
+    num_passes = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+    sys.exit(run(sys.argv[1], num_passes))
+  else:
+    logger.error('No input file given. Try again....')
+    sys.exit(2)  # ENOENT
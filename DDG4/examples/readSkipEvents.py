@@ -0,0 +1,91 @@
+"""
+
+dd4hep simulation example setup using the python configuration
+
+Check that skipping events (property 'Sync', e.g. SkipNEvents of ddsim)
+delivers the same primaries as reading the input sequentially.
+
+Usage:
+  python readSkipEvents.py <reader type> <input-file> [<parameter>=<value> ...]
+
+Example:
+  python readSkipEvents.py Geant4EventReaderHepEvtShort Muons10GeV.HEPEvt
+
+@author  M.Frank
+@version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import logging
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+
+def digest(gen, evtid, prim_vtx, parts):
+  parts.clear()
+  prim_vtx.clear()
+  try:
+    ret = gen.readParticles(evtid, prim_vtx, parts)
+  except Exception:
+    return None
+  if ret != 1:
+    return None
+  result = tuple([(p.pdgID, round(p.psx, 6), round(p.psy, 6), round(p.psz, 6)) for p in parts])
+  parts.clear()
+  return result
+
+
+def reader(kernel, name, input_file, params, sync):
+  import DDG4
+  from DDG4 import OutputLevel as Output
+  gen = DDG4.GeneratorAction(kernel, "Geant4InputAction/" + name)
+  kernel.generatorAction().adopt(gen)
+  gen.Input = input_file
+  gen.Parameters = params
+  gen.Sync = sync
+  gen.OutputLevel = Output.WARNING
+  gen.HaveAbort = False
+  return gen
+
+
+def run(input_file, params):
+  import DDG4
+  kernel = DDG4.Kernel()
+  kernel.detectorDescription()
+  prim_vtx = DDG4.std_vector(str('dd4hep::sim::Geant4Vertex*'))()
+
+  gen = reader(kernel, 'Sequential', input_file, params, 0)
+  parts = gen.new_particles()
+  events = []
+  while True:
+    res = digest(gen, len(events), prim_vtx, parts)
+    if res is None:
+      break
+    events.append(res)
+  logger.info('+++ Read %d events sequentially.', len(events))
+
+  ok = len(events) > 1
+  num_events = len(events)
+  for skip in sorted(set([1, num_events // 3, num_events // 2, num_events - 1])):
+    gen = reader(kernel, 'Skip%d' % (skip,), input_file, params, skip)
+    for evtid in range(num_events - skip):
+      if digest(gen, evtid, prim_vtx, parts) != events[skip + evtid]:
+        logger.error('+++ Skip %d events: event %d differs from sequential reading.', skip, skip + evtid)
+        ok = False
+        break
+    if digest(gen, num_events - skip, prim_vtx, parts) is not None:
+      logger.error('+++ Skip %d events: no end of input after %d events.', skip, num_events)
+      ok = False
+  logger.info('+++ Identical primaries after skipping events: %s', 'YES' if ok else 'NO')
+  return 0 if ok else 1
+
+
+if __name__ == "__main__":
+  import sys
+  if len(sys.argv) > 2:
+    parameters = dict([a.split('=', 1) for a in sys.argv[3:]])
+    sys.exit(run(sys.argv[1] + '|' + sys.argv[2], parameters))
+  else:
+    logger.error('Usage: readSkipEvents.py <reader type> <input-file> [<parameter>=<value> ...]')
+    sys.exit(2)  # ENOENT
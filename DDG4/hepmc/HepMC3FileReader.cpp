@@ -131,11 +131,10 @@ HEPMC3FileReader::readGenEvent(int /*event_number*/, HepMC3::GenEvent& genEvent)
     printout(INFO,"HEPMC3FileReader","Read event from file");
     // Create input event parameters context
     try {
-      Geant4Context* ctx = context();
       EventParameters *parameters = new EventParameters();
       parameters->setEventNumber(genEvent.event_number());
       parameters->ingestParameters(genEvent);
-      ctx->event().addExtension<EventParameters>(parameters);
+      addEventParameters(parameters);
     }
     catch(std::exception &)
     {
@@ -19,6 +19,7 @@
 #include "DD4hep/ComponentProperties.h"
 #include "DDG4/Geant4Context.h"
 #include "DDG4/Geant4Callback.h"
+#include "DDG4/Geant4ActionProfiler.h"
 
 // Geant4 forward declarations
 class G4Run;
@@ -225,6 +226,13 @@ namespace dd4hep {
 	    for (const auto& o : m_v)
 	      (o->*pmf)(a0, a1);
         }
+        /// Instrumented actions: account the time spent in each action to the profiler
+        template <typename R, typename Q, typename... A> void profile(const char* callback, R (Q::*pmf)(A...), A... args) {
+          for (const auto& o : m_v)  {
+            Geant4ActionProfiler::Timer timer(o, callback);
+            (o->*pmf)(args...);
+          }
+        }
         /// CONST filters
         template <typename Q> bool filter(bool (Q::*pmf)() const) const {
           if ( !m_v.empty() )
@@ -274,6 +282,18 @@ namespace dd4hep {
       }
       /// Set or update client for the use in a new thread fiber
       virtual void configureFiber(Geant4Context* thread_context);
+      /// Create a private copy of a shared action for a worker thread
+      /** Shared actions returning a copy are not wrapped with a global lock.
+       *  Instead each worker thread executes its own copy. The copy is created
+       *  before the worker properties are applied. The default returns null:
+       *  the action cannot be copied and all calls are serialized.
+       */
+      virtual Geant4Action* clone(Geant4Context* thread_context)  const;
+      /// Merge the results of a worker copy created by clone() at the end of each run
+      /** The call is protected by a global lock. The results should be transferred,
+       *  i.e. the worker copy should afterwards be reset for the next run.
+       */
+      virtual void merge(Geant4Action& worker_copy);
       /// Access name of the action
       const std::string& name() const {
         return m_name;
@@ -0,0 +1,106 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4ACTIONPROFILER_H
+#define DDG4_GEANT4ACTIONPROFILER_H
+
+// C/C++ include files
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    // Forward declarations
+    class Geant4Action;
+
+    /// Low overhead instrumentation of the callbacks dispatched by the action sequences
+    /**
+     *  If enabled, the action sequences time every callback of their actions.
+     *  The callbacks registered to the sequences are timed as a whole and are
+     *  accounted to the sequence itself.
+     *
+     *  The number of calls and the time spent are accumulated per thread and per
+     *  action name and callback type. At the end of each run the table of the
+     *  calling thread is printed. At termination the summary of all threads is
+     *  printed and optionally the individual calls are written to a file in the
+     *  Chrome trace event format (chrome://tracing, perfetto).
+     *
+     *  Enabled by the kernel properties:
+     *  - ProfileActions:    Enable the instrumentation
+     *  - ProfileTraceFile:  Name of the Chrome trace output file. If empty no trace is recorded
+     *  - ProfileTraceLimit: Maximal number of trace records per thread
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4ActionProfiler  {
+    public:
+      typedef std::chrono::steady_clock clock_t;
+
+      /// Scope timer of a single callback
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Timer  {
+        const Geant4Action*    m_action;
+        const char*            m_callback;
+        clock_t::time_point    m_start;
+      public:
+        /// Initializing constructor: start the timer
+        Timer(const Geant4Action* action, const char* callback)
+          : m_action(action), m_callback(callback), m_start(clock_t::now())  {}
+        /// Default destructor: account the elapsed time
+        ~Timer()  {
+          record(m_action, m_callback, m_start, clock_t::now());
+        }
+      };
+
+    protected:
+      /// Flag to enable the instrumentation
+      static bool s_enabled;
+
+    public:
+      /// Check if the instrumentation is enabled
+      static bool enabled()  {
+        return s_enabled;
+      }
+      /// Enable the instrumentation. Trace records are only kept if trace_limit > 0
+      static void enable(bool value, long trace_limit);
+      /// Account a single callback of an action
+      static void record(const Geant4Action* action, const char* callback,
+                         clock_t::time_point start, clock_t::time_point stop);
+      /// Execute a sequence of callbacks and account the time spent to the owning action
+      template <typename SEQ, typename... A>
+      static void call(const Geant4Action* owner, const char* callback, const SEQ& seq, A... args)  {
+        if ( !seq.empty() )   {
+          Timer timer(owner, callback);
+          seq(args...);
+        }
+      }
+      /// Print the table of the calling thread accumulated during the current run and reset it
+      static void endRun();
+      /// Print the summary of all threads
+      static void printSummary();
+      /// Write the trace records of all threads in the Chrome trace event format
+      static bool writeTrace(const std::string& file_name);
+    };
+  }     /* End namespace sim   */
+}       /* End namespace dd4hep */
+#endif  /* DDG4_GEANT4ACTIONPROFILER_H  */
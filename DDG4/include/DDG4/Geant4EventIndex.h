@@ -0,0 +1,85 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4EVENTINDEX_H
+#define DDG4_GEANT4EVENTINDEX_H
+
+// C/C++ include files
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Byte offset index of the events in a text input file
+    /**
+     *  Used by the text based event readers to move to an event without
+     *  decoding the preceding events. The reader supplies a callback which
+     *  skips exactly one event as cheaply as possible (e.g. line by line).
+     *
+     *  The index is extended on the fly up to the requested event. If an
+     *  index file <input>.idx with a matching tag exists, it is used
+     *  instead. It is only valid if the size and the modification time
+     *  of the input file did not change. Once the end of the input was
+     *  reached, the complete index may be saved to the index file.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4EventIndex  {
+    public:
+      typedef std::streamoff offset_t;
+      /// Callback to skip one event. Returns false if no further event is present
+      typedef std::function<bool(std::istream&)> skipper_t;
+
+    protected:
+      /// Name of the input file
+      std::string           m_input;
+      /// Tag describing the reader configuration the offsets depend on
+      std::string           m_tag;
+      /// Start offsets of the events
+      std::vector<offset_t> m_offsets;
+      /// Flag: the end of the input was reached
+      bool                  m_complete = false;
+
+      /// Signature of the input file: size and modification time
+      bool signature(long& size, long& mtime)  const;
+
+    public:
+      /// Initializing constructor
+      Geant4EventIndex(const std::string& input, const std::string& tag);
+      /// Default destructor
+      ~Geant4EventIndex() = default;
+      /// Name of the index file
+      std::string fileName()  const    {  return m_input + ".idx";  }
+      /// Number of events indexed so far
+      std::size_t size()  const;
+      /// Check if the end of the input was reached
+      bool complete()  const           {  return m_complete;        }
+      /// Load the index file. Returns false if it is missing or does not match the input
+      bool load();
+      /// Save the complete index to the index file
+      bool save()  const;
+      /// Position the stream at the start of an event. Extends the index if necessary
+      bool seek(std::istream& in, int event_number, const skipper_t& skip);
+      /// Index the entire input and save the index file. The stream position is restored
+      bool create(std::istream& in, const skipper_t& skip);
+    };
+  }     /* End namespace sim   */
+}       /* End namespace dd4hep       */
+#endif  /* DDG4_GEANT4EVENTINDEX_H    */
@@ -0,0 +1,129 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4FILTERCHAIN_H
+#define DDG4_GEANT4FILTERCHAIN_H
+
+// C/C++ include files
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Forward declarations
+class G4Step;
+class G4GFlashSpot;
+class G4ParticleDefinition;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    // Forward declarations
+    class Geant4Filter;
+    class Geant4Action;
+
+    /// Particle type and energy deposit requirements of a sensitive detector filter
+    /**
+     *  Filters which only depend on the particle definition and the
+     *  energy deposit describe themselves by these requirements.
+     *  Such filters may then be folded into a Geant4FilterChain.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FilterCuts  {
+    public:
+      /// Accept only these particle types. If empty, all particle types are accepted
+      std::vector<const G4ParticleDefinition*> select;
+      /// Reject these particle types
+      std::vector<const G4ParticleDefinition*> reject;
+      /// Accept only energy deposits above this value
+      double energyDeposit;
+      /// Default constructor: accept everything
+      Geant4FilterCuts();
+    };
+
+    /// Compiled chain of sensitive detector filters
+    /**
+     *  The chain accepts a step if all filters accept it.
+     *
+     *  If folding is enabled, all filters supporting Geant4Filter::fold() are
+     *  evaluated without virtual calls: the particle requirements are combined
+     *  into a lookup table by particle definition and the energy cuts into a
+     *  single threshold. The remaining filters are called afterwards in the
+     *  order they were adopted.
+     *
+     *  For each filter the number of rejected steps is counted. A step is
+     *  accounted to the first filter rejecting it. Folded filters are
+     *  evaluated first: particle type before energy deposit.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FilterChain  {
+    protected:
+      /// Filter entry of the chain
+      struct Entry  {
+        Geant4Filter*    filter   { nullptr };
+        Geant4FilterCuts cuts;
+        bool             folded   { false };
+        mutable long     rejected { 0 };
+      };
+      typedef std::unordered_map<const G4ParticleDefinition*, int> ParticleTable;
+
+      /// Filter entries in the order of adoption
+      std::vector<Entry>          m_entries;
+      /// Indices of the filters which could not be folded
+      std::vector<int>            m_called;
+      /// Lookup table: particle definition -> index of the rejecting entry or -1
+      mutable ParticleTable       m_particles;
+      /// Last particle definition looked up
+      mutable const G4ParticleDefinition* m_lastParticle { nullptr };
+      /// Lookup result of the last particle definition
+      mutable int                 m_lastResult    { -1 };
+      /// Combined energy deposit threshold of the folded filters
+      double                      m_energyCut     { 0e0 };
+      /// Index of the entry with the highest energy deposit threshold or -1
+      int                         m_energyEntry   { -1 };
+      /// Flag if any folded filter requires a particle type check
+      bool                        m_haveParticles { false };
+      /// Number of accept calls
+      mutable long                m_calls         { 0 };
+
+      /// Compute the index of the folded entry rejecting the particle type or -1
+      int particleResult(const G4ParticleDefinition* def)  const;
+      /// Evaluate the chain given the particle type and the energy deposit
+      template <typename T> bool _accept(const T* object, const G4ParticleDefinition* def, double edep)  const;
+
+    public:
+      /// Default constructor
+      Geant4FilterChain() = default;
+      /// Default destructor
+      ~Geant4FilterChain() = default;
+      /// Build the chain from a list of filters. Fold the filters if requested
+      void compile(const std::vector<Geant4Filter*>& filters, bool fold);
+      /// Number of folded filters
+      std::size_t numFolded()  const;
+      /// Check if the step passes all filters
+      bool accept(const G4Step* step)  const;
+      /// GFLASH interface: Check if the spot passes all filters
+      bool accept(const G4GFlashSpot* spot)  const;
+      /// Print the statistics of the rejected steps per filter
+      void printStatistics(const Geant4Action& owner)  const;
+    };
+  }     /* End namespace sim   */
+}       /* End namespace dd4hep */
+#endif  /* DDG4_GEANT4FILTERCHAIN_H  */
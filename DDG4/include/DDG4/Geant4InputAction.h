@@ -44,6 +44,7 @@ namespace dd4hep  {
   namespace sim  {
     
     class Geant4InputAction;
+    class EventParameters;
 
     /// Basic geant4 event reader class. This interface/base-class must be implemented by concrete readers.
     /**
@@ -106,6 +107,8 @@ namespace dd4hep  {
       virtual ~Geant4EventReader();
       /// Get the context (from the input action)
       Geant4Context* context() const;
+      /// Attach the input event parameters to the event being read
+      void addEventParameters(EventParameters* parameters);
       /// Set the input action
       void setInputAction(Geant4InputAction* action);
       /// File name
@@ -118,7 +121,10 @@ namespace dd4hep  {
       /** For pure sequential access, the default implementation
        *  will skip events one by one.
        *  For technologies supporting direct event access the default
-       *  implementation will be empty.
+       *  implementation only sets the current event number.
+       *  Text based readers should use an event offset index
+       *  (see Geant4EventIndex) instead of decoding skipped events.
+       *  readParticles is expected to advance the current event number.
        *
        *  @return
        */
@@ -144,6 +150,12 @@ namespace dd4hep  {
      * Concrete implementation of the Geant4 generator action base class
      * populating Geant4 primaries from Geant4 and HepStd files.
      *
+     * If the property "ReadAhead" is positive, a producer thread reads and
+     * decodes the events ahead into a bounded queue keyed by the event
+     * number. In multi-threaded mode the shared generator action then only
+     * holds its lock to dequeue the next event instead of parsing the file.
+     * The event numbering is identical to the sequential reading.
+     *
      *  \author  P.Kostka (main author)
      *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
      *  \version 1.0
@@ -173,6 +185,20 @@ namespace dd4hep  {
       bool m_abort;
       /// Property: named parameters to configure file readers or input actions
       std::map< std::string, std::string> m_parameters;
+      /// Property: Number of events decoded ahead by the input thread (0: no read-ahead)
+      int m_readAhead;
+      /// Read-ahead pipeline (producer thread and event queue)
+      class Pipeline;
+      std::unique_ptr<Pipeline> m_pipeline;
+
+      /// Create the event reader if not yet present
+      int createReader(int evid);
+      /// Handle the reader status: abort or throw on errors
+      int checkStatus(int evid, int status);
+      /// Dequeue the next event from the read-ahead pipeline
+      int readAheadParticles(int event_number,
+                             Vertices&  vertices,
+                             Particles& particles);
 
     public:
       /// Read an event and return a LCCollectionVec of MCParticles.
@@ -188,6 +214,8 @@ namespace dd4hep  {
       virtual ~Geant4InputAction();
       /// Create particle vector
       Particles* new_particles() const { return new Particles; }
+      /// Attach input event parameters to the current event (or to the read-ahead queue)
+      void addEventParameters(EventParameters* parameters);
       /// Callback to generate primary particles
       virtual void operator()(G4Event* event);
     };
@@ -18,6 +18,7 @@
 
 // C/C++ include files
 #include <map>
+#include <vector>
 #include <typeinfo>
 
 class DD4hep_End_Of_File : public std::exception {
@@ -56,6 +57,7 @@ namespace dd4hep {
       typedef std::map<std::string, Geant4Action*>      GlobalActions;
       typedef std::map<std::string,int>                 ClientOutputLevels;
       typedef std::pair<void*, const std::type_info*>   UserFramework;
+      typedef std::vector<std::pair<Geant4Action*, Geant4Action*> > ActionClones;
 
     protected:
       /// Reference to the run manager
@@ -79,6 +81,8 @@ namespace dd4hep {
       GlobalActions m_globalActions;
       /// Globally registered filters of sensitive detectors
       GlobalActions m_globalFilters;
+      /// Thread private copies of shared actions: (shared action, worker copy)
+      ActionClones  m_actionClones;
       /// Property: Client output levels
       ClientOutputLevels m_clientLevels;
       /// Property: Name of the G4UI command tree
@@ -95,6 +99,12 @@ namespace dd4hep {
       long        m_numEvent = 10;
       /// Property: Output level
       int         m_outputLevel;
+      /// Property: Enable the timing instrumentation of the action sequences
+      bool        m_profileActions = false;
+      /// Property: Name of the Chrome trace file of the instrumentation. If empty no trace is written
+      std::string m_profileTraceFile;
+      /// Property: Maximal number of trace records per thread
+      long        m_profileTraceLimit = 1000000;
 
       /// Property: Running in multi threaded context
       //bool        m_multiThreaded;
@@ -112,6 +122,8 @@ namespace dd4hep {
 
       bool isMaster() const  { return this == m_master; }
       bool isWorker() const  { return this != m_master; }
+      /// Release the thread private copies of shared actions
+      void releaseActionClones();
 
 #ifndef __CINT__
       /// Standard constructor for workers
@@ -240,6 +252,11 @@ namespace dd4hep {
       /// Retrieve filter from repository
       Geant4Action* globalFilter(const std::string& filter_name, bool throw_if_not_present = true);
 
+      /// Register the thread private copy of a shared action. Results are merged at the end of each run
+      Geant4Kernel& registerActionClone(Geant4Action* shared_action, Geant4Action* worker_copy);
+      /// Merge the results of all thread private copies into the shared actions
+      void mergeActionClones();
+
       /// Access phase by name
       Geant4ActionPhase* getPhase(const std::string& name);
 
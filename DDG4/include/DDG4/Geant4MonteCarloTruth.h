@@ -55,6 +55,8 @@ namespace dd4hep {
       virtual void mark(const G4Step* step) = 0;
       /// Store a track produced in a step to be kept for later MC truth analysis
       virtual void mark(const G4Step* step, int reason) = 0;
+      /// Check if a new track may be required by the MC truth record. If yes, it may not be discarded before tracking
+      virtual bool requiresTrack(const G4Track* track)  const;
     };
 
     /// Void implementation of the Monte-Carlo thruth handler doing nothing at all.
@@ -77,6 +79,8 @@ namespace dd4hep {
       virtual void mark(const G4Step* step);
       /// Store a track produced in a step to be kept for later MC truth analysis
       virtual void mark(const G4Step* step, int reason);
+      /// No MC truth record: no track is required
+      virtual bool requiresTrack(const G4Track* track)  const;
     };
 
   }    // End namespace sim
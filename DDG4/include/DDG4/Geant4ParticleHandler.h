@@ -165,6 +165,10 @@ namespace dd4hep {
       virtual void mark(const G4Step* step);
       /// Store a track produced in a step to be kept for later MC truth analysis
       virtual void mark(const G4Step* step, int reason);
+      /// Check if a new track may be required by the MC truth record. If yes, it may not be discarded before tracking
+      /** The user particle handler is consulted with Geant4UserParticleHandler::requiresTrack().
+       */
+      virtual bool requiresTrack(const G4Track* track)  const;
 
       /// Default callback to be answered if the particle should be kept if NO user handler is installed
       static bool defaultKeepParticle(Particle& particle);
@@ -17,9 +17,11 @@
 // Framework include files
 #include "DD4hep/Detector.h"
 #include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4FilterChain.h"
 #include "DDG4/Geant4HitCollection.h"
 
 // C/C++ include files
+#include <memory>
 #include <vector>
 
 // Forward declarations
@@ -105,6 +107,11 @@ namespace dd4hep {
        *  GFLASH interface is not implemented.
        */
       virtual bool operator()(const G4GFlashSpot* step) const;
+      /// Describe the filter by particle type and energy deposit requirements.
+      /** Return true if the filter is fully described by the cuts and may be
+       *  folded into a compiled filter chain. The default returns false.
+       */
+      virtual bool fold(Geant4FilterCuts& cuts) const;
     };
 
     /// The base class for Geant4 sensitive detector actions implemented by users
@@ -147,6 +154,12 @@ namespace dd4hep {
       Segmentation         m_segmentation     {  };
       /// The list of sensitive detector filter objects
       Actors<Geant4Filter> m_filters;
+      /// Property: Fold particle type and energy deposit filters into a lookup table
+      bool                 m_foldFilters      { false };
+      /// Property: Print the number of steps rejected by each filter at finalization
+      bool                 m_filterStatistics { false };
+      /// Compiled filter chain. Built on first use if filters are folded or statistics requested
+      mutable std::unique_ptr<Geant4FilterChain> m_filterChain;
 
       /// Define standard assignments and constructors
       DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4Sensitive);
@@ -223,6 +236,9 @@ namespace dd4hep {
       /// Add an actor responding to all callbacks to the sequence front. Sequence takes ownership.
       void adoptFilter_front(Geant4Action* filter);
 
+      /// Access the compiled filter chain. Built on first use
+      const Geant4FilterChain& filterChain() const;
+
       /// Callback before hit processing starts. Invoke all filters.
       /** Return false if any filter returns false
        */
@@ -330,6 +346,12 @@ namespace dd4hep {
       Actors<Geant4Sensitive> m_actors;
       /// The list of sensitive detector filter objects
       Actors<Geant4Filter>    m_filters;
+      /// Property: Fold particle type and energy deposit filters into a lookup table
+      bool                    m_foldFilters      { false };
+      /// Property: Print the number of steps rejected by each filter at finalization
+      bool                    m_filterStatistics { false };
+      /// Compiled filter chain. Built on first use if filters are folded or statistics requested
+      mutable std::unique_ptr<Geant4FilterChain> m_filterChain;
 
       /// Hit collection creators
       HitCollections m_collections;
@@ -413,6 +435,9 @@ namespace dd4hep {
       /// Add an actor responding to all callbacks. Sequence takes ownership.
       void adoptFilter(Geant4Action* filter);
 
+      /// Access the compiled filter chain. Built on first use
+      const Geant4FilterChain& filterChain() const;
+
       /// Callback before hit processing starts. Invoke all filters.
       bool accept(const G4Step* step) const;
 
@@ -16,6 +16,13 @@
 // Framework include files
 #include "DDG4/Geant4Action.h"
 
+// Geant4 include files
+#include "G4ClassificationOfNewTrack.hh"
+
+// Forward declarations
+class G4Track;
+class G4StackManager;
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -27,6 +34,29 @@ namespace dd4hep {
     class Geant4SharedStackingAction;
     class Geant4StackingActionSequence;
 
+    /// Flag to indicate that a stacking action does not classify the track
+    enum { NoTrackClassification = 0xFEED };
+
+    /// Result of the classification of a new track by a stacking action
+    /**
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class TrackClassification  {
+    public:
+      /// Geant4 stack the track should be pushed to
+      G4ClassificationOfNewTrack value  { fUrgent };
+      /// Classification type. NoTrackClassification if the action does not classify the track
+      int                        type   { NoTrackClassification };
+      /// Default constructor: no classification
+      TrackClassification() = default;
+      /// Initializing constructor
+      TrackClassification(G4ClassificationOfNewTrack val) : value(val), type(val)  {}
+      /// Check if the action classified the track
+      bool isValid()  const   {  return type != NoTrackClassification;  }
+    };
+
     /// Concrete implementation of the Geant4 stacking action base class
     /**
      *  \author  M.Frank
@@ -50,6 +80,10 @@ namespace dd4hep {
       /// Preparation callback
       virtual void prepare() {
       }
+      /// Classify a new track. The default implementation does not classify the track
+      virtual TrackClassification classifyNewTrack(G4StackManager* /* mgr */, const G4Track* /* track */)  {
+        return TrackClassification();
+      }
     };
 
     /// Implementation of the Geant4 shared stacking action
@@ -84,6 +118,8 @@ namespace dd4hep {
       virtual void newStage();
       /// Preparation callback
       virtual void prepare();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(G4StackManager* mgr, const G4Track* track);
     };
 
     /// Concrete implementation of the Geant4 stacking action sequence
@@ -92,6 +128,14 @@ namespace dd4hep {
      * to all registered Geant4StackingAction members and all
      * registered callbacks.
      *
+     * New tracks are classified by all actors. If several actors classify
+     * a track, the precedence is:
+     * fKill before fPostpone before fUrgent before fWaiting.
+     * An explicit fUrgent classification hence prevents other actors from
+     * deferring the track to a waiting stack, but not from killing or
+     * postponing it.
+     * If no actor classifies the track, it is pushed to the urgent stack.
+     *
      * Note Multi-Threading issue:
      * Neither callbacks not the action list is protected against multiple 
      * threads calling the Geant4 callbacks!
@@ -137,6 +181,8 @@ namespace dd4hep {
       virtual void newStage();
       /// Preparation callback
       virtual void prepare();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(G4StackManager* mgr, const G4Track* track);
     };
 
   }    // End namespace sim
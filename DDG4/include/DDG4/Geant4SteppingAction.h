@@ -60,6 +60,8 @@ namespace dd4hep {
      *
      * Shared action should be 'fast'. The global lock otherwise
      * inhibits the efficient use of the multiple threads.
+     * Actions implementing Geant4Action::clone() are not wrapped:
+     * each worker thread then executes a private copy.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -139,11 +139,18 @@ namespace dd4hep {
        *  \ingroup DD4HEP_SIMULATION
        */
       class Geant4TestStepAction: public Geant4SteppingAction, public Geant4TestBase {
+      protected:
+        /// Number of steps seen
+        long m_numSteps = 0;
       public:
         /// Standard constructor with initializing arguments
         Geant4TestStepAction(Geant4Context* c, const std::string& n);
         /// Default destructor
         virtual ~Geant4TestStepAction();
+        /// Create a private copy for a worker thread if used as shared action
+        virtual Geant4Action* clone(Geant4Context* thread_context)  const  override;
+        /// Merge the step count of a worker copy
+        virtual void merge(Geant4Action& worker_copy)  override;
         /// User stepping callback
         void operator()(const G4Step*, G4SteppingManager*);
       };
@@ -130,6 +130,16 @@ namespace dd4hep {
        *  The default implementation is empty.
        */
       virtual void combine(Particle& to_be_deleted, Particle& remaining_parent);
+
+      /// Callback to be answered if a new track may be required by the MC truth record
+      /** Called by Geant4ParticleHandler::requiresTrack() when stacking policies
+       *  want to discard a track before it is tracked. Return true if the
+       *  particle of this track may be kept by keepParticle() or end().
+       *  Only the track at creation time is known: decisions depending on the
+       *  track history or the hits created cannot be anticipated.
+       *  The default implementation returns false: no additional tracks are required.
+       */
+      virtual bool requiresTrack(const G4Track* track)  const;
     };
   }    // End namespace sim
 }      // End namespace dd4hep
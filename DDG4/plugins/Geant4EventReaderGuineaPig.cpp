@@ -24,6 +24,7 @@
 
 // Framework include files
 #include "DDG4/Geant4InputAction.h"
+#include "DDG4/Geant4EventIndex.h"
 
 // C/C++ include files
 #include <fstream>
@@ -41,6 +42,10 @@ namespace dd4hep {
      *  Reader for ascii files with e+e- pairs created from GuineaPig.
      *  Will read complete the file into one event - unless skip N events is
      *  called, then N particles are compiled into one event.
+     *
+     *  Events are skipped using the byte offset index of the input file
+     *  (see Geant4EventIndex). The reader parameter "WriteIndex" creates
+     *  the index file of the input.
      * 
      *  \author  F.Gaede, DESY
      *  \author  A. Perez Perez IPHC
@@ -52,6 +57,11 @@ namespace dd4hep {
     protected:
       std::ifstream m_input;
       int m_part_num ;
+      /// Event offset index of the input file. Depends on the number of particles per event
+      Geant4EventIndex m_index;
+
+      /// Skip one event: the particle records are not decoded
+      bool skip(std::istream& in)  const;
       
     public:
       /// Initializing constructor
@@ -62,8 +72,10 @@ namespace dd4hep {
       virtual EventReaderStatus readParticles(int event_number,
                                               Vertices& vertices,
                                               std::vector<Particle*>& particles) override ;
+      /// Move to the indicated event number using the event index
       virtual EventReaderStatus moveToEvent(int event_number) override ;
-      virtual EventReaderStatus skipEvent() override  { return EVENT_READER_OK; }
+      /// Skip event using the event index
+      virtual EventReaderStatus skipEvent() override  { return moveToEvent(m_currEvent+1); }
       virtual EventReaderStatus setParameters( std::map< std::string, std::string > & parameters ) override ;
     };
   }     /* End namespace sim   */
@@ -78,6 +90,7 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <limits>
 
 using namespace std;
 using namespace dd4hep::sim;
@@ -88,7 +101,7 @@ DECLARE_GEANT4_EVENT_READER(Geant4EventReaderGuineaPig)
 
 /// Initializing constructor
 Geant4EventReaderGuineaPig::Geant4EventReaderGuineaPig(const string& nam)
-: Geant4EventReader(nam), m_input(), m_part_num(-1) 
+: Geant4EventReader(nam), m_input(), m_part_num(-1), m_index(nam, "")
 {
   // Now open the input file:
   m_input.open(nam.c_str(),ifstream::in);
@@ -108,53 +121,66 @@ Geant4EventReaderGuineaPig::~Geant4EventReaderGuineaPig()    {
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderGuineaPig::setParameters( std::map< std::string, std::string > & parameters ) {
 
+  bool write_index = false;
   _getParameterValue( parameters, "ParticlesPerEvent", m_part_num, -1);
+  _getParameterValue( parameters, "WriteIndex", write_index, false);
   
   if( m_part_num <  0 ) 
     printout(INFO,"EventReader","--- Will read all particles in pairs file into one event " );
   else
     printout(INFO,"EventReader","--- Will read %d particles per event from pairs file ", m_part_num );
-    
+
+  if( m_part_num > 0 ) {
+    m_index = Geant4EventIndex(m_name, "Geant4EventReaderGuineaPig ParticlesPerEvent="+to_string(m_part_num));
+    if( m_index.load() ) {
+      printout(INFO,"EventReader","--- Using event index %s with %ld events ",
+               m_index.fileName().c_str(), m_index.size() );
+    }
+    else if( write_index ) {
+      auto skipper = [this](istream& in) { return this->skip(in); };
+      if( !m_index.create(m_input, skipper) ) {
+        printout(ERROR,"EventReader","--- Failed to write event index %s", m_index.fileName().c_str() );
+        return EVENT_READER_IO_ERROR;
+      }
+      printout(INFO,"EventReader","--- Wrote event index %s with %ld events ",
+               m_index.fileName().c_str(), m_index.size() );
+    }
+  }
   return EVENT_READER_OK;
 }
 
+/// Skip one event: the particle records are not decoded
+bool Geant4EventReaderGuineaPig::skip(istream& in)  const {
+  for( int counter = 0; counter < m_part_num ; ++counter ){
+    if( in.peek() == istream::traits_type::eof() )
+      return counter > 0 ;
+    in.ignore(numeric_limits<streamsize>::max(), '\n');
+  }
+  return true;
+}
+
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderGuineaPig::moveToEvent(int event_number) {
   
   printout(DEBUG,"EventReader"," move to event_number: %d , m_currEvent %d",
            event_number,m_currEvent ) ;
   
-  if( m_currEvent == 0 && event_number > 0 ){
-
-    if( m_part_num <  1 ) {
-
-      printout(ERROR,"EventReader","--- Cannot skip to event %d in GuineaPig file without parameter 'ParticlesPerEvent' being set ! ", event_number );
+  if( m_currEvent == event_number )
+    return EVENT_READER_OK;
 
-      return EVENT_READER_IO_ERROR;
-
-    } else {
-
-
-      unsigned nSkipParticles = m_part_num * event_number ;
-
-      printout(INFO,"EventReader","--- Will skip first %d events, i.e. %d particles ", event_number , nSkipParticles  );
+  if( m_part_num <  1 ) {
+    printout(ERROR,"EventReader","--- Cannot skip to event %d in GuineaPig file without parameter 'ParticlesPerEvent' being set ! ", event_number );
+    return EVENT_READER_IO_ERROR;
+  }
 
-      // First check the input file status
-      if ( !m_input.good() || m_input.eof() )   {
-        return EVENT_READER_IO_ERROR;
-      }
+  printout(INFO,"EventReader","--- Will skip to event %d, i.e. particle %ld ",
+           event_number , long(m_part_num) * event_number );
 
-      for (unsigned i = 0; i<nSkipParticles; ++i){
-        if (m_input.ignore(numeric_limits<streamsize>::max(), m_input.widen('\n'))){
-          //just skipping the line
-        }
-        else
-          return EVENT_READER_IO_ERROR ;
-      }
-    }
-  }
-  // else: nothing to do ...
+  auto skipper = [this](istream& in) { return this->skip(in); };
+  if( !m_index.seek(m_input, event_number, skipper) )
+    return EVENT_READER_EOF;
 
+  m_currEvent = event_number;
   return EVENT_READER_OK;
 }
 
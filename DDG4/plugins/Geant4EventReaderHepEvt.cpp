@@ -24,6 +24,7 @@
 
 // Framework include files
 #include "DDG4/Geant4InputAction.h"
+#include "DDG4/Geant4EventIndex.h"
 
 // C/C++ include files
 #include <fstream>
@@ -39,6 +40,10 @@ namespace dd4hep {
      * Class to populate Geant4 primary particles and vertices from a
      * file in HEPEvt format (ASCII)
      *
+     * Events are skipped using the byte offset index of the input file
+     * (see Geant4EventIndex). The reader parameter "WriteIndex" creates
+     * the index file of the input.
+     *
      *  \author  P.Kostka (main author)
      *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
      *  \version 1.0
@@ -47,8 +52,10 @@ namespace dd4hep {
     class Geant4EventReaderHepEvt : public Geant4EventReader  {
 
     protected:
-      std::ifstream m_input;
-      int           m_format;
+      std::ifstream    m_input;
+      int              m_format;
+      /// Event offset index of the input file
+      Geant4EventIndex m_index;
 
     public:
       /// Initializing constructor
@@ -59,8 +66,12 @@ namespace dd4hep {
       virtual EventReaderStatus readParticles(int event_number,
                                               Vertices& vertices,
                                               std::vector<Particle*>& particles);
+      /// Move to the indicated event number using the event index
       virtual EventReaderStatus moveToEvent(int event_number);
-      virtual EventReaderStatus skipEvent() { return EVENT_READER_OK; }
+      /// Skip event using the event index
+      virtual EventReaderStatus skipEvent()  {  return moveToEvent(m_currEvent+1);  }
+      /// Pass parameters to the event reader object
+      virtual EventReaderStatus setParameters(std::map< std::string, std::string > & parameters);
     };
   }     /* End namespace sim   */
 }       /* End namespace dd4hep       */
@@ -87,6 +98,7 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <limits>
 
 using namespace std;
 using namespace dd4hep::sim;
@@ -97,6 +109,17 @@ typedef dd4hep::detail::ReferenceBitMask<int> PropertyMask;
 
 // Local declarations in anaonymous namespace
 namespace {
+  /// Skip one event: the particle records are not decoded
+  bool skip_event(istream& in)   {
+    unsigned NHEP(0);
+    in >> NHEP;
+    if ( !in.good() ) return false;
+    // The remainder of the header line and one line per particle
+    for( unsigned i = 0; i <= NHEP; ++i )
+      in.ignore(numeric_limits<streamsize>::max(), '\n');
+    return !in.fail();
+  }
+
   class Geant4EventReaderHepEvtShort : public Geant4EventReaderHepEvt  {
   public:
     /// Initializing constructor
@@ -121,7 +144,7 @@ DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepEvtLong)
 
 /// Initializing constructor
 Geant4EventReaderHepEvt::Geant4EventReaderHepEvt(const string& nam, int format)
-: Geant4EventReader(nam), m_input(), m_format(format)
+: Geant4EventReader(nam), m_input(), m_format(format), m_index(nam, "Geant4EventReaderHepEvt")
 {
   // Now open the input file:
   m_input.open(nam.c_str(),ifstream::in);
@@ -130,6 +153,10 @@ Geant4EventReaderHepEvt::Geant4EventReaderHepEvt(const string& nam, int format)
       " Error:"+string(strerror(errno));
     throw runtime_error(err);
   }
+  if ( m_index.load() )  {
+    printout(INFO,"EventReaderHepEvt","+++ Using event index %s with %ld events.",
+             m_index.fileName().c_str(), m_index.size());
+  }
 }
 
 /// Default destructor
@@ -137,24 +164,35 @@ Geant4EventReaderHepEvt::~Geant4EventReaderHepEvt()    {
   m_input.close();
 }
 
-/// skipEvents if required
+/// Pass parameters to the event reader object
 Geant4EventReader::EventReaderStatus
-Geant4EventReaderHepEvt::moveToEvent(int event_number) {
-  if( m_currEvent == 0 && event_number != 0 ) {
-    printout(INFO,"EventReaderHepEvt::moveToEvent","Skipping the first %d events ", event_number );
-    printout(INFO,"EventReaderHepEvt::moveToEvent","Event number before skipping: %d", m_currEvent );
-    while ( m_currEvent < event_number ) {
-      std::vector<Particle*> particles;
-      Vertices vertices ;
-      EventReaderStatus sc = readParticles(m_currEvent,vertices,particles);
-      for_each(vertices.begin(),vertices.end(),detail::deleteObject<Vertex>);
-      for_each(particles.begin(),particles.end(),detail::deleteObject<Particle>);
-      if ( sc != EVENT_READER_OK ) return sc;
-      //Current event is increased in readParticles already!
-      // ++m_currEvent;
+Geant4EventReaderHepEvt::setParameters( std::map< std::string, std::string > & parameters ) {
+  bool write_index = false;
+  _getParameterValue( parameters, "WriteIndex", write_index, false);
+  if ( write_index && !m_index.complete() )  {
+    if ( !m_index.create(m_input, skip_event) )  {
+      printout(ERROR,"EventReaderHepEvt","+++ Failed to write event index %s",
+               m_index.fileName().c_str());
+      return EVENT_READER_IO_ERROR;
     }
+    printout(INFO,"EventReaderHepEvt","+++ Wrote event index %s with %ld events.",
+             m_index.fileName().c_str(), m_index.size());
+  }
+  return EVENT_READER_OK;
+}
+
+/// Move to the indicated event number using the event index
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepEvt::moveToEvent(int event_number) {
+  if ( m_currEvent == event_number )  {
+    return EVENT_READER_OK;
+  }
+  printout(INFO,"EventReaderHepEvt::moveToEvent","Current event:%d Moving to event %d",
+           m_currEvent, event_number );
+  if ( !m_index.seek(m_input, event_number, skip_event) )  {
+    return EVENT_READER_EOF;
   }
-  printout(INFO,"EventReaderHepEvt::moveToEvent","Event number after skipping: %d", m_currEvent );
+  m_currEvent = event_number;
   return EVENT_READER_OK;
 }
 
@@ -1,5 +1,5 @@
 //==========================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------------
 // Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
 // All rights reserved.
@@ -23,10 +23,10 @@
 
 
 // Framework include files
-#include "DDG4/IoStreams.h"
 #include "DDG4/Geant4InputAction.h"
 
 // C/C++ include files
+#include <string>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -45,6 +45,11 @@ namespace dd4hep {
      *  Class to populate Geant4 primary particles and vertices from a
      *  file in HepMC format (ASCII)
      *
+     *  The file is mapped into memory and parsed in place without
+     *  iostream tokenization. When opening the file the offsets of all
+     *  events are indexed: the reader supports direct access and
+     *  moving to or skipping events does not parse the event data.
+     *
      *  For details also see:
      *  http://hepmc.web.cern.ch/hepmc/ReaderAsciiHepMC2_8cc_source.html
      *
@@ -54,11 +59,18 @@ namespace dd4hep {
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4EventReaderHepMC : public Geant4EventReader  {
-      typedef boost::iostreams::stream<dd4hep_file_source<int> > in_stream;
-      //typedef boost::iostreams::stream<dd4hep_file_source<TFile*> > in_stream;
       typedef HepMC::EventStream EventStream;
     protected:
-      in_stream    m_input;
+      /// Start of the input data
+      const char*  m_data;
+      /// Size of the input data
+      std::size_t  m_size;
+      /// Flag if the input data are memory mapped (otherwise m_copy holds the data)
+      bool         m_mapped;
+      /// Copy of the input data if the file cannot be parsed in place
+      std::string  m_copy;
+      /// Index of the next event entry to be read
+      std::size_t  m_position;
       EventStream* m_events;
     public:
       /// Initializing constructor
@@ -69,15 +81,17 @@ namespace dd4hep {
       virtual EventReaderStatus readParticles(int event_number,
                                               Vertices& vertices,
                                               std::vector<Particle*>& particles)  override;
+      /// Move to the indicated event number using the event index
       virtual EventReaderStatus moveToEvent(int event_number)  override;
-      virtual EventReaderStatus skipEvent() override { return EVENT_READER_OK; }
+      /// Skip event using the event index
+      virtual EventReaderStatus skipEvent() override;
 
     };
   }     /* End namespace sim   */
 }       /* End namespace dd4hep       */
 
 //====================================================================
-//  AIDA Detector description implementation 
+//  AIDA Detector description implementation
 //--------------------------------------------------------------------
 //
 //====================================================================
@@ -92,7 +106,13 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <cstring>
+#include <cstdlib>
 #include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace dd4hep::sim;
@@ -130,7 +150,7 @@ namespace dd4hep {
         vector<float>      weights;
         vector<long>       random;
         /// Default constructor
-        EventHeader() : id(0), num_vertices(0), bp1(0), bp2(0), 
+        EventHeader() : id(0), num_vertices(0), bp1(0), bp2(0),
                         signal_process_id(0), signal_process_vertex(0),
                         scale(0.0), alpha_qcd(0.0), alpha_qed(0.0), weights(), random() {}
       };
@@ -138,6 +158,40 @@ namespace dd4hep {
       /// The known_io enum is used to track which type of input is being read
       enum known_io { gen=1, ascii, extascii, ascii_pdt, extascii_pdt };
 
+      /// Tokenizer of one line of the memory mapped input
+      /*
+       *  Numbers are converted in place. The input buffer must be terminated
+       *  by a newline: the conversion of floating point numbers never passes it.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Line  {
+      public:
+        const char* ptr;
+        const char* end;
+        /// Initializing constructor
+        Line(const char* p, const char* e) : ptr(p), end(e)  {}
+        /// Skip blanks. Returns false if there is no further token
+        bool skip()  {
+          while ( ptr < end && (*ptr == ' ' || *ptr == '\t' || *ptr == '\r') ) ++ptr;
+          return ptr < end;
+        }
+        /// Convert the next token to an integer
+        bool get(long& value);
+        /// Convert the next token to an integer
+        bool get(int& value)    {  long v = 0; if ( !get(v) ) return false; value = int(v); return true;    }
+        /// Convert the next token to a floating point number
+        bool get(double& value);
+        /// Convert the next token to a floating point number
+        bool get(float& value)  {  double v = 0; if ( !get(v) ) return false; value = float(v); return true; }
+        /// Access the next blank separated word
+        bool get(string& value);
+        /// Access the remainder of the line
+        string str()  const     {  return string(ptr, end);  }
+      };
+
       /// HepMC EventStream class used internally by the Geant4EventReaderHepMC plugin
       /*
        *  \author  P.Kostka (main author)
@@ -149,8 +203,16 @@ namespace dd4hep {
       public:
         typedef std::map<int,Geant4Vertex*> Vertices;
         typedef std::map<int,Geant4Particle*> Particles;
+        /// Event index entry: data offset and the input state valid at the start of the event
+        struct Entry  {
+          size_t offset;
+          int    io_type;
+          double mom_unit, pos_unit;
+        };
 
-        istream& instream;
+        const char* begin;
+        const char* end;
+        vector<Entry> index;
 
         // io information
         string key;
@@ -162,12 +224,12 @@ namespace dd4hep {
         Vertices m_vertices;
         Particles m_particles;
 
-        /// Default constructor
-        EventStream(istream& in) : instream(in), mom_unit(0.0), pos_unit(0.0),
-                                   io_type(0), xsection(0.0), xsection_err(0.0)
-        { use_default_units();                       }
-        /// Check if data stream is in proper state and has data
-        bool ok()  const;
+        /// Initializing constructor. The data are indexed
+        EventStream(const char* b, const char* e) : begin(b), end(e), mom_unit(0.0), pos_unit(0.0),
+                                                    io_type(0), xsection(0.0), xsection_err(0.0)
+        { use_default_units(); build_index();       }
+        /// Number of events in the input
+        size_t size()  const   {  return index.size(); }
         Geant4Vertex* vertex(int i);
         Particles& particles() { return m_particles; }
         Vertices&  vertices()  { return m_vertices;  }
@@ -175,20 +237,25 @@ namespace dd4hep {
         { io_type = typ;    key = k;                 }
         void use_default_units()
         { mom_unit = CLHEP::MeV;   pos_unit = CLHEP::mm;           }
-        bool read();
+        /// Build the event index with one pass over the data
+        void build_index();
+        /// Read the event entry 'which'. Malformed events are skipped: 'which' is updated
+        bool read(size_t& which);
+        /// Read the event starting at the data pointer. Return: 1 success, 0 skip, -1 fatal
+        int  read_event(const char* ptr);
         void clear();
       };
 
-      char get_input(istream& is, istringstream& iline);
-      int read_until_event_end(istream & is);
-      int read_weight_names(EventStream &, istringstream& iline);
-      int read_particle(EventStream &info, istringstream& iline, Geant4Particle * p);
-      int read_vertex(EventStream &info, istream& is, istringstream & iline);
-      int read_event_header(EventStream &info, istringstream & input, EventHeader& header);
-      int read_cross_section(EventStream &info, istringstream & input);
-      int read_units(EventStream &info, istringstream & input);
-      int read_heavy_ion(EventStream &, istringstream & input);
-      int read_pdf(EventStream &, istringstream & input);
+      const char* line_end(const char* ptr, const char* end);
+      int read_weight_names(EventStream &, Line& iline);
+      int read_particle(EventStream &info, Line& iline, Geant4Particle * p);
+      int read_vertex(EventStream &info, const char*& ptr, Line & iline);
+      int read_event_header(EventStream &info, Line & input, EventHeader& header);
+      int read_cross_section(EventStream &info, Line & input);
+      int read_units(EventStream &info, Line & input);
+      int read_heavy_ion(EventStream &, Line & input);
+      int read_pdf(EventStream &, Line & input);
+      int io_key(const string& key_value, bool& start);
       Geant4Vertex* vertex(EventStream& info, int i);
       void fix_particles(EventStream &info);
     }
@@ -201,39 +268,79 @@ namespace dd4hep {
 
 /// Initializing constructor
 Geant4EventReaderHepMC::Geant4EventReaderHepMC(const string& nam)
-  : Geant4EventReader(nam), m_input(), m_events(0)
+  : Geant4EventReader(nam), m_data(0), m_size(0), m_mapped(false), m_position(0), m_events(0)
 {
-  // Now open the input file:
-  m_input.open(nam.c_str(),BOOST_IOS::in|BOOST_IOS::binary);
-  if ( not m_input.is_open() )   {
+  struct stat st;
+  // Now open and map the input file:
+  int fd = ::open(nam.c_str(), O_RDONLY);
+  if ( fd < 0 || ::fstat(fd, &st) != 0 )  {
+    int err = errno;
+    if ( fd >= 0 ) ::close(fd);
     except("Geant4EventReaderHepMC","+++ Failed to open input stream: %s Error:%s.",
-           nam.c_str(), ::strerror(errno));
+           nam.c_str(), ::strerror(err));
   }
-  m_events = new HepMC::EventStream(m_input);
+  m_size = size_t(st.st_size);
+  if ( m_size > 0 )  {
+    void* ptr = ::mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( ptr == MAP_FAILED )  {
+      int err = errno;
+      ::close(fd);
+      except("Geant4EventReaderHepMC","+++ Failed to map input stream: %s Error:%s.",
+             nam.c_str(), ::strerror(err));
+    }
+    m_data   = (const char*)ptr;
+    m_mapped = true;
+  }
+  ::close(fd);
+  // The in-place conversion relies on a terminating newline.
+  // Only a file which does not end with one needs to be copied.
+  if ( m_size == 0 || m_data[m_size-1] != '\n' )   {
+    m_copy.reserve(m_size+1);
+    m_copy.assign(m_data ? m_data : "", m_size);
+    m_copy += '\n';
+    if ( m_mapped ) ::munmap((void*)m_data, m_size);
+    m_mapped = false;
+    m_data   = m_copy.data();
+    m_size   = m_copy.size();
+  }
+  m_events = new HepMC::EventStream(m_data, m_data+m_size);
+  m_directAccess = true;
+  printout(DEBUG,"EventReaderHepMC","+++ Indexed %ld events in %s [%ld bytes]",
+           m_events->size(), nam.c_str(), m_size);
 }
 
 /// Default destructor
 Geant4EventReaderHepMC::~Geant4EventReaderHepMC()    {
   delete m_events;
   m_events = 0;
-  m_input.close();
+  if ( m_mapped ) ::munmap((void*)m_data, m_size);
+  m_data = 0;
 }
 
-/// skipEvents if required
+/// Move to the indicated event number using the event index
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderHepMC::moveToEvent(int event_number) {
-  if( m_currEvent < event_number && event_number != 0 ) {
-    printout(INFO,"EventReaderHepMC::moveToEvent","Current event:%d Skipping the next %d events",
+  if ( event_number < 0 )  {
+    return EVENT_READER_ERROR;
+  }
+  // Sequential access continues behind skipped malformed events
+  if ( m_currEvent != event_number )  {
+    printout(DEBUG,"EventReaderHepMC::moveToEvent","Current event:%d Moving to event %d",
              m_currEvent, event_number);
-    while ( m_currEvent < event_number ) {
-      if ( not m_events->read() ) return EVENT_READER_ERROR;
-      ++m_currEvent;
-    }
+    m_position  = size_t(event_number);
+    m_currEvent = event_number;
   }
   printout(DEBUG,"EventReaderHepMC::moveToEvent","Current event number: %d",m_currEvent);
   return EVENT_READER_OK;
 }
 
+/// Skip event using the event index
+Geant4EventReader::EventReaderStatus Geant4EventReaderHepMC::skipEvent()  {
+  ++m_position;
+  ++m_currEvent;
+  return m_position <= m_events->size() ? EVENT_READER_OK : EVENT_READER_EOF;
+}
+
 /// Read an event and fill a vector of MCParticles.
 Geant4EventReaderHepMC::EventReaderStatus
 Geant4EventReaderHepMC::readParticles(int /* ev_id */,
@@ -248,12 +355,8 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
   primary_vertex->y = 0;
   primary_vertex->z = 0;
 
-  if ( !m_events->ok() )  {
-    vertices.clear();
-    output.clear();
-    return EVENT_READER_EOF;
-  }
-  else if ( m_events->read() )  {
+  size_t which = m_position;
+  if ( m_events->read(which) )  {
     EventStream::Particles& parts = m_events->particles();
 
     Position pos(primary_vertex->x,primary_vertex->y,primary_vertex->z);
@@ -292,9 +395,11 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
           primary_vertex->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
       }
     }
+    m_position = which + 1;
     ++m_currEvent;
     return EVENT_READER_OK;
   }
+  m_position = which;
   vertices.clear();
   output.clear();
   return EVENT_READER_EOF;
@@ -365,79 +470,88 @@ Geant4Vertex* HepMC::vertex(EventStream& info, int i)   {
   return (it==info.vertices().end()) ? 0 : (*it).second;
 }
 
-char HepMC::get_input(istream& is, istringstream& iline)  {
-  char value = is.peek();
-  if ( !is ) {        // make sure the stream is valid
-    cerr << "StreamHelpers: setting badbit." << endl;
-    is.clear(ios::badbit);
-    return -1;
-  }
-  string line, firstc;
-  getline(is,line);
-  if ( !is ) {        // make sure the stream is valid
-    cerr << "StreamHelpers: setting badbit." << endl;
-    is.clear(ios::badbit);
-    return -1;
-  }
-  iline.clear();
-  iline.str(line);
-  if ( line.length()>0 && line[1] == ' ' ) iline >> firstc;
-  return iline ? value : -1;
+/// Convert the next token to an integer
+bool HepMC::Line::get(long& value)   {
+  if ( !skip() ) return false;
+  const char* p = ptr;
+  bool negative = false;
+  if ( *p == '-' || *p == '+' ) negative = (*p++ == '-');
+  if ( p == end || (unsigned char)(*p - '0') > 9 ) return false;
+  long v = 0;
+  for( ; p < end && (unsigned char)(*p - '0') <= 9; ++p )
+    v = 10*v + (*p - '0');
+  ptr   = p;
+  value = negative ? -v : v;
+  return true;
 }
 
-int HepMC::read_until_event_end(istream & is) {
-  string line;
-  while ( is ) {
-    char val = is.peek();
-    if( val == 'E' ) {  // next event
-      return 1;
-    }
-    getline(is,line);
-    if ( !is.good() ) return 0;
-  }
-  return 0;
+/// Convert the next token to a floating point number
+bool HepMC::Line::get(double& value)   {
+  if ( !skip() ) return false;
+  char*  e = 0;
+  double v = ::strtod(ptr, &e);
+  if ( e == ptr ) return false;
+  ptr   = e;
+  value = v;
+  return true;
 }
 
-int HepMC::read_weight_names(EventStream&, istringstream&)   {
-#if 0
-  int HepMC::read_weight_names(EventStream& info, istringstream& iline)
-    size_t name_size = 0;
-  iline >> name_size;
-  info.weights.names.clear();
-  info.weights.weights.clear();
-
-  string name;
-  WeightContainer namedWeight;
-  string::size_type i1 = line.find("\""), i2, len = line.size();
-  for(size_t ii = 0; ii < name_size; ++ii) {
-    // weight names may contain blanks
-    if(i1 >= len) {
-      cout << "debug: attempting to read past the end of the named weight line " << endl;
-      cout << "debug: We should never get here" << endl;
-      cout << "debug: Looking for the end of this event" << endl;
-      read_until_event_end(is);
-    }
-    i2 = line.find("\"",i1+1);
-    name = line.substr(i1+1,i2-i1-1);
-    if ( namedWeight.names.find(name) == namedWeight.names.end() )
-      namedWeight.names[name] = namedWeight.names.size();
-    namedWeight.weights[ii] = info.weights.weights[ii];
-    i1 = line.find("\"",i2+1);
-  }
+/// Access the next blank separated word
+bool HepMC::Line::get(string& value)   {
+  if ( !skip() ) return false;
+  const char* p = ptr;
+  while ( p < end && *p != ' ' && *p != '\t' && *p != '\r' ) ++p;
+  value.assign(ptr, p);
+  ptr = p;
+  return true;
+}
 
-  info.weights.weights = namedWeight.weights;
-  info.weights.names   = namedWeight.names;
-#endif
+/// Find the end of the line. The data are terminated by a newline
+const char* HepMC::line_end(const char* ptr, const char* end)   {
+  const char* e = (const char*)::memchr(ptr, '\n', end-ptr);
+  return e ? e : end;
+}
+
+/// Translate the keys of the 'H' records. Returns the io type or 0
+int HepMC::io_key(const string& key_value, bool& start)   {
+  start = true;
+  if( key_value == "HepMC::IO_GenEvent-START_EVENT_LISTING" )
+    return gen;
+  else if( key_value == "HepMC::IO_Ascii-START_EVENT_LISTING" )
+    return ascii;
+  else if( key_value == "HepMC::IO_ExtendedAscii-START_EVENT_LISTING" )
+    return extascii;
+  else if( key_value == "HepMC::IO_Ascii-START_PARTICLE_DATA" )
+    return ascii_pdt;
+  else if( key_value == "HepMC::IO_ExtendedAscii-START_PARTICLE_DATA" )
+    return extascii_pdt;
+  start = false;
+  if( key_value == "HepMC::IO_GenEvent-END_EVENT_LISTING" )
+    return gen;
+  else if( key_value == "HepMC::IO_Ascii-END_EVENT_LISTING" )
+    return ascii;
+  else if( key_value == "HepMC::IO_ExtendedAscii-END_EVENT_LISTING" )
+    return extascii;
+  else if( key_value == "HepMC::IO_Ascii-END_PARTICLE_DATA" )
+    return ascii_pdt;
+  else if( key_value == "HepMC::IO_ExtendedAscii-END_PARTICLE_DATA" )
+    return extascii_pdt;
+  return 0;
+}
+
+int HepMC::read_weight_names(EventStream&, Line&)   {
+  // Weight names are not used
   return 1;
 }
 
-int HepMC::read_particle(EventStream &info, istringstream& input, Geant4Particle * p)   {
+int HepMC::read_particle(EventStream &info, Line& input, Geant4Particle * p)   {
   float ene = 0., theta = 0., phi = 0;
   int   size = 0, stat=0;
   PropertyMask status(p->status);
 
-  // check that the input stream is still OK after reading item
-  input >> p->id >> p->pdgID >> p->psx >> p->psy >> p->psz >> ene;
+  // check that the input is still OK after reading item
+  bool ok = input.get(p->id) && input.get(p->pdgID) &&
+    input.get(p->psx) && input.get(p->psy) && input.get(p->psz) && input.get(ene);
   p->id = info.particles().size();
 #if defined(DD4HEP_DEBUG_HEP_MC_PARTICLE)
   if ( p->id == DD4HEP_DEBUG_HEP_MC_PARTICLE )   {
@@ -448,18 +562,18 @@ int HepMC::read_particle(EventStream &info, istringstream& input, Geant4Particle
   p->psy *= info.mom_unit;
   p->psz *= info.mom_unit;
   ene *= info.mom_unit;
-  if ( !input )
+  if ( !ok )
     return 0;
   else if ( info.io_type != ascii )  {
-    input >> p->mass;
+    if ( !input.get(p->mass) ) return 0;
     p->mass *= info.mom_unit;
   }
   else   {
     p->mass = std::sqrt(fabs(ene*ene - (p->psx*p->psx + p->psy*p->psy + p->psz*p->psz)));
   }
   // Reuse here the secondaries to store the end-vertex ID
-  input >> stat >> theta >> phi >> p->secondaries >> size;
-  if( !input )   {
+  if ( !(input.get(stat) && input.get(theta) && input.get(phi) &&
+         input.get(p->secondaries) && input.get(size)) )   {
     return 0;
   }
   //
@@ -479,29 +593,24 @@ int HepMC::read_particle(EventStream &info, istringstream& input, Geant4Particle
   }
   /// Keep a copy of the full generator status
   p->genStatus = stat&G4PARTICLE_GEN_STATUS_MASK;
-  
+
   // read flow patterns if any exist. Protect against tainted readings.
   size = min(size,100);
   for (int i = 0; i < size; ++i ) {
-    input >> p->colorFlow[0] >> p->colorFlow[1];
-    if(!input) return 0;
+    if ( !(input.get(p->colorFlow[0]) && input.get(p->colorFlow[1])) ) return 0;
   }
   return 1;
 }
 
-int HepMC::read_vertex(EventStream &info, istream& is, istringstream & input)    {
+int HepMC::read_vertex(EventStream &info, const char*& ptr, Line & input)    {
   int id=0, dummy = 0, num_orphans_in=0, num_particles_out=0, weights_size=0;
   vector<float> weights;
   Geant4Vertex* v = new Geant4Vertex();
   Geant4Particle* p;
 
-  if( !input ) {
-    delete v;
-    return 0;
-  }
-  input >> id >> dummy >> v->x >> v->y >> v->z >> v->time
-        >> num_orphans_in >> num_particles_out >> weights_size;
-  if( !input ) {
+  if ( !(input.get(id) && input.get(dummy) &&
+         input.get(v->x) && input.get(v->y) && input.get(v->z) && input.get(v->time) &&
+         input.get(num_orphans_in) && input.get(num_particles_out) && input.get(weights_size)) ) {
     delete v;
     return 0;
   }
@@ -513,22 +622,20 @@ int HepMC::read_vertex(EventStream &info, istream& is, istringstream & input)
   v->x *= info.pos_unit;
   v->y *= info.pos_unit;
   v->z *= info.pos_unit;
-  weights.resize(weights_size);
+  weights.resize(max(weights_size,0));
   for (int i1 = 0; i1 < weights_size; ++i1) {
-    input >> weights[i1];
-    if( !input ) {
+    if( !input.get(weights[i1]) ) {
       delete v;
       return 0;
     }
   }
   info.vertices().emplace(id,v);
-  for(char value = is.peek(); value=='P'; value=is.peek())  {
-    value = get_input(is,input);
-    if( !input || value < 0 )
-      return 0;
+  while ( ptr < info.end && *ptr == 'P' )  {
+    const char* last = line_end(ptr, info.end);
+    Line line(ptr+1, last);
+    ptr = last + 1;
 
-    read_particle(info, input,p = new Geant4Particle());
-    if( !input )   {
+    if( !read_particle(info, line, p = new Geant4Particle()) )   {
       printout(ERROR,"HepMC","++ Vertex %d Failed to daughter read particle!",id);
       delete p;
       return 0;
@@ -567,141 +674,96 @@ int HepMC::read_vertex(EventStream &info, istream& is, istringstream & input)
   return 1;
 }
 
-int HepMC::read_event_header(EventStream &info, istringstream & input, EventHeader& header)   {
+int HepMC::read_event_header(EventStream &info, Line & input, EventHeader& header)   {
   // read values into temp variables, then fill GenEvent
   int random_states_size = 0;
-  input >> header.id;
+  printout(DEBUG,"HepMC","++ Event header: %s",input.str().c_str());
+  input.get(header.id);
   if( info.io_type == gen || info.io_type == extascii ) {
     int nmpi = -1;
-    input >> nmpi;
-    if( input.fail() ) return 0;
+    if( !input.get(nmpi) ) return 0;
     //MSF set_mpi( nmpi );
   }
-  input >> header.scale;
-  input >> header.alpha_qcd;
-  input >> header.alpha_qed;
-  input >> header.signal_process_id;
-  input >> header.signal_process_vertex;
-  input >> header.num_vertices;
-  if( info.io_type == gen || info.io_type == extascii )
-    input >> header.bp1 >> header.bp2;
-
-  input >> random_states_size;
-  printout(DEBUG,"HepMC","++ Event header: %s",input.str().c_str());
-  input.clear();
-  if( input.fail() ) return 0;
+  // Missing values up to here are tolerated
+  input.get(header.scale);
+  input.get(header.alpha_qcd);
+  input.get(header.alpha_qed);
+  input.get(header.signal_process_id);
+  input.get(header.signal_process_vertex);
+  input.get(header.num_vertices);
+  if( info.io_type == gen || info.io_type == extascii )  {
+    input.get(header.bp1);
+    input.get(header.bp2);
+  }
+  input.get(random_states_size);
 
-  header.random.resize(random_states_size);
+  header.random.resize(max(random_states_size,0));
   for(int i = 0; i < random_states_size; ++i )
-    input >> header.random[i];
+    input.get(header.random[i]);
 
-  size_t weights_size = 0;
-  input >> weights_size;
-  if( input.fail() ) return 0;
+  int weights_size = 0;
+  if( !input.get(weights_size) ) return 0;
 
-  vector<float> wgt(weights_size);
-  for(size_t ii = 0; ii < weights_size; ++ii )
-    input >> wgt[ii];
-  if( input.fail() ) return 0;
+  vector<float> wgt(max(weights_size,0));
+  for(int ii = 0; ii < weights_size; ++ii )
+    if( !input.get(wgt[ii]) ) return 0;
 
   // weight names will be added later if they exist
   if( weights_size > 0 ) header.weights = wgt;
   return 1;
 }
 
-int HepMC::read_cross_section(EventStream &info, istringstream & input)   {
-  input >> info.xsection >> info.xsection_err;
-  return input.fail() ? 0 : 1;
+int HepMC::read_cross_section(EventStream &info, Line & input)   {
+  return input.get(info.xsection) && input.get(info.xsection_err) ? 1 : 0;
 }
 
-int HepMC::read_units(EventStream &info, istringstream & input)   {
+int HepMC::read_units(EventStream &info, Line & input)   {
   if( info.io_type == gen )  {
     string mom, pos;
-    input >> mom >> pos;
-    if ( !input.fail() )  {
-      if ( mom == "KEV" ) info.mom_unit = CLHEP::keV;
-      else if ( mom == "MEV" ) info.mom_unit = CLHEP::MeV;
-      else if ( mom == "GEV" ) info.mom_unit = CLHEP::GeV;
-      else if ( mom == "TEV" ) info.mom_unit = CLHEP::TeV;
-
-      if ( pos == "MM" ) info.pos_unit = CLHEP::mm;
-      else if ( pos == "CM" ) info.pos_unit = CLHEP::cm;
-      else if ( pos == "M"  ) info.pos_unit = CLHEP::m;
-    }
+    if ( !(input.get(mom) && input.get(pos)) )
+      return 0;
+    if ( mom == "KEV" ) info.mom_unit = CLHEP::keV;
+    else if ( mom == "MEV" ) info.mom_unit = CLHEP::MeV;
+    else if ( mom == "GEV" ) info.mom_unit = CLHEP::GeV;
+    else if ( mom == "TEV" ) info.mom_unit = CLHEP::TeV;
+
+    if ( pos == "MM" ) info.pos_unit = CLHEP::mm;
+    else if ( pos == "CM" ) info.pos_unit = CLHEP::cm;
+    else if ( pos == "M"  ) info.pos_unit = CLHEP::m;
   }
-  return input.fail() ? 0 : 1;
+  return 1;
 }
 
-int HepMC::read_heavy_ion(EventStream &, istringstream & input)  {
-  // read values into temp variables, then create a new HeavyIon object
-  int nh =0, np =0, nt =0, nc =0,
-    neut = 0, prot = 0, nw =0, nwn =0, nwnw =0;
-  float impact = 0., plane = 0., xcen = 0., inel = 0.;
-  input >> nh >> np >> nt >> nc >> neut >> prot >> nw >> nwn >> nwnw;
-  input >> impact >> plane >> xcen >> inel;
-  /*
-    cerr << "Reading heavy ion, but igoring data!" << endl;
-    ion->set_Ncoll_hard(nh);
-    ion->set_Npart_proj(np);
-    ion->set_Npart_targ(nt);
-    ion->set_Ncoll(nc);
-    ion->set_spectator_neutrons(neut);
-    ion->set_spectator_protons(prot);
-    ion->set_N_Nwounded_collisions(nw);
-    ion->set_Nwounded_N_collisions(nwn);
-    ion->set_Nwounded_Nwounded_collisions(nwnw);
-    ion->set_impact_parameter(impact);
-    ion->set_event_plane_angle(plane);
-    ion->set_eccentricity(xcen);
-    ion->set_sigma_inel_NN(inel);
-  */
-  return input.fail() ? 0 : 1;
+int HepMC::read_heavy_ion(EventStream &, Line & input)  {
+  // The heavy ion information is not used: only check the record
+  int   n = 0;
+  float x = 0.;
+  for(int i = 0; i < 9; ++i)
+    if ( !input.get(n) ) return 0;
+  for(int i = 0; i < 4; ++i)
+    if ( !input.get(x) ) return 0;
+  return 1;
 }
 
-int HepMC::read_pdf(EventStream &, istringstream & input)  {
-  // read values into temp variables, then create a new PdfInfo object
+int HepMC::read_pdf(EventStream &, Line & input)  {
+  // The pdf information is not used: only check the record
   int id1 =0, id2 =0;
   double  x1 = 0., x2 = 0., scale = 0., pdf1 = 0., pdf2 = 0.;
-  input >> id1 ;
-  if ( input.fail()  )
+  if ( !input.get(id1) )
     return 0;
   // check now for empty PdfInfo line
   if( id1 == 0 )
     return 0;
   // continue reading
-  input >> id2 >> x1 >> x2 >> scale >> pdf1 >> pdf2;
-  if ( input.fail()  )
+  if ( !(input.get(id2) && input.get(x1) && input.get(x2) &&
+         input.get(scale) && input.get(pdf1) && input.get(pdf2)) )
     return 0;
-  /*
-    cerr << "Reading pdf, but igoring data!" << endl;
-    pdf->set_id1( id1 );
-    pdf->set_id2( id2 );
-    pdf->set_x1( x1 );
-    pdf->set_x2( x2 );
-    pdf->set_scalePDF( scale );
-    pdf->set_pdf1( pdf1 );
-    pdf->set_pdf2( pdf2 );
-  */
   // check to see if we are at the end of the line
-  if( !input.eof() )  {
+  if( input.skip() )  {
     int pdf_id1=0, pdf_id2=0;
-    input >> pdf_id1 >> pdf_id2;
-    /*
-      pdf->set_pdf_id1( pdf_id1 );
-      pdf->set_pdf_id2( pdf_id2 );
-    */
+    return input.get(pdf_id1) && input.get(pdf_id2) ? 1 : 0;
   }
-  return input.fail() ? 0 : 1;
-}
-
-/// Check if data stream is in proper state and has data
-bool HepMC::EventStream::ok()  const   {
-  // make sure the stream is good
-  if ( instream.eof() || instream.fail() )  {
-    instream.clear(ios::badbit);
-    return false;
-  }
-  return true;
+  return 1;
 }
 
 void HepMC::EventStream::clear()   {
@@ -709,132 +771,129 @@ void HepMC::EventStream::clear()   {
   detail::releaseObjects(m_particles);
 }
 
-bool HepMC::EventStream::read()   {
+/// Build the event index with one pass over the data
+void HepMC::EventStream::build_index()   {
+  string key_value;
+  for( const char* ptr = begin; ptr < end; )   {
+    const char* last = line_end(ptr, end);
+    if ( *ptr == 'E' )   {
+      index.emplace_back(Entry{size_t(ptr-begin), io_type, mom_unit, pos_unit});
+    }
+    else if ( *ptr == 'U' )   {
+      // Units apply to all following events until changed
+      Line line(ptr+1, last);
+      read_units(*this, line);
+    }
+    else if ( *ptr == 'H' )   {
+      Line line(ptr, last);
+      bool start = false;
+      int  typ   = line.get(key_value) ? io_key(key_value, start) : 0;
+      if ( typ != 0 && start ) this->set_io(typ, key_value);
+    }
+    ptr = last + 1;
+  }
+  use_default_units();
+}
+
+/// Read the event entry 'which'. Malformed events are skipped: 'which' is updated
+bool HepMC::EventStream::read(size_t& which)   {
+  this->clear();
+  while( which < index.size() )  {
+    const Entry& entry = index[which];
+    this->io_type  = entry.io_type;
+    this->mom_unit = entry.mom_unit;
+    this->pos_unit = entry.pos_unit;
+    int sc = read_event(begin + entry.offset);
+    if ( sc > 0 )  {
+      fix_particles(*this);
+      detail::releaseObjects(vertices());
+      return true;
+    }
+    this->clear();
+    if ( sc < 0 )  {
+      which = index.size();
+      return false;
+    }
+    printout(WARNING,"HepMC::EventStream","+++ Skip event with ID: %d",this->header.id);
+    ++which;
+  }
+  return false;
+}
+
+/// Read the event starting at the data pointer. Return: 1 success, 0 skip, -1 fatal
+int HepMC::EventStream::read_event(const char* ptr)   {
   EventStream& info = *this;
   bool event_read = false;
-  static int num_evt = 0;
-  int num_line = 0, num_line_accepted = 0;
-
-  detail::releaseObjects(vertices());
-  detail::releaseObjects(particles());
-
-  ++num_evt;
-  while( instream.good() ) {
-    char value = instream.peek();
-    istringstream input_line;
-    ++num_line;
-    if      ( value == 'E' && event_read )
+  string key_value;
+
+  while( ptr < end ) {
+    char value = *ptr;
+    if ( value == 'E' && event_read )
       break;
-    else if ( instream.eof() && event_read )
-      goto Done;
-    else if ( instream.eof() )
-      return false;
-    else if ( value=='#' || ::isspace(value) )  {
-      get_input(instream,input_line);
+    const char* last = line_end(ptr, end);
+    Line input_line(ptr+1, last);
+    const char* line_start = ptr;
+    ptr = last + 1;
+    if ( value=='#' || ::isspace(value) )
       continue;
-    }
-    value = get_input(instream,input_line);
 
-    // On failure switch to end
-    if( !input_line || value < 0 )
-      goto Skip;
-
-    ++num_line_accepted;
     switch( value )   {
     case 'H':  {
-      int iotype = 0;
-      string key_value;
-      input_line >> key_value;
-      // search for event listing key before first event only.
-      key_value = key_value.substr(0,key_value.find('\r'));
+      Line line(line_start, last);
+      bool start = false;
+      if ( !line.get(key_value) )
+        continue;
+      // heavy ion records
       if ( key_value == "H" && (this->io_type == gen || this->io_type == extascii) ) {
-        read_heavy_ion(info, input_line);
-        break;
-      }
-      else if( key_value == "HepMC::IO_GenEvent-START_EVENT_LISTING" )
-        this->set_io(gen,key_value);
-      else if( key_value == "HepMC::IO_Ascii-START_EVENT_LISTING" )
-        this->set_io(ascii,key_value);
-      else if( key_value == "HepMC::IO_ExtendedAscii-START_EVENT_LISTING" )
-        this->set_io(extascii,key_value);
-      else if( key_value == "HepMC::IO_Ascii-START_PARTICLE_DATA" )
-        this->set_io(ascii_pdt,key_value);
-      else if( key_value == "HepMC::IO_ExtendedAscii-START_PARTICLE_DATA" )
-        this->set_io(extascii_pdt,key_value);
-      else if( key_value == "HepMC::IO_GenEvent-END_EVENT_LISTING" )
-        iotype = gen;
-      else if( key_value == "HepMC::IO_Ascii-END_EVENT_LISTING" )
-        iotype = ascii;
-      else if( key_value == "HepMC::IO_ExtendedAscii-END_EVENT_LISTING" )
-        iotype = extascii;
-      else if( key_value == "HepMC::IO_Ascii-END_PARTICLE_DATA" )
-        iotype = ascii_pdt;
-      else if( key_value == "HepMC::IO_ExtendedAscii-END_PARTICLE_DATA" )
-        iotype = extascii_pdt;
-
-      if( iotype != 0 && this->io_type != iotype )  {
-        cerr << "GenEvent::find_end_key: iotype keys have changed. "
-             << "MALFORMED INPUT" << endl;
-        instream.clear(ios::badbit);
-        return false;
+        read_heavy_ion(info, line);
+        continue;
       }
-      else if ( iotype != 0 )  {
-        break;
+      int iotype = io_key(key_value, start);
+      if( iotype != 0 && !start && this->io_type != iotype )  {
+        printout(ERROR,"HepMC::EventStream","GenEvent::find_end_key: iotype keys have changed. "
+                 "MALFORMED INPUT");
+        return -1;
       }
       continue;
     }
     case 'E':           // deal with the event line
       if ( !read_event_header(info, input_line, this->header) )
-        goto Skip;
+        return 0;
       event_read = true;
       continue;
 
     case 'N':           // get weight names
       if ( !read_weight_names(info, input_line) )
-        goto Skip;
+        return 0;
       continue;
 
     case 'U':           // get unit information if it exists
       if ( !read_units(info, input_line) )
-        goto Skip;
+        return 0;
       continue;
 
     case 'C':           // we have a GenCrossSection line
       if ( !read_cross_section(info, input_line) )
-        goto Skip;
+        return 0;
       continue;
 
     case 'V':           // Read vertex with particles
-      if ( !read_vertex(info, instream, input_line) )
-        goto Skip;
+      if ( !read_vertex(info, ptr, input_line) )
+        return 0;
       continue;
 
     case 'F':           // Read PDF
       if ( !read_pdf(info, input_line) )
-        goto Skip;
+        return 0;
       continue;
 
     case 'P':           // we should not find this line
-      cerr << "streaming input: found unexpected Particle line." << endl;
+      printout(WARNING,"HepMC::EventStream","streaming input: found unexpected Particle line.");
       continue;
 
     default:            // ignore everything else
       continue;
     }
-    continue;
-  Skip:
-    printout(WARNING,"HepMC::EventStream","+++ Skip event with ID: %d",this->header.id);
-    detail::releaseObjects(vertices());
-    detail::releaseObjects(particles());
-    read_until_event_end(instream);
-    event_read = false;
-    if ( instream.eof() ) return false;
   }
-
-  if( not instream.good() ) return false;
- Done:
-  fix_particles(info);
-  detail::releaseObjects(vertices());
-  return true;
+  return event_read ? 1 : 0;
 }
-
@@ -0,0 +1,519 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4DetectorConstruction.h"
+
+// Geant4 include files
+#include "G4VFastSimulationModel.hh"
+#include "G4TouchableHandle.hh"
+
+// C/C++ include files
+#include <vector>
+#include <string>
+#include <chrono>
+
+// Forward declarations
+class G4Navigator;
+class G4Material;
+class G4Region;
+class G4LogicalVolume;
+class G4Run;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    // Forward declarations
+    class Geant4FastShowerModel;
+
+    /// Parameters of the shower profiles at a given energy
+    /**
+     *  Longitudinal profile: Gamma distribution in units of the radiation length
+     *     dE/dt ~ t^(alpha-1) * exp(-beta*t)
+     *  Lateral profile: Two exponential components in units of the Moliere radius
+     *     with the fraction pcore of the energy in the core.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    struct Geant4FastShowerProfile  {
+      double energy { 0e0 };
+      double alpha  { 0e0 };
+      double beta   { 0e0 };
+      double rcore  { 0e0 };
+      double rtail  { 0e0 };
+      double pcore  { 0e0 };
+    };
+
+    /// Fast simulation action depositing parameterized electromagnetic showers
+    /**
+     *  The action attaches a G4VFastSimulationModel to an existing region
+     *  of the geometry. The call is thread-local: every worker gets its own model.
+     *  The action keeps the models, the statistics of each model are printed
+     *  at the end of each run and the models are deleted with the action.
+     *  Particles of the requested types within the energy range are killed when
+     *  entering the region and their energy is deposited as a set of energy spots
+     *  distributed according to the shower profiles.
+     *
+     *  The spots are deposited into the sensitive detector of the volume they
+     *  fall into through the GFlash interface of the DDG4 sensitive detectors:
+     *  the sensitive actions compute the cell identifiers from the segmentation
+     *  in processGFlash() and fill the hits e.g. Geant4Calorimeter::Hit.
+     *  Spots in passive volumes are lost, hence the sampling of the calorimeter
+     *  is described by the geometry.
+     *
+     *  The shower profiles are either taken from a library file or are
+     *  computed from the material properties using simple parameterizations
+     *  for homogeneous media. The radiation length, the Moliere radius and
+     *  the critical energy are those of the effective medium of the region:
+     *  the materials of all volumes in the region are mixed according to
+     *  their volume. The material where the shower starts is not used: in a
+     *  sampling calorimeter this may be the absorber, the sensitive layer
+     *  or air and the shower depth would depend on the entry point.
+     *  The properties RadiationLength, MoliereRadius and CriticalEnergy
+     *  override the values of the effective medium. The library file is a text file
+     *  with one line per energy point and the columns:
+     *      energy [GeV]  alpha  beta  rcore [R_M]  rtail [R_M]  pcore
+     *  The parameters are interpolated linearly in log(energy).
+     *  Lines starting with '#' are ignored.
+     *
+     *  Note: The Geant4 physics list must contain the process
+     *  G4FastSimulationManagerProcess for the applicable particles.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastShowerAction : public Geant4DetectorConstruction   {
+      friend class Geant4FastShowerModel;
+    protected:
+      /// Property: Name of the region the model is attached to
+      std::string              m_regionName;
+      /// Property: Names of the particles triggering the model
+      std::vector<std::string> m_particles;
+      /// Property: Minimal kinetic energy to trigger the model
+      double                   m_energyMin;
+      /// Property: Maximal kinetic energy to trigger the model
+      double                   m_energyMax;
+      /// Property: Name of the profile library file. If empty the profiles are computed
+      std::string              m_profileLibrary;
+      /// Property: Longitudinal step size in units of the radiation length
+      double                   m_longitudinalStep;
+      /// Property: Maximal shower depth in units of the radiation length
+      double                   m_maxDepth;
+      /// Property: Number of energy spots per longitudinal step
+      int                      m_spotsPerStep;
+      /// Property: Radiation length. If not set, taken from the effective medium of the region
+      double                   m_radiationLength;
+      /// Property: Moliere radius. If not set, taken from the effective medium of the region
+      double                   m_moliereRadius;
+      /// Property: Critical energy. If not set, taken from the effective medium of the region
+      double                   m_criticalEnergy;
+
+      /// Radiation length used for the showers
+      double                   m_x0 { 0e0 };
+      /// Moliere radius used for the showers
+      double                   m_rm { 0e0 };
+      /// Critical energy used for the showers
+      double                   m_ec { 0e0 };
+
+      /// Profile library sorted by energy
+      std::vector<Geant4FastShowerProfile> m_library;
+      /// Thread-local models created by this action
+      std::vector<Geant4FastShowerModel*>  m_models;
+      /// Flag if the library file was already read
+      bool                     m_libraryLoaded { false };
+      /// Flag if the material properties were already computed
+      bool                     m_mediumDefined { false };
+
+      /// Read the profile library file
+      void loadLibrary();
+      /// Compute the material properties of the effective medium of the region
+      void defineMedium(G4Region* region);
+
+    public:
+      /// Initializing constructor for DDG4
+      Geant4FastShowerAction(Geant4Context* ctxt, const std::string& nam);
+      /// Default destructor
+      virtual ~Geant4FastShowerAction();
+      /// Shower profile for a given particle energy and material properties
+      Geant4FastShowerProfile profile(double energy, double critical_energy, bool photon)  const;
+      /// Sensitives construction callback. Called at "ConstructSDandField()"
+      virtual void constructSensitives(Geant4DetectorConstructionContext* ctxt)  override;
+    };
+
+    /// Geant4 fast simulation model of the Geant4FastShowerAction
+    /**
+     *  Thread-local model instance. See Geant4FastShowerAction for details.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4FastShowerModel : public G4VFastSimulationModel   {
+    protected:
+      /// Reference to the configuration
+      const Geant4FastShowerAction* m_action;
+      /// Private navigator to locate the energy spots
+      G4Navigator*       m_navigator { nullptr };
+      /// Touchable of the last located energy spot
+      G4TouchableHandle  m_touchable;
+      /// Statistics: number of parameterized showers
+      long               m_numShowers    { 0 };
+      /// Statistics: number of energy spots
+      long               m_numSpots      { 0 };
+      /// Statistics: number of energy spots in sensitive volumes
+      long               m_numSensitive  { 0 };
+      /// Statistics: total parameterized energy
+      double             m_energy        { 0e0 };
+      /// Statistics: energy deposited in sensitive volumes
+      double             m_energySensitive { 0e0 };
+      /// Statistics: time spent in the model
+      std::chrono::duration<double> m_time { 0e0 };
+
+      /// Deposit one energy spot
+      void deposit(double energy, const G4ThreeVector& position, const G4FastTrack& track);
+
+    public:
+      /// Initializing constructor
+      Geant4FastShowerModel(const Geant4FastShowerAction* action, G4Region* region);
+      /// Default destructor
+      virtual ~Geant4FastShowerModel();
+      /// End-of-run callback: print the statistics of this model
+      void endRun(const G4Run* run);
+      /// G4VFastSimulationModel interface: Check if the particle type is handled
+      virtual G4bool IsApplicable(const G4ParticleDefinition& particle)  override;
+      /// G4VFastSimulationModel interface: Check if the model should be triggered
+      virtual G4bool ModelTrigger(const G4FastTrack& track)  override;
+      /// G4VFastSimulationModel interface: Deposit the parameterized shower
+      virtual void DoIt(const G4FastTrack& track, G4FastStep& step)  override;
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4RunAction.h"
+#include "DDG4/Factories.h"
+
+// Geant4 include files
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "G4Navigator.hh"
+#include "G4TransportationManager.hh"
+#include "G4TouchableHistory.hh"
+#include "G4GFlashSpot.hh"
+#include "G4VGFlashSensitiveDetector.hh"
+#include "G4VSensitiveDetector.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4Material.hh"
+#include "G4Gamma.hh"
+#include "G4AutoLock.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "Randomize.hh"
+
+// C/C++ include files
+#include <map>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::sim;
+
+namespace {
+  G4Mutex action_mutex = G4MUTEX_INITIALIZER;
+
+  /// Critical energy of a material (see PDG review "Passage of particles through matter")
+  double critical_energy(const G4Material* mat)   {
+    double zeff = 0e0;
+    const double* frac = mat->GetFractionVector();
+    for( size_t i = 0; i < mat->GetNumberOfElements(); ++i )
+      zeff += frac[i] * mat->GetElement(i)->GetZ();
+    return 610e0*CLHEP::MeV/(zeff + 1.24);
+  }
+
+  /// Accumulate the volume of each material of a logical volume and its daughters in the region
+  void collect_materials(const G4LogicalVolume* lv, const G4Region* region, double multiplicity,
+                         map<const G4Material*, double>& volumes)   {
+    double volume = lv->GetSolid()->GetCubicVolume();
+    for( size_t i = 0, n = lv->GetNoDaughters(); i < n; ++i )   {
+      const G4VPhysicalVolume* pv = lv->GetDaughter(i);
+      const G4LogicalVolume* daughter = pv->GetLogicalVolume();
+      double num = double(pv->GetMultiplicity());
+      volume -= num * daughter->GetSolid()->GetCubicVolume();
+      if ( daughter->GetRegion() == region )
+        collect_materials(daughter, region, multiplicity * num, volumes);
+    }
+    if ( volume > 0e0 ) volumes[lv->GetMaterial()] += multiplicity * volume;
+  }
+}
+
+DECLARE_GEANT4ACTION(Geant4FastShowerAction)
+
+/// Initializing constructor for other clients
+Geant4FastShowerAction::Geant4FastShowerAction(Geant4Context* ctxt, const string& nam)
+  : Geant4DetectorConstruction(ctxt,nam)
+{
+  declareProperty("RegionName",          m_regionName);
+  declareProperty("ApplicableParticles", m_particles = { "e+", "e-", "gamma" });
+  declareProperty("EnergyMin",           m_energyMin = 1e0 * CLHEP::GeV);
+  declareProperty("EnergyMax",           m_energyMax = 1e0 * CLHEP::TeV);
+  declareProperty("ProfileLibrary",      m_profileLibrary);
+  declareProperty("LongitudinalStep",    m_longitudinalStep = 0.5);
+  declareProperty("MaxDepth",            m_maxDepth = 30e0);
+  declareProperty("SpotsPerStep",        m_spotsPerStep = 20);
+  declareProperty("RadiationLength",     m_radiationLength = 0e0);
+  declareProperty("MoliereRadius",       m_moliereRadius = 0e0);
+  declareProperty("CriticalEnergy",      m_criticalEnergy = 0e0);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FastShowerAction::~Geant4FastShowerAction() {
+  G4AutoLock protection_lock(&action_mutex);
+  for( auto* model : m_models )
+    delete model;
+  m_models.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Read the profile library file
+void Geant4FastShowerAction::loadLibrary()   {
+  ifstream in(m_profileLibrary);
+  if ( !in.good() )   {
+    except("+++ Failed to open shower profile library %s", m_profileLibrary.c_str());
+  }
+  string line;
+  while ( getline(in, line) )   {
+    size_t idx = line.find_first_not_of(" \t");
+    if ( idx == string::npos || line[idx] == '#' ) continue;
+    Geant4FastShowerProfile p;
+    stringstream str(line);
+    if ( !(str >> p.energy >> p.alpha >> p.beta >> p.rcore >> p.rtail >> p.pcore) )   {
+      except("+++ Invalid line in shower profile library %s: %s",
+             m_profileLibrary.c_str(), line.c_str());
+    }
+    p.energy *= CLHEP::GeV;
+    m_library.emplace_back(p);
+  }
+  sort(m_library.begin(), m_library.end(),
+       [](const Geant4FastShowerProfile& a, const Geant4FastShowerProfile& b)  {
+         return a.energy < b.energy;
+       });
+  info("+++ Loaded %ld shower profiles from %s", long(m_library.size()), m_profileLibrary.c_str());
+}
+
+/// Shower profile for a given particle energy and material properties
+Geant4FastShowerProfile
+Geant4FastShowerAction::profile(double energy, double critical_energy, bool photon)  const   {
+  Geant4FastShowerProfile p;
+  if ( m_library.empty() )   {
+    // Parameterization for homogeneous media (see PDG review "Passage of particles through matter")
+    double tmax = std::max(log(energy / critical_energy) + (photon ? 0.5 : -0.5), 0.5);
+    p.energy = energy;
+    p.beta   = 0.5;
+    p.alpha  = 1e0 + p.beta * tmax;
+    p.rcore  = 0.2;
+    p.rtail  = 1.0;
+    p.pcore  = 0.85;
+    return p;
+  }
+  if ( energy <= m_library.front().energy ) return m_library.front();
+  if ( energy >= m_library.back().energy  ) return m_library.back();
+  auto hi = upper_bound(m_library.begin(), m_library.end(), energy,
+                        [](double e, const Geant4FastShowerProfile& q) { return e < q.energy; });
+  auto lo = hi - 1;
+  double f = log(energy / lo->energy) / log(hi->energy / lo->energy);
+  p.energy = energy;
+  p.alpha  = lo->alpha + f * (hi->alpha - lo->alpha);
+  p.beta   = lo->beta  + f * (hi->beta  - lo->beta);
+  p.rcore  = lo->rcore + f * (hi->rcore - lo->rcore);
+  p.rtail  = lo->rtail + f * (hi->rtail - lo->rtail);
+  p.pcore  = lo->pcore + f * (hi->pcore - lo->pcore);
+  return p;
+}
+
+/// Compute the material properties of the effective medium of the region
+void Geant4FastShowerAction::defineMedium(G4Region* region)   {
+  map<const G4Material*, double> volumes;
+  double total = 0e0;
+  auto lv = region->GetRootLogicalVolumeIterator();
+  for( size_t i = 0; i < region->GetNumberOfRootVolumes(); ++i, ++lv )
+    collect_materials(*lv, region, 1e0, volumes);
+  // Volume fractions f: 1/X0 = sum(f/X0),  Ec/X0 = sum(f*Ec/X0),  R_M = Es*X0/Ec
+  double inv_x0 = 0e0, ec_x0 = 0e0;
+  for( const auto& m : volumes ) total += m.second;
+  for( const auto& m : volumes )   {
+    double f = m.second / total;
+    inv_x0 += f / m.first->GetRadlen();
+    ec_x0  += f * critical_energy(m.first) / m.first->GetRadlen();
+  }
+  if ( !(inv_x0 > 0e0) && (m_radiationLength <= 0e0 || m_moliereRadius <= 0e0 || m_criticalEnergy <= 0e0) )   {
+    except("+++ Cannot determine the effective medium of region %s. "
+           "Set the properties RadiationLength, MoliereRadius and CriticalEnergy.",
+           region->GetName().c_str());
+  }
+  m_x0 = m_radiationLength > 0e0 ? m_radiationLength : 1e0 / inv_x0;
+  m_ec = m_criticalEnergy  > 0e0 ? m_criticalEnergy  : ec_x0 / inv_x0;
+  m_rm = m_moliereRadius   > 0e0 ? m_moliereRadius   : 21.2052*CLHEP::MeV * m_x0 / m_ec;
+  info("+++ Effective medium of region %s from %ld materials: X0: %.3f mm R_M: %.3f mm E_c: %.3f MeV",
+       region->GetName().c_str(), long(volumes.size()), m_x0/CLHEP::mm, m_rm/CLHEP::mm, m_ec/CLHEP::MeV);
+}
+
+/// Sensitive detector construction callback. Called at "ConstructSDandField()"
+void Geant4FastShowerAction::constructSensitives(Geant4DetectorConstructionContext* /* ctxt */)   {
+  if ( !m_profileLibrary.empty() )   {
+    G4AutoLock protection_lock(&action_mutex);
+    if ( !m_libraryLoaded )   {
+      loadLibrary();
+      m_libraryLoaded = true;
+    }
+  }
+  if ( m_longitudinalStep <= 0e0 || m_maxDepth <= 0e0 || m_spotsPerStep <= 0 )   {
+    except("+++ Invalid shower sampling: LongitudinalStep:%g MaxDepth:%g SpotsPerStep:%d",
+           m_longitudinalStep, m_maxDepth, m_spotsPerStep);
+  }
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(m_regionName, false);
+  if ( !region )   {
+    except("+++ Failed to access the region '%s' for the fast shower model.", m_regionName.c_str());
+  }
+  Geant4Kernel& master = context()->kernel().master();
+  Geant4Kernel& kernel = master.worker(Geant4Kernel::thread_self());
+  {
+    G4AutoLock protection_lock(&action_mutex);
+    if ( !m_mediumDefined )   {
+      defineMedium(region);
+      m_mediumDefined = true;
+    }
+  }
+  auto* model = new Geant4FastShowerModel(this, region);
+  kernel.runAction().callAtEnd(model, &Geant4FastShowerModel::endRun);
+  {
+    G4AutoLock protection_lock(&action_mutex);
+    m_models.emplace_back(model);
+  }
+  info("+++ Attached fast shower model to region %s. Energy range: %.3f - %.3f GeV",
+       m_regionName.c_str(), m_energyMin/CLHEP::GeV, m_energyMax/CLHEP::GeV);
+}
+
+/// Initializing constructor
+Geant4FastShowerModel::Geant4FastShowerModel(const Geant4FastShowerAction* action, G4Region* region)
+  : G4VFastSimulationModel(action->name(), region), m_action(action)
+{
+  m_navigator = new G4Navigator();
+  m_touchable = new G4TouchableHistory();
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4FastShowerModel::~Geant4FastShowerModel()   {
+  delete m_navigator;
+  InstanceCount::decrement(this);
+}
+
+/// End-of-run callback: print the statistics of this model
+void Geant4FastShowerModel::endRun(const G4Run* /* run */)   {
+  m_action->info("+++ %ld showers with %.3f GeV parameterized in %.3f sec [%.3f msec/shower]. "
+                 "%ld of %ld spots with %.3f GeV in sensitive volumes.",
+                 m_numShowers, m_energy/CLHEP::GeV, m_time.count(),
+                 m_numShowers > 0 ? 1e3*m_time.count()/double(m_numShowers) : 0e0,
+                 m_numSensitive, m_numSpots, m_energySensitive/CLHEP::GeV);
+}
+
+/// G4VFastSimulationModel interface: Check if the particle type is handled
+G4bool Geant4FastShowerModel::IsApplicable(const G4ParticleDefinition& particle)   {
+  const auto& p = m_action->m_particles;
+  return find(p.begin(), p.end(), particle.GetParticleName()) != p.end();
+}
+
+/// G4VFastSimulationModel interface: Check if the model should be triggered
+G4bool Geant4FastShowerModel::ModelTrigger(const G4FastTrack& track)   {
+  double energy = track.GetPrimaryTrack()->GetKineticEnergy();
+  return energy >= m_action->m_energyMin && energy <= m_action->m_energyMax;
+}
+
+/// Deposit one energy spot
+void Geant4FastShowerModel::deposit(double energy, const G4ThreeVector& position, const G4FastTrack& track)   {
+  m_navigator->LocateGlobalPointAndUpdateTouchableHandle(position, G4ThreeVector(0,0,0), m_touchable, true);
+  G4VPhysicalVolume* pv = m_touchable->GetVolume();
+  ++m_numSpots;
+  if ( pv )   {
+    auto* sd = dynamic_cast<G4VGFlashSensitiveDetector*>(pv->GetLogicalVolume()->GetSensitiveDetector());
+    if ( sd )   {
+      GFlashEnergySpot energy_spot(energy, position);
+      G4GFlashSpot spot(&energy_spot, &track, m_touchable);
+      sd->Hit(&spot);
+      ++m_numSensitive;
+      m_energySensitive += energy;
+    }
+  }
+}
+
+/// G4VFastSimulationModel interface: Deposit the parameterized shower
+void Geant4FastShowerModel::DoIt(const G4FastTrack& track, G4FastStep& step)   {
+  auto start = chrono::steady_clock::now();
+  const G4Track* trk    = track.GetPrimaryTrack();
+  double         energy = trk->GetKineticEnergy();
+  double         x0     = m_action->m_x0;
+  double         rm     = m_action->m_rm;
+
+  step.KillPrimaryTrack();
+  step.ProposePrimaryTrackPathLength(0e0);
+  step.ProposeTotalEnergyDeposited(energy);
+
+  m_navigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()->
+                              GetNavigatorForTracking()->GetWorldVolume());
+  Geant4FastShowerProfile prof = m_action->profile(energy, m_action->m_ec, trk->GetDefinition() == G4Gamma::Definition());
+
+  const G4ThreeVector& origin = trk->GetPosition();
+  G4ThreeVector dir   = trk->GetMomentumDirection().unit();
+  G4ThreeVector orth1 = dir.orthogonal().unit();
+  G4ThreeVector orth2 = dir.cross(orth1);
+  double dt      = m_action->m_longitudinalStep;
+  int    nsteps  = int(ceil(m_action->m_maxDepth / dt));
+  int    nspots  = m_action->m_spotsPerStep;
+  vector<double> weights(nsteps);
+  double sum = 0e0;
+  for( int i = 0; i < nsteps; ++i )   {
+    double t = (double(i) + 0.5) * dt;
+    weights[i] = exp((prof.alpha - 1e0) * log(t) - prof.beta * t);
+    sum += weights[i];
+  }
+  for( int i = 0; sum > 0e0 && i < nsteps; ++i )   {
+    double e_spot = energy * weights[i] / sum / double(nspots);
+    if ( !(e_spot > 0e0) ) continue;
+    for( int j = 0; j < nspots; ++j )   {
+      double t   = (double(i) + G4UniformRand()) * dt * x0;
+      double r   = -log(1e0 - G4UniformRand()) * rm * (G4UniformRand() < prof.pcore ? prof.rcore : prof.rtail);
+      double phi = CLHEP::twopi * G4UniformRand();
+      deposit(e_spot, origin + t * dir + r * (cos(phi) * orth1 + sin(phi) * orth2), track);
+    }
+  }
+  ++m_numShowers;
+  m_energy += energy;
+  m_time   += chrono::steady_clock::now() - start;
+}
@@ -23,6 +23,7 @@
 
 // Geant4 include files
 #include "G4VSensitiveDetector.hh"
+#include "G4VGFlashSensitiveDetector.hh"
 #include "G4Event.hh"
 #include "G4Run.hh"
 
@@ -65,6 +66,7 @@ namespace dd4hep {
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4SensDet : virtual public G4VSensitiveDetector,
+                          virtual public G4VGFlashSensitiveDetector,
                           virtual public G4VSDFilter,
                           virtual public Geant4ActionSD,
                           virtual public RefCountedSequence<Geant4SensDetActionSequence>
@@ -128,6 +130,9 @@ namespace dd4hep {
       /// Method for generating hit(s) using the information of G4Step object.
       virtual G4bool ProcessHits(G4Step* step,G4TouchableHistory* hist)
       {  return m_sequence->process(step,hist);                         }
+      /// GFLASH interface: Method for generating hit(s) using the information of G4GFlashSpot object.
+      virtual G4bool ProcessHits(G4GFlashSpot* spot,G4TouchableHistory* hist)
+      {  return m_sequence->processGFlash(spot,hist);                   }
       /// G4VSensitiveDetector interface: Method invoked if the event was aborted.
       virtual void clear()
       {  m_sequence->clear();                                           }
@@ -79,6 +79,11 @@ namespace dd4hep {
       virtual bool operator()(const G4GFlashSpot* spot) const  final   {
 	return !isSameType(getTrack(spot));
       }
+      /// Describe the filter by particle type requirements
+      virtual bool fold(Geant4FilterCuts& cuts) const  final   {
+	cuts.reject.emplace_back(definition());
+	return true;
+      }
     };
 
     /// Geant4 sensitive detector filter implementing a particle selector
@@ -100,6 +105,11 @@ namespace dd4hep {
       virtual bool operator()(const G4GFlashSpot* spot) const  final   {
 	return isSameType(getTrack(spot));
       }
+      /// Describe the filter by particle type requirements
+      virtual bool fold(Geant4FilterCuts& cuts) const  final   {
+	cuts.select.emplace_back(definition());
+	return true;
+      }
     };
 
     /// Geant4 sensitive detector filter implementing a Geantino rejector
@@ -121,6 +131,8 @@ namespace dd4hep {
       virtual bool operator()(const G4GFlashSpot* spot) const  final   {
 	return !isGeantino(getTrack(spot));
       }
+      /// Describe the filter by particle type requirements
+      virtual bool fold(Geant4FilterCuts& cuts) const  final;
     };
 
     /// Geant4 sensitive detector filter implementing an energy cut.
@@ -145,6 +157,11 @@ namespace dd4hep {
       virtual bool operator()(const G4GFlashSpot* spot) const  final  {
 	return spot->GetEnergySpot()->GetEnergy() > m_energyCut;
       }
+      /// Describe the filter by the energy deposit requirement
+      virtual bool fold(Geant4FilterCuts& cuts) const  final  {
+	cuts.energyDeposit = m_energyCut;
+	return true;
+      }
     };
   }
 }
@@ -223,6 +240,13 @@ GeantinoRejectFilter::~GeantinoRejectFilter() {
   InstanceCount::decrement(this);
 }
 
+/// Describe the filter by particle type requirements
+bool GeantinoRejectFilter::fold(Geant4FilterCuts& cuts) const   {
+  cuts.reject.emplace_back(G4ChargedGeantino::Definition());
+  cuts.reject.emplace_back(G4Geantino::Definition());
+  return true;
+}
+
 /// Constructor.
 ParticleRejectFilter::ParticleRejectFilter(Geant4Context* c, const std::string& n)
   : ParticleFilter(c,n) {
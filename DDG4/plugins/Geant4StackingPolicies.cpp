@@ -0,0 +1,391 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4STACKINGPOLICIES_H
+#define DDG4_GEANT4STACKINGPOLICIES_H
+
+// Framework include files
+#include "DDG4/Geant4StackingAction.h"
+
+// C/C++ include files
+#include <map>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+// Forward declarations
+class G4Region;
+class G4ParticleDefinition;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Stacking policy: classify secondary tracks to the urgent or the waiting stack
+    /**
+     *  Secondaries of the particle types listed in "WaitingParticles" and
+     *  secondaries with a kinetic energy below "WaitingEnergy" are pushed to
+     *  the waiting stack. They are only tracked once the urgent stack is empty.
+     *  Particle types listed in "UrgentParticles" are never deferred.
+     *  Primary tracks are never classified.
+     *
+     *  Properties:
+     *  - WaitingParticles: Names of the particle types deferred to the waiting stack
+     *  - UrgentParticles:  Names of the particle types which are always tracked urgently
+     *  - WaitingEnergy:    Secondaries below this kinetic energy are deferred. 0: disabled
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4StackClassifier : public Geant4StackingAction  {
+    protected:
+      typedef std::unordered_set<const G4ParticleDefinition*> Particles;
+      /// Property: Names of the particle types deferred to the waiting stack
+      std::vector<std::string> m_waitingNames;
+      /// Property: Names of the particle types which are always tracked urgently
+      std::vector<std::string> m_urgentNames;
+      /// Property: Secondaries below this kinetic energy are deferred
+      double    m_waitingEnergy  { 0e0 };
+      /// Resolved particle definitions of the waiting particles
+      Particles m_waiting;
+      /// Resolved particle definitions of the urgent particles
+      Particles m_urgent;
+      /// Flag if the particle names are resolved
+      bool      m_resolved       { false };
+      /// Number of deferred tracks
+      long      m_numDeferred    { 0 };
+
+      /// Define standard assignments and constructors
+      DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4StackClassifier);
+    public:
+      /// Standard constructor
+      Geant4StackClassifier(Geant4Context* ctxt, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4StackClassifier();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(G4StackManager* mgr, const G4Track* track)  override;
+    };
+
+    /// Stacking policy: kill low energy secondaries in selected regions
+    /**
+     *  Secondaries created in one of the regions listed in "EnergyCuts" with a
+     *  kinetic energy below the cut of the region are killed before tracking.
+     *
+     *  To keep the MC truth consistent, tracks which may be required by the
+     *  MC truth handler of the event (see Geant4MonteCarloTruth::requiresTrack)
+     *  are never killed. With the Geant4ParticleHandler these are
+     *  primaries, tracks above its "MinimalKineticEnergy", products of its
+     *  "SaveProcesses" and all tracks if "KeepAllParticles" is set.
+     *  The energy of killed tracks is lost. It is accumulated per region and
+     *  printed at the end.
+     *
+     *  Properties:
+     *  - EnergyCuts: Map region name -> kinetic energy cut
+     *  - Particles:  Names of the particle types subject to the cuts. If empty: all
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4RegionTrackKiller : public Geant4StackingAction  {
+    protected:
+      /// Killing statistics of one region
+      struct RegionCut  {
+        double cut      { 0e0 };
+        long   killed   { 0 };
+        double energy   { 0e0 };
+      };
+      /// Property: Map region name -> kinetic energy cut
+      std::map<std::string, double> m_energyCuts;
+      /// Property: Names of the particle types subject to the cuts
+      std::vector<std::string>      m_particleNames;
+      /// Resolved regions
+      std::unordered_map<const G4Region*, RegionCut> m_regions;
+      /// Resolved particle definitions
+      std::unordered_set<const G4ParticleDefinition*> m_particles;
+      /// Flag if the region and particle names are resolved
+      bool                          m_resolved  { false };
+      /// Number of tracks protected by the MC truth handler
+      long                          m_protected { 0 };
+
+      /// Resolve the region and particle names
+      void resolve();
+      /// Define standard assignments and constructors
+      DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4RegionTrackKiller);
+    public:
+      /// Standard constructor
+      Geant4RegionTrackKiller(Geant4Context* ctxt, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4RegionTrackKiller();
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(G4StackManager* mgr, const G4Track* track)  override;
+    };
+
+    /// Stacking policy: bound the number of tracks on the urgent stack
+    /**
+     *  If the urgent stack holds more than "MaxTracks" tracks, new secondaries
+     *  are deferred to the waiting stack. Geant4 transfers the waiting tracks
+     *  to the urgent stack once it is empty, hence all tracks are simulated
+     *  within the same event and the MC truth is unaffected.
+     *
+     *  Note: The action bounds the urgent stack, not the memory. Deferred tracks
+     *  are still stored on the waiting stack, so the total number of tracks in
+     *  flight is not reduced. Only killing tracks (Geant4RegionTrackKiller) saves memory.
+     *
+     *  The action monitors the resources: the peak stack occupancy, the number of
+     *  deferred tracks, the event throughput and the peak resident set size
+     *  of the process are printed at the end.
+     *
+     *  Properties:
+     *  - MaxTracks: Maximal number of tracks on the urgent stack. 0: no bound, only monitoring
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4StackBudget : public Geant4StackingAction  {
+    protected:
+      typedef std::chrono::steady_clock clock_t;
+      /// Property: Maximal number of tracks on the urgent stack
+      long  m_maxTracks      { 0 };
+      /// Number of deferred tracks
+      long  m_numDeferred    { 0 };
+      /// Number of classified tracks
+      long  m_numTracks      { 0 };
+      /// Peak number of tracks on the urgent stack
+      long  m_peakUrgent     { 0 };
+      /// Peak number of tracks on all stacks
+      long  m_peakTotal      { 0 };
+      /// Number of events
+      long  m_numEvents      { 0 };
+      /// Start of the first event
+      clock_t::time_point m_start;
+
+      /// Define standard assignments and constructors
+      DDG4_DEFINE_ACTION_CONSTRUCTORS(Geant4StackBudget);
+    public:
+      /// Standard constructor
+      Geant4StackBudget(Geant4Context* ctxt, const std::string& name);
+      /// Default destructor
+      virtual ~Geant4StackBudget();
+      /// Preparation callback
+      virtual void prepare()  override;
+      /// Classify a new track
+      virtual TrackClassification classifyNewTrack(G4StackManager* mgr, const G4Track* track)  override;
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4STACKINGPOLICIES_H
+
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/InstanceCount.h"
+#include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4MonteCarloTruth.h"
+
+// Geant4 include files
+#include "G4Track.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4StackManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleTable.hh"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+// C/C++ include files
+#include <sys/resource.h>
+
+using namespace std;
+using namespace dd4hep::sim;
+
+namespace {
+  /// Resolve a set of particle names to their definitions
+  template <typename T> void resolve_particles(const Geant4Action* action, const vector<string>& names, T& defs)   {
+    G4ParticleTable* table = G4ParticleTable::GetParticleTable();
+    for( const auto& n : names )   {
+      G4ParticleDefinition* def = table->FindParticle(n);
+      if ( !def )   {
+        action->except("+++ Unknown particle type: %s", n.c_str());
+      }
+      defs.insert(def);
+    }
+  }
+}
+
+/// Standard constructor
+Geant4StackClassifier::Geant4StackClassifier(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingAction(ctxt, nam)
+{
+  declareProperty("WaitingParticles", m_waitingNames);
+  declareProperty("UrgentParticles",  m_urgentNames);
+  declareProperty("WaitingEnergy",    m_waitingEnergy);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4StackClassifier::~Geant4StackClassifier()  {
+  info("+++ Deferred %ld tracks to the waiting stack.", m_numDeferred);
+  InstanceCount::decrement(this);
+}
+
+/// Classify a new track
+TrackClassification Geant4StackClassifier::classifyNewTrack(G4StackManager*, const G4Track* track)  {
+  if ( !m_resolved )   {
+    resolve_particles(this, m_waitingNames, m_waiting);
+    resolve_particles(this, m_urgentNames,  m_urgent);
+    m_resolved = true;
+  }
+  if ( track->GetParentID() == 0 )   {
+    return TrackClassification();
+  }
+  const G4ParticleDefinition* def = track->GetDefinition();
+  if ( m_urgent.find(def) != m_urgent.end() )   {
+    return TrackClassification(fUrgent);
+  }
+  if ( m_waiting.find(def) != m_waiting.end() ||
+       (m_waitingEnergy > 0e0 && track->GetKineticEnergy() < m_waitingEnergy) )   {
+    ++m_numDeferred;
+    return TrackClassification(fWaiting);
+  }
+  return TrackClassification();
+}
+
+/// Standard constructor
+Geant4RegionTrackKiller::Geant4RegionTrackKiller(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingAction(ctxt, nam)
+{
+  declareProperty("EnergyCuts", m_energyCuts);
+  declareProperty("Particles",  m_particleNames);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4RegionTrackKiller::~Geant4RegionTrackKiller()  {
+  for( const auto& r : m_regions )   {
+    info("+++ Region %-24s cut: %8.3f MeV killed %10ld tracks with %12.3f MeV kinetic energy.",
+         r.first->GetName().c_str(), r.second.cut/CLHEP::MeV, r.second.killed, r.second.energy/CLHEP::MeV);
+  }
+  info("+++ %ld tracks below the cuts were protected by the MC truth handler.", m_protected);
+  InstanceCount::decrement(this);
+}
+
+/// Resolve the region and particle names
+void Geant4RegionTrackKiller::resolve()   {
+  G4RegionStore* store = G4RegionStore::GetInstance();
+  for( const auto& c : m_energyCuts )   {
+    G4Region* region = store->GetRegion(c.first, false);
+    if ( !region )   {
+      except("+++ Unknown region: %s", c.first.c_str());
+    }
+    m_regions[region].cut = c.second;
+    info("+++ Kill secondaries below %8.3f MeV in region %s", c.second/CLHEP::MeV, c.first.c_str());
+  }
+  resolve_particles(this, m_particleNames, m_particles);
+  m_resolved = true;
+}
+
+/// Classify a new track
+TrackClassification Geant4RegionTrackKiller::classifyNewTrack(G4StackManager*, const G4Track* track)  {
+  if ( !m_resolved )   {
+    resolve();
+  }
+  const G4VPhysicalVolume* pv = track->GetVolume();
+  if ( !pv || track->GetParentID() == 0 )   {
+    return TrackClassification();
+  }
+  auto i = m_regions.find(pv->GetLogicalVolume()->GetRegion());
+  if ( i == m_regions.end() )   {
+    return TrackClassification();
+  }
+  double kine = track->GetKineticEnergy();
+  if ( kine >= i->second.cut )   {
+    return TrackClassification();
+  }
+  if ( !m_particles.empty() && m_particles.find(track->GetDefinition()) == m_particles.end() )   {
+    return TrackClassification();
+  }
+  Geant4MonteCarloTruth* truth = context()->event().extension<Geant4MonteCarloTruth>(false);
+  if ( truth && truth->requiresTrack(track) )   {
+    ++m_protected;
+    return TrackClassification();
+  }
+  ++i->second.killed;
+  i->second.energy += kine;
+  return TrackClassification(fKill);
+}
+
+/// Standard constructor
+Geant4StackBudget::Geant4StackBudget(Geant4Context* ctxt, const string& nam)
+  : Geant4StackingAction(ctxt, nam)
+{
+  declareProperty("MaxTracks", m_maxTracks);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4StackBudget::~Geant4StackBudget()  {
+  struct rusage usage;
+  double elapsed = 0e0;
+  if ( m_numEvents > 0 )   {
+    elapsed = chrono::duration<double>(clock_t::now() - m_start).count();
+  }
+  ::getrusage(RUSAGE_SELF, &usage);
+  always("+++ Stack budget %ld: deferred %ld of %ld tracks. Peak stack occupancy: %ld urgent %ld total.",
+         m_maxTracks, m_numDeferred, m_numTracks, m_peakUrgent, m_peakTotal);
+  always("+++ Processed %ld events in %.3f seconds [%.3f events/sec]. Peak resident set size: %.1f MB",
+         m_numEvents, elapsed, elapsed > 0e0 ? double(m_numEvents)/elapsed : 0e0,
+         double(usage.ru_maxrss)/1024e0);
+  InstanceCount::decrement(this);
+}
+
+/// Preparation callback
+void Geant4StackBudget::prepare()   {
+  if ( 0 == m_numEvents )   {
+    m_start = clock_t::now();
+  }
+  ++m_numEvents;
+}
+
+/// Classify a new track
+TrackClassification Geant4StackBudget::classifyNewTrack(G4StackManager* mgr, const G4Track* track)  {
+  long urgent = mgr->GetNUrgentTrack();
+  long total  = mgr->GetNTotalTrack();
+  ++m_numTracks;
+  m_peakUrgent = max(m_peakUrgent, urgent);
+  m_peakTotal  = max(m_peakTotal,  total);
+  if ( m_maxTracks > 0 && urgent >= m_maxTracks && track->GetParentID() != 0 )   {
+    ++m_numDeferred;
+    return TrackClassification(fWaiting);
+  }
+  return TrackClassification();
+}
+
+#include "DDG4/Factories.h"
+DECLARE_GEANT4ACTION(Geant4StackClassifier)
+DECLARE_GEANT4ACTION(Geant4RegionTrackKiller)
+DECLARE_GEANT4ACTION(Geant4StackBudget)
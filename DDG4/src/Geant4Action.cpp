@@ -149,6 +149,15 @@ void Geant4Action::enableUI()   {
 void Geant4Action::configureFiber(Geant4Context* /* thread_context */)   {
 }
 
+/// Create a private copy of a shared action for a worker thread
+Geant4Action* Geant4Action::clone(Geant4Context* /* thread_context */)  const   {
+  return nullptr;
+}
+
+/// Merge the results of a worker copy created by clone() at the end of each run
+void Geant4Action::merge(Geant4Action& /* worker_copy */)   {
+}
+
 /// Support for messages with variable output level using output level
 void Geant4Action::print(const char* fmt, ...) const   {
   int level = max(int(outputLevel()),(int)VERBOSE);
@@ -0,0 +1,237 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DDG4/Geant4Action.h"
+#include "DDG4/Geant4ActionProfiler.h"
+
+// C/C++ include files
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+using namespace dd4hep::sim;
+
+namespace {
+
+  /// Accumulated calls of one callback type of one action
+  struct Entry  {
+    string      name;
+    const char* callback;
+    long        calls      { 0 };
+    long        run_calls  { 0 };
+    double      time       { 0e0 };  // [ns]
+    double      run_time   { 0e0 };  // [ns]
+  };
+
+  /// Single call record for the Chrome trace
+  struct TraceRecord  {
+    size_t  entry;
+    int64_t start;   // [ns] since the enable call
+    int64_t stop;    // [ns] since the enable call
+  };
+
+  /// Hash of the (action, callback) pair
+  struct KeyHash  {
+    size_t operator()(const pair<const Geant4Action*, const char*>& k)  const  {
+      return hash<const void*>()(k.first) ^ (hash<const void*>()(k.second) << 1);
+    }
+  };
+
+  /// Instrumentation data of one thread
+  struct ThreadData  {
+    int                 id;
+    long                runs  { 0 };
+    vector<Entry>       entries;
+    vector<TraceRecord> trace;
+    long                lost  { 0 };
+    unordered_map<pair<const Geant4Action*, const char*>, size_t, KeyHash> index;
+    ThreadData(int i) : id(i)  {}
+  };
+
+  mutex                          s_mutex;
+  vector<shared_ptr<ThreadData> > s_threads;
+  long                           s_traceLimit = 0;
+  Geant4ActionProfiler::clock_t::time_point s_epoch;
+
+  /// Access the instrumentation data of the calling thread
+  ThreadData& thread_data()  {
+    thread_local shared_ptr<ThreadData> data;
+    if ( !data )   {
+      lock_guard<mutex> lock(s_mutex);
+      data = make_shared<ThreadData>(int(s_threads.size()));
+      s_threads.emplace_back(data);
+    }
+    return *data;
+  }
+
+  /// Print a table of (name, callback) -> (calls, time)
+  void print_table(const char* title, const map<pair<string,string>, pair<long,double> >& table)  {
+    vector<pair<pair<string,string>, pair<long,double> > > rows(table.begin(), table.end());
+    double total = 0e0;
+    for( const auto& r : rows ) total += r.second.second;
+    sort(rows.begin(), rows.end(), [](const auto& a, const auto& b)  {
+        return a.second.second > b.second.second;
+      });
+    dd4hep::printout(dd4hep::ALWAYS, "Geant4ActionProfiler", "+++ %s", title);
+    dd4hep::printout(dd4hep::ALWAYS, "Geant4ActionProfiler", "+++ %-32s %-16s %12s %12s %12s %8s",
+                     "Action", "Callback", "Calls", "Total [ms]", "Mean [us]", "Fraction");
+    for( const auto& r : rows )   {
+      long   calls = r.second.first;
+      double time  = r.second.second;
+      dd4hep::printout(dd4hep::ALWAYS, "Geant4ActionProfiler", "+++ %-32s %-16s %12ld %12.3f %12.3f %7.1f%%",
+                       r.first.first.c_str(), r.first.second.c_str(), calls, time/1e6,
+                       calls > 0 ? time/1e3/double(calls) : 0e0, total > 0e0 ? 100e0*time/total : 0e0);
+    }
+  }
+
+  /// Escape a string for the use in JSON output
+  string json_escape(const string& s)  {
+    string r;
+    for( char c : s )   {
+      if ( c == '"' || c == '\\' )   {
+        r += '\\';
+        r += c;
+      }
+      else if ( (unsigned char)c < 0x20 )   {
+        char text[8];
+        ::snprintf(text, sizeof(text), "\\u%04x", (unsigned int)(unsigned char)c);
+        r += text;
+      }
+      else   {
+        r += c;
+      }
+    }
+    return r;
+  }
+}
+
+/// Flag to enable the instrumentation
+bool Geant4ActionProfiler::s_enabled = false;
+
+/// Enable the instrumentation. Trace records are only kept if trace_limit > 0
+void Geant4ActionProfiler::enable(bool value, long trace_limit)   {
+  lock_guard<mutex> lock(s_mutex);
+  s_enabled    = value;
+  s_traceLimit = value ? trace_limit : 0;
+  s_epoch      = clock_t::now();
+}
+
+/// Account a single callback of an action
+void Geant4ActionProfiler::record(const Geant4Action* action, const char* callback,
+                                  clock_t::time_point start, clock_t::time_point stop)
+{
+  ThreadData& d = thread_data();
+  auto   key = make_pair(action, callback);
+  auto   i   = d.index.find(key);
+  size_t idx = 0;
+  if ( i == d.index.end() )   {
+    idx = d.entries.size();
+    d.entries.emplace_back();
+    d.entries.back().name     = action->name();
+    d.entries.back().callback = callback;
+    d.index.emplace(key, idx);
+  }
+  else   {
+    idx = i->second;
+  }
+  double ns = double(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+  Entry& e = d.entries[idx];
+  ++e.calls;
+  ++e.run_calls;
+  e.time     += ns;
+  e.run_time += ns;
+  if ( s_traceLimit > 0 )   {
+    if ( long(d.trace.size()) < s_traceLimit )   {
+      d.trace.emplace_back(TraceRecord {
+          idx,
+          chrono::duration_cast<chrono::nanoseconds>(start - s_epoch).count(),
+          chrono::duration_cast<chrono::nanoseconds>(stop  - s_epoch).count() });
+    }
+    else   {
+      ++d.lost;
+    }
+  }
+}
+
+/// Print the table of the calling thread accumulated during the current run and reset it
+void Geant4ActionProfiler::endRun()   {
+  ThreadData& d = thread_data();
+  map<pair<string,string>, pair<long,double> > table;
+  for( auto& e : d.entries )   {
+    if ( e.run_calls > 0 )   {
+      auto& t = table[make_pair(e.name, string(e.callback))];
+      t.first  += e.run_calls;
+      t.second += e.run_time;
+    }
+    e.run_calls = 0;
+    e.run_time  = 0e0;
+  }
+  char title[128];
+  ::snprintf(title, sizeof(title), "Action profile of run %ld [thread %d]:", d.runs, d.id);
+  print_table(title, table);
+  ++d.runs;
+}
+
+/// Print the summary of all threads
+void Geant4ActionProfiler::printSummary()   {
+  lock_guard<mutex> lock(s_mutex);
+  map<pair<string,string>, pair<long,double> > table;
+  for( const auto& d : s_threads )   {
+    for( const auto& e : d->entries )   {
+      auto& t = table[make_pair(e.name, string(e.callback))];
+      t.first  += e.calls;
+      t.second += e.time;
+    }
+  }
+  char title[128];
+  ::snprintf(title, sizeof(title), "Action profile summary of %ld thread(s):", long(s_threads.size()));
+  print_table(title, table);
+}
+
+/// Write the trace records of all threads in the Chrome trace event format
+bool Geant4ActionProfiler::writeTrace(const string& file_name)   {
+  lock_guard<mutex> lock(s_mutex);
+  FILE* file = ::fopen(file_name.c_str(), "w");
+  if ( !file )   {
+    dd4hep::printout(dd4hep::ERROR, "Geant4ActionProfiler",
+                     "+++ Failed to open trace file %s", file_name.c_str());
+    return false;
+  }
+  long num_records = 0, num_lost = 0;
+  const char* sep = "";
+  ::fprintf(file, "{\"traceEvents\":[");
+  for( const auto& d : s_threads )   {
+    for( const auto& t : d->trace )   {
+      const Entry& e = d->entries[t.entry];
+      ::fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                sep, json_escape(e.name).c_str(), e.callback, d->id,
+                double(t.start)/1e3, double(t.stop - t.start)/1e3);
+      sep = ",";
+    }
+    num_records += long(d->trace.size());
+    num_lost    += d->lost;
+  }
+  ::fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+  ::fclose(file);
+  dd4hep::printout(dd4hep::INFO, "Geant4ActionProfiler",
+                   "+++ Wrote %ld trace records to %s [%ld records dropped]",
+                   num_records, file_name.c_str(), num_lost);
+  return true;
+}
@@ -142,12 +142,23 @@ void Geant4EventActionSequence::adopt(Geant4EventAction* action) {
 
 /// Pre-track action callback
 void Geant4EventActionSequence::begin(const G4Event* event)   {
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("begin-event", &Geant4EventAction::begin, event);
+    Geant4ActionProfiler::call(this, "begin-event-callbacks", m_begin, event);
+    return;
+  }
   m_actors(&Geant4EventAction::begin, event);
   m_begin(event);
 }
 
 /// Post-track action callback
 void Geant4EventActionSequence::end(const G4Event* event)   {
+  if ( Geant4ActionProfiler::enabled() )  {
+    Geant4ActionProfiler::call(this, "end-event-callbacks", m_end, event);
+    m_actors.profile("end-event", &Geant4EventAction::end, event);
+    Geant4ActionProfiler::call(this, "end-event-callbacks", m_final, event);
+    return;
+  }
   m_end(event);
   m_actors(&Geant4EventAction::end, event);
   m_final(event);
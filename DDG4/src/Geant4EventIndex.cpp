@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4EventIndex.h"
+
+// C/C++ include files
+#include <fstream>
+#include <limits>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace dd4hep::sim;
+
+namespace  {
+  /// Identifier of the index file format
+  const char* s_magic = "DD4hep-event-index 1";
+}
+
+/// Initializing constructor
+Geant4EventIndex::Geant4EventIndex(const string& input, const string& tag)
+  : m_input(input), m_tag(tag)
+{
+  m_offsets.emplace_back(0);
+}
+
+/// Signature of the input file: size and modification time
+bool Geant4EventIndex::signature(long& size, long& mtime)  const   {
+  struct stat st;
+  if ( ::stat(m_input.c_str(), &st) != 0 ) return false;
+  size  = long(st.st_size);
+  mtime = long(st.st_mtime);
+  return true;
+}
+
+/// Number of events indexed so far
+size_t Geant4EventIndex::size()  const   {
+  // If complete, the last offset is the end of the input
+  return m_complete ? m_offsets.size() - 1 : m_offsets.size();
+}
+
+/// Load the index file. Returns false if it is missing or does not match the input
+bool Geant4EventIndex::load()   {
+  long   size = 0, mtime = 0, in_size = 0, in_mtime = 0;
+  size_t num_offsets = 0;
+  string magic, tag;
+  ifstream in(fileName());
+  if ( !in.good() || !signature(size, mtime) )
+    return false;
+  getline(in, magic);
+  getline(in, tag);
+  in >> in_size >> in_mtime >> num_offsets;
+  if ( !in.good() || magic != s_magic || tag != m_tag ||
+       in_size != size || in_mtime != mtime || num_offsets == 0 )
+    return false;
+  vector<offset_t> offsets(num_offsets);
+  for( auto& o : offsets ) in >> o;
+  if ( in.fail() || offsets.front() != 0 || offsets.back() > size )
+    return false;
+  m_offsets  = std::move(offsets);
+  m_complete = true;
+  return true;
+}
+
+/// Save the complete index to the index file
+bool Geant4EventIndex::save()  const   {
+  long size = 0, mtime = 0;
+  if ( !m_complete || !signature(size, mtime) )
+    return false;
+  // Write a temporary file first: several jobs may create the same index
+  string tmp = fileName() + "." + to_string(::getpid());
+  {
+    ofstream out(tmp);
+    if ( !out.good() ) return false;
+    out << s_magic << "\n" << m_tag << "\n"
+        << size << " " << mtime << " " << m_offsets.size() << "\n";
+    for( offset_t o : m_offsets ) out << o << "\n";
+    if ( !out.good() )   {
+      out.close();
+      ::remove(tmp.c_str());
+      return false;
+    }
+  }
+  if ( ::rename(tmp.c_str(), fileName().c_str()) != 0 )   {
+    ::remove(tmp.c_str());
+    return false;
+  }
+  return true;
+}
+
+/// Position the stream at the start of an event. Extends the index if necessary
+bool Geant4EventIndex::seek(istream& in, int event_number, const skipper_t& skip)   {
+  if ( event_number < 0 )
+    return false;
+  if ( size_t(event_number) >= m_offsets.size() && !m_complete )   {
+    in.clear();
+    in.seekg(m_offsets.back());
+    while ( size_t(event_number) >= m_offsets.size() )   {
+      if ( !in.good() || !skip(in) )   {
+        m_complete = true;
+        break;
+      }
+      offset_t pos = in.tellg();
+      if ( pos < 0 )   {
+        // The last event is not terminated by a newline
+        in.clear();
+        in.seekg(0, ios::end);
+        m_offsets.emplace_back(in.tellg());
+        m_complete = true;
+        break;
+      }
+      m_offsets.emplace_back(pos);
+    }
+  }
+  if ( size_t(event_number) >= size() )
+    return false;
+  in.clear();
+  in.seekg(m_offsets[event_number]);
+  return in.good();
+}
+
+/// Index the entire input and save the index file. The stream position is restored
+bool Geant4EventIndex::create(istream& in, const skipper_t& skip)   {
+  in.clear();
+  offset_t pos = in.tellg();
+  seek(in, numeric_limits<int>::max(), skip);
+  in.clear();
+  in.seekg(pos);
+  return save();
+}
@@ -257,6 +257,11 @@ namespace dd4hep {
       virtual void PrepareNewEvent()  final  {
         m_sequence->prepare();
       }
+      /// Classification of a new track
+      virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track)  final  {
+        TrackClassification ret = m_sequence->classifyNewTrack(stackManager, track);
+        return ret.isValid() ? ret.value : G4UserStackingAction::ClassifyNewTrack(track);
+      }
     };
 
 
@@ -373,6 +378,8 @@ namespace dd4hep {
     void Geant4UserRunAction::EndOfRunAction(const G4Run* run) {
       if ( m_sequence ) m_sequence->end(run); // Action not mandatory
       kernel().executePhase("end-run",(const void**)&run);
+      kernel().mergeActionClones();
+      if ( Geant4ActionProfiler::enabled() ) Geant4ActionProfiler::endRun();
       destroyClientContext(run);
     }
 
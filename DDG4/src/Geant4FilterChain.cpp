@@ -0,0 +1,146 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include "DDG4/Geant4FilterChain.h"
+#include "DDG4/Geant4SensDetAction.h"
+
+// Geant4 include files
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4GFlashSpot.hh>
+
+// C/C++ include files
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+using namespace dd4hep::sim;
+
+/// Default constructor: accept everything
+Geant4FilterCuts::Geant4FilterCuts() : energyDeposit(-HUGE_VAL)  {
+}
+
+/// Build the chain from a list of filters. Fold the filters if requested
+void Geant4FilterChain::compile(const vector<Geant4Filter*>& filters, bool fold)   {
+  m_entries.clear();
+  m_called.clear();
+  m_particles.clear();
+  m_lastParticle  = nullptr;
+  m_lastResult    = -1;
+  m_energyCut     = -HUGE_VAL;
+  m_energyEntry   = -1;
+  m_haveParticles = false;
+  m_calls         = 0;
+  m_entries.resize(filters.size());
+  for( size_t i = 0; i < filters.size(); ++i )   {
+    Entry& e = m_entries[i];
+    e.filter = filters[i];
+    e.folded = fold && e.filter->fold(e.cuts);
+    if ( !e.folded )   {
+      m_called.emplace_back(int(i));
+      continue;
+    }
+    if ( !e.cuts.select.empty() || !e.cuts.reject.empty() )   {
+      m_haveParticles = true;
+    }
+    if ( e.cuts.energyDeposit > m_energyCut )   {
+      m_energyCut   = e.cuts.energyDeposit;
+      m_energyEntry = int(i);
+    }
+  }
+}
+
+/// Number of folded filters
+size_t Geant4FilterChain::numFolded()  const   {
+  return m_entries.size() - m_called.size();
+}
+
+/// Compute the index of the folded entry rejecting the particle type or -1
+int Geant4FilterChain::particleResult(const G4ParticleDefinition* def)  const   {
+  if ( def == m_lastParticle )   {
+    return m_lastResult;
+  }
+  auto i = m_particles.find(def);
+  int result = -1;
+  if ( i != m_particles.end() )   {
+    result = i->second;
+  }
+  else   {
+    for( size_t j = 0; j < m_entries.size() && result < 0; ++j )   {
+      const Entry& e = m_entries[j];
+      if ( !e.folded ) continue;
+      const auto& sel = e.cuts.select;
+      const auto& rej = e.cuts.reject;
+      if ( !sel.empty() && find(sel.begin(), sel.end(), def) == sel.end() )
+        result = int(j);
+      else if ( find(rej.begin(), rej.end(), def) != rej.end() )
+        result = int(j);
+    }
+    m_particles.emplace(def, result);
+  }
+  m_lastParticle = def;
+  m_lastResult   = result;
+  return result;
+}
+
+/// Evaluate the chain given the particle type and the energy deposit
+template <typename T> bool Geant4FilterChain::_accept(const T* object, const G4ParticleDefinition* def, double edep)  const  {
+  int rejected = -1;
+  ++m_calls;
+  if ( m_haveParticles )   {
+    rejected = particleResult(def);
+  }
+  if ( rejected < 0 && m_energyEntry >= 0 && !(edep > m_energyCut) )   {
+    rejected = m_energyEntry;
+  }
+  for( size_t i = 0; i < m_called.size() && rejected < 0; ++i )   {
+    if ( !(*m_entries[m_called[i]].filter)(object) )
+      rejected = m_called[i];
+  }
+  if ( rejected >= 0 )   {
+    ++m_entries[rejected].rejected;
+    return false;
+  }
+  return true;
+}
+
+/// Check if the step passes all filters
+bool Geant4FilterChain::accept(const G4Step* step)  const   {
+  if ( m_called.size() == m_entries.size() )
+    return _accept(step, nullptr, 0e0);
+  return _accept(step, step->GetTrack()->GetDefinition(), step->GetTotalEnergyDeposit());
+}
+
+/// GFLASH interface: Check if the spot passes all filters
+bool Geant4FilterChain::accept(const G4GFlashSpot* spot)  const   {
+  if ( m_called.size() == m_entries.size() )
+    return _accept(spot, nullptr, 0e0);
+  return _accept(spot,
+                 spot->GetOriginatorTrack()->GetPrimaryTrack()->GetDefinition(),
+                 spot->GetEnergySpot()->GetEnergy());
+}
+
+/// Print the statistics of the rejected steps per filter
+void Geant4FilterChain::printStatistics(const Geant4Action& owner)  const   {
+  long total = 0;
+  for( const auto& e : m_entries )   {
+    owner.always("+++ Filter %-32s [%-6s] rejected %10ld of %10ld steps [%5.1f %%]",
+                  e.filter->c_name(), e.folded ? "folded" : "called", e.rejected, m_calls,
+                  m_calls > 0 ? 100e0 * double(e.rejected) / double(m_calls) : 0e0);
+    total += e.rejected;
+  }
+  owner.always("+++ Filter chain with %ld filters [%ld folded] rejected %10ld of %10ld steps [%5.1f %%]",
+               long(m_entries.size()), long(numFolded()), total, m_calls,
+               m_calls > 0 ? 100e0 * double(total) / double(m_calls) : 0e0);
+}
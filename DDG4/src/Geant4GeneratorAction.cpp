@@ -121,6 +121,11 @@ void Geant4GeneratorActionSequence::adopt(Geant4GeneratorAction* action) {
 
 /// Generator callback
 void Geant4GeneratorActionSequence::operator()(G4Event* event) {
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("generate", &Geant4GeneratorAction::operator(), event);
+    Geant4ActionProfiler::call(this, "generate-callbacks", m_calls, event);
+    return;
+  }
   m_actors(&Geant4GeneratorAction::operator(), event);
   m_calls(event);
 }
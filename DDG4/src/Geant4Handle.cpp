@@ -36,6 +36,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <type_traits>
 
 using namespace std;
 using namespace dd4hep;
@@ -112,10 +113,9 @@ namespace dd4hep {
       Geant4Kernel& k = shared ? kernel.master() : kernel;
       if ( shared && k.isMultiThreaded() )   {
         typedef typename TYPE::shared_type _ST;
-        TypeName s_type = TypeName::split(shared_typ+"/"+typ.second);
-        _ST* object = (_ST*)_create_object<TYPE>(kernel,s_type);
         CONT& container = (k.*pmf)();
         TYPE* value = 0;
+        bool created = false;
         { // Need to protect the global action sequence!
           G4AutoLock protection_lock(&creation_mutex);
           value = container.get(typ.second);
@@ -123,8 +123,30 @@ namespace dd4hep {
             value = _create_object<TYPE>(k,typ);
             container.adopt(value);
             value->release();
+            created = true;
+          }
+        }
+        // If the action supports it, every worker thread executes a private copy
+        if ( Geant4Action* copy = value->clone(kernel.workerContext()) )   {
+          TYPE* object = dynamic_cast<TYPE*>(copy);
+          if ( !object )   {
+            except("Geant4Handle", "Invalid copy of the shared object %s of type %s!",
+                   typ.second.c_str(),typeName(typeid(TYPE)).c_str());
           }
+          kernel.registerActionClone(value, object);
+          object->info("+++ Created thread private copy of shared object %s of type %s.",
+                       typ.second.c_str(),typeName(typeid(TYPE)).c_str());
+          return object;
         }
+        // Warn only once: the master object is created by the first worker
+        if constexpr ( std::is_same<TYPE, Geant4SteppingAction>::value )   {
+          if ( created )   {
+            value->warning("+++ Shared stepping action %s does not support clone(): "
+                           "the steps of all threads are serialized by a global lock!", value->c_name());
+          }
+        }
+        TypeName s_type = TypeName::split(shared_typ+"/"+typ.second);
+        _ST* object = (_ST*)_create_object<TYPE>(kernel,s_type);
         object->use(value);
         value->info("+++ Created shared object for %s of type %s.",
                     typ.second.c_str(),typeName(typeid(TYPE)).c_str());
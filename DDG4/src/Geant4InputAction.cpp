@@ -19,14 +19,139 @@
 #include "DDG4/Geant4Context.h"
 #include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4InputAction.h"
+#include "DDG4/EventParameters.h"
 
 #include "G4Event.hh"
 
+// C/C++ include files
+#include <condition_variable>
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <map>
+
 using namespace std;
 using namespace dd4hep::sim;
 typedef dd4hep::detail::ReferenceBitMask<int> PropertyMask;
 typedef Geant4InputAction::Vertices Vertices ;
 
+/// Read-ahead pipeline of the input action: producer thread and bounded event queue
+/**
+ *  The producer reads the events sequentially in the order of the event
+ *  numbers. Consumers take the events by number: the association of event
+ *  numbers and input records does not depend on the number of threads.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_SIMULATION
+ */
+class Geant4InputAction::Pipeline  {
+public:
+  /// Decoded input event
+  struct Entry  {
+    int                          status = Geant4EventReader::EVENT_READER_ERROR;
+    Vertices                     vertices;
+    Particles                    particles;
+    unique_ptr<EventParameters>  parameters;
+    exception_ptr                error;
+    /// Default destructor: delete the content not taken by the consumer
+    ~Entry()  {
+      for_each(particles.begin(),particles.end(),detail::deleteObject<Particle>);
+      for_each(vertices.begin(),vertices.end(),detail::deleteObject<Vertex>);
+    }
+  };
+  /// Reference to the parent action
+  Geant4InputAction&          action;
+  /// Maximal number of decoded events in the queue
+  size_t                      depth;
+  /// Guard of the queue
+  mutex                       lock;
+  /// Signal consumers: new event available or end of input
+  condition_variable          not_empty;
+  /// Signal the producer: free space in the queue
+  condition_variable          not_full;
+  /// Decoded events by event number
+  map<int, unique_ptr<Entry> > queue;
+  /// Producer thread
+  thread                      producer;
+  /// Flag: the producer finished (end of input or error)
+  bool                        finished = false;
+  /// Flag: the consumer requests the producer to stop
+  bool                        stop     = false;
+  /// Number of events decoded
+  long                        num_events = 0;
+
+  /// The entry being decoded by the producer thread
+  static thread_local Entry*  current;
+
+public:
+  /// Initializing constructor: starts the producer thread
+  Pipeline(Geant4InputAction& a, size_t d) : action(a), depth(std::max(size_t(1),d))  {
+    producer = thread([this]  { this->run(); });
+  }
+  /// Default destructor: stop the producer and drop pending events
+  ~Pipeline()   {
+    {
+      lock_guard<mutex> guard(lock);
+      stop = true;
+    }
+    not_full.notify_all();
+    if ( producer.joinable() ) producer.join();
+  }
+  /// Thread function of the producer
+  void run()   {
+    for( int event_number = 0; ; ++event_number )   {
+      {
+        unique_lock<mutex> guard(lock);
+        not_full.wait(guard, [this]  { return stop || queue.size() < depth; });
+        if ( stop ) break;
+      }
+      int evid = event_number + action.m_firstEvent;
+      unique_ptr<Entry> entry(new Entry());
+      current = entry.get();
+      try  {
+        entry->status = action.m_reader->moveToEvent(evid);
+        if ( entry->status == Geant4EventReader::EVENT_READER_OK )
+          entry->status = action.m_reader->readParticles(evid, entry->vertices, entry->particles);
+      }
+      catch(...)  {
+        entry->error = current_exception();
+      }
+      current = 0;
+      bool last = entry->error || entry->status != Geant4EventReader::EVENT_READER_OK;
+      {
+        lock_guard<mutex> guard(lock);
+        queue.emplace(event_number, std::move(entry));
+        finished = last;
+        ++num_events;
+      }
+      not_empty.notify_all();
+      if ( last ) break;
+    }
+    lock_guard<mutex> guard(lock);
+    finished = true;
+    not_empty.notify_all();
+  }
+  /// Take the event with the given number. Blocks until decoded. Null if beyond the end of input
+  unique_ptr<Entry> take(int event_number)   {
+    unique_lock<mutex> guard(lock);
+    not_empty.wait(guard, [this, event_number]  {
+        return finished || queue.find(event_number) != queue.end();
+      });
+    auto it = queue.find(event_number);
+    if ( it == queue.end() ) return unique_ptr<Entry>();
+    unique_ptr<Entry> entry = std::move(it->second);
+    queue.erase(it);
+    guard.unlock();
+    not_full.notify_one();
+    return entry;
+  }
+};
+
+/// The entry being decoded by the producer thread
+thread_local Geant4InputAction::Pipeline::Entry* Geant4InputAction::Pipeline::current = 0;
+
 
 /// Initializing constructor
 Geant4EventReader::Geant4EventReader(const std::string& nam)
@@ -52,6 +177,16 @@ void Geant4EventReader::setInputAction(Geant4InputAction* action) {
   m_inputAction = action;
 }
 
+/// Attach the input event parameters to the event being read
+void Geant4EventReader::addEventParameters(EventParameters* parameters) {
+  if( 0 == m_inputAction ) {
+    delete parameters;
+    printout(FATAL,"Geant4EventReader", "No input action registered!");
+    throw std::runtime_error("Geant4EventReader: No input action registered!");
+  }
+  m_inputAction->addEventParameters(parameters);
+}
+
 /// Skip event. To be implemented for sequential sources
 Geant4EventReader::EventReaderStatus Geant4EventReader::skipEvent()  {
   if ( hasDirectAccess() )   {
@@ -61,10 +196,12 @@ Geant4EventReader::EventReaderStatus Geant4EventReader::skipEvent()  {
   std::vector<Particle*> particles;
   Vertices vertices ;
   
-  ++m_currEvent;
-  EventReaderStatus sc = readParticles(m_currEvent,vertices,particles);
+  // Readers may or may not count the events read: the event counter is set here
+  int curr_event = m_currEvent;
+  EventReaderStatus sc = readParticles(curr_event,vertices,particles);
   for_each(particles.begin(),particles.end(),detail::deleteObject<Particle>);
   for_each(vertices.begin(),vertices.end(),detail::deleteObject<Vertex>);
+  m_currEvent = curr_event + 1;
   return sc;
 }
 
@@ -83,13 +220,9 @@ void Geant4EventReader::checkParameters(std::map< std::string, std::string > &pa
 
 }
 
-#if 0
+/// Move to the indicated event number.
 Geant4EventReader::EventReaderStatus
 Geant4EventReader::moveToEvent(int event_number)   {
-  if ( event_number >= INT_MIN )   {
-    return EVENT_READER_OK;  // Logic below does not work as expected.
-  }                          // This shortcuts it!
-                             // APS: would have been nice to know what exactly doesn't work...
   if ( m_currEvent == event_number )  {
     return EVENT_READER_OK;
   }
@@ -97,24 +230,16 @@ Geant4EventReader::moveToEvent(int event_number)   {
     m_currEvent = event_number;
     return EVENT_READER_OK;
   }
-  else if ( event_number<m_currEvent )   {
+  else if ( event_number < m_currEvent )   {
+    // Sequential sources cannot move backwards
     return EVENT_READER_ERROR;
   }
-  else  {
-    for(int i=m_currEvent; i<event_number;++i)
-      skipEvent();
-    m_currEvent = event_number;
-    return EVENT_READER_OK;
+  while ( m_currEvent < event_number )   {
+    EventReaderStatus sc = skipEvent();
+    if ( sc != EVENT_READER_OK ) return sc;
   }
-  return EVENT_READER_ERROR;
-}
-#else
-/// Move to the indicated event number.
-Geant4EventReader::EventReaderStatus
-Geant4EventReader::moveToEvent(int /* event_number */)   {
   return EVENT_READER_OK;
 }
-#endif
 
 /// Standard constructor
 Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const string& nam)
@@ -126,11 +251,28 @@ Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const string& nam)
   declareProperty("MomentumScale",  m_momScale = 1.0);
   declareProperty("HaveAbort",      m_abort = true);
   declareProperty("Parameters",     m_parameters = {});
+  declareProperty("ReadAhead",      m_readAhead = 0);
   m_needsControl = true;
 }
 
 /// Default destructor
 Geant4InputAction::~Geant4InputAction()   {
+  m_pipeline.reset();
+}
+
+/// Attach input event parameters to the current event (or to the read-ahead queue)
+void Geant4InputAction::addEventParameters(EventParameters* parameters)   {
+  if ( Pipeline::current )   {
+    Pipeline::current->parameters.reset(parameters);
+    return;
+  }
+  try  {
+    context()->event().addExtension<EventParameters>(parameters);
+  }
+  catch(...)  {
+    delete parameters;
+    throw;
+  }
 }
 
 /// helper to report Geant4 exceptions
@@ -140,41 +282,42 @@ string Geant4InputAction::issue(int i)  const  {
   return str.str();
 }
 
-/// Read an event and return a LCCollection of MCParticles.
-int Geant4InputAction::readParticles(int evt_number,
-                                     Vertices& vertices,
-                                     std::vector<Particle*>& particles)
-{
-  int evid = evt_number + m_firstEvent;
-  if ( 0 == m_reader )  {
-    if ( m_input.empty() )  {
-      except("InputAction: No input file declared!");
-    }
-    string err;
-    TypeName tn = TypeName::split(m_input,"|");
-    try  {
+/// Create the event reader if not yet present
+int Geant4InputAction::createReader(int evid)   {
+  if ( 0 != m_reader )  {
+    return Geant4EventReader::EVENT_READER_OK;
+  }
+  if ( m_input.empty() )  {
+    except("InputAction: No input file declared!");
+  }
+  string err;
+  TypeName tn = TypeName::split(m_input,"|");
+  try  {
+    m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
+    if ( 0 == m_reader )   {
+      PluginDebug dbg;
       m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
-      if ( 0 == m_reader )   {
-        PluginDebug dbg;
-        m_reader = PluginService::Create<Geant4EventReader*>(tn.first,tn.second);
-        abortRun(issue(evid)+"Error creating reader plugin.",
-                 "Failed to create file reader of type %s. Cannot open dataset %s",
-                 tn.first.c_str(),tn.second.c_str());
-        return Geant4EventReader::EVENT_READER_NO_FACTORY;
-      }
-      m_reader->setParameters( m_parameters );
-      m_reader->checkParameters( m_parameters );
-      m_reader->setInputAction( this );
-    }
-    catch(const exception& e)  {
-      err = e.what();
-    }
-    if ( !err.empty() )  {
-      abortRun(issue(evid)+err,"Error when creating reader for file %s",m_input.c_str());
+      abortRun(issue(evid)+"Error creating reader plugin.",
+               "Failed to create file reader of type %s. Cannot open dataset %s",
+               tn.first.c_str(),tn.second.c_str());
       return Geant4EventReader::EVENT_READER_NO_FACTORY;
     }
+    m_reader->setParameters( m_parameters );
+    m_reader->checkParameters( m_parameters );
+    m_reader->setInputAction( this );
+  }
+  catch(const exception& e)  {
+    err = e.what();
   }
-  int status = m_reader->moveToEvent(evid);
+  if ( !err.empty() )  {
+    abortRun(issue(evid)+err,"Error when creating reader for file %s",m_input.c_str());
+    return Geant4EventReader::EVENT_READER_NO_FACTORY;
+  }
+  return Geant4EventReader::EVENT_READER_OK;
+}
+
+/// Handle the reader status: abort or throw on errors
+int Geant4InputAction::checkStatus(int evid, int status)   {
   if(status == Geant4EventReader::EVENT_READER_EOF ) {
     long nEvents = context()->kernel().property("NumEvents").value<long>();
     if(nEvents < 0) {
@@ -182,7 +325,6 @@ int Geant4InputAction::readParticles(int evt_number,
       throw DD4hep_End_Of_File();
     }
   }
-
   if ( Geant4EventReader::EVENT_READER_OK != status )  {
     string msg = issue(evid)+"Error when moving to event - ";
     if ( status == Geant4EventReader::EVENT_READER_EOF ) msg += " EOF: [end of file].";
@@ -193,30 +335,54 @@ int Geant4InputAction::readParticles(int evt_number,
     }
     error(msg.c_str());
     except("Error when reading file %s.", m_input.c_str());
+  }
+  return status;
+}
+
+/// Read an event and return a LCCollection of MCParticles.
+int Geant4InputAction::readParticles(int evt_number,
+                                     Vertices& vertices,
+                                     std::vector<Particle*>& particles)
+{
+  int evid = evt_number + m_firstEvent;
+  int status = createReader(evid);
+  if ( Geant4EventReader::EVENT_READER_OK != status )  {
     return status;
   }
-  status = m_reader->readParticles(evid, vertices, particles);
-  if(status == Geant4EventReader::EVENT_READER_EOF ) {
-    long nEvents = context()->kernel().property("NumEvents").value<long>();
-    if(nEvents < 0) {
-      //context()->kernel().runManager().AbortRun(true);
-      throw DD4hep_End_Of_File();
-    }
+  status = checkStatus(evid, m_reader->moveToEvent(evid));
+  if ( Geant4EventReader::EVENT_READER_OK != status )  {
+    return status;
   }
+  return checkStatus(evid, m_reader->readParticles(evid, vertices, particles));
+}
 
-
-  if ( Geant4EventReader::EVENT_READER_OK != status )  {
-    string msg = issue(evid)+"Error when moving to event - ";
-    if ( status == Geant4EventReader::EVENT_READER_EOF ) msg += " EOF: [end of file].";
-    else msg += " Unknown error condition";
-    if ( m_abort )  {
-      abortRun(msg,"Error when reading file %s",m_input.c_str());
+/// Dequeue the next event from the read-ahead pipeline
+int Geant4InputAction::readAheadParticles(int evt_number,
+                                          Vertices& vertices,
+                                          std::vector<Particle*>& particles)
+{
+  int evid = evt_number + m_firstEvent;
+  if ( !m_pipeline )   {
+    int status = createReader(evid);
+    if ( Geant4EventReader::EVENT_READER_OK != status )  {
       return status;
     }
-    error(msg.c_str());
-    except("Error when reading file %s.", m_input.c_str());
+    m_pipeline.reset(new Pipeline(*this, m_readAhead));
+    info("+++ Started read-ahead of %d events.", m_readAhead);
   }
-  return status;
+  unique_ptr<Pipeline::Entry> entry = m_pipeline->take(evt_number);
+  if ( !entry )  {
+    return checkStatus(evid, Geant4EventReader::EVENT_READER_EOF);
+  }
+  if ( entry->error )  {
+    rethrow_exception(entry->error);
+  }
+  if ( entry->parameters )  {
+    context()->event().addExtension<EventParameters>(entry->parameters.release());
+  }
+  vertices.swap(entry->vertices);
+  particles.swap(entry->particles);
+  return checkStatus(evid, entry->status);
 }
 
 /// Callback to generate primary particles
@@ -227,7 +393,10 @@ void Geant4InputAction::operator()(G4Event* event)   {
   Vertices                  vertices ;
   int result;
 
-  result = readParticles(m_currentEventNumber, vertices, primaries);
+  if ( m_readAhead > 0 )
+    result = readAheadParticles(m_currentEventNumber, vertices, primaries);
+  else
+    result = readParticles(m_currentEventNumber, vertices, primaries);
 
   event->SetEventID(m_firstEvent + m_currentEventNumber);
   ++m_currentEventNumber;
@@ -22,6 +22,7 @@
 #include "DDG4/Geant4Kernel.h"
 #include "DDG4/Geant4Context.h"
 #include "DDG4/Geant4ActionPhase.h"
+#include "DDG4/Geant4ActionProfiler.h"
 
 // Geant4 include files
 #include "G4RunManager.hh"
@@ -99,6 +100,9 @@ Geant4Kernel::Geant4Kernel(Detector& description_ref)
   declareProperty("DefaultSensitiveType", m_dfltSensitiveDetectorType = "Geant4SensDet");
   declareProperty("SensitiveTypes",   m_sensitiveDetectorTypes);
   declareProperty("RunManagerType",   m_runManagerType = "G4RunManager");
+  declareProperty("ProfileActions",   m_profileActions);
+  declareProperty("ProfileTraceFile", m_profileTraceFile);
+  declareProperty("ProfileTraceLimit",m_profileTraceLimit);
   m_controlName = "/ddg4/";
   m_control = new G4UIdirectory(m_controlName.c_str());
   m_control->SetGuidance("Control for named Geant4 actions");
@@ -137,6 +141,7 @@ Geant4Kernel::~Geant4Kernel() {
   if ( this == s_main_instance.get() )   {
     s_main_instance.release();
   }
+  releaseActionClones();
   detail::destroyObjects(m_workers);
   if ( isMaster() )  {
     detail::releaseObjects(m_globalFilters);
@@ -312,6 +317,7 @@ int Geant4Kernel::configure() {
 }
 
 int Geant4Kernel::initialize() {
+  Geant4ActionProfiler::enable(m_profileActions, m_profileTraceFile.empty() ? 0 : m_profileTraceLimit);
   return Geant4Exec::initialize(*this);
 }
 
@@ -341,7 +347,14 @@ int Geant4Kernel::terminate() {
   printout(INFO,"Geant4Kernel","++ Terminate Geant4 and delete associated actions.");
   if ( ptr == this )  {
     Geant4Exec::terminate(*this);
+    if ( Geant4ActionProfiler::enabled() )  {
+      Geant4ActionProfiler::printSummary();
+      if ( !m_profileTraceFile.empty() )
+        Geant4ActionProfiler::writeTrace(m_profileTraceFile);
+      Geant4ActionProfiler::enable(false, 0);
+    }
   }
+  releaseActionClones();
   destroyPhases();
   detail::releaseObjects(m_globalFilters);
   detail::releaseObjects(m_globalActions);
@@ -423,6 +436,37 @@ Geant4Action* Geant4Kernel::globalFilter(const std::string& filter_name, bool th
   return nullptr;
 }
 
+/// Register the thread private copy of a shared action. Results are merged at the end of each run
+Geant4Kernel& Geant4Kernel::registerActionClone(Geant4Action* shared_action, Geant4Action* worker_copy)   {
+  if ( shared_action && worker_copy )   {
+    shared_action->addRef();
+    worker_copy->addRef();
+    m_actionClones.emplace_back(shared_action, worker_copy);
+    return *this;
+  }
+  except("Geant4Kernel",
+         "DDG4: Attempt to register an invalid action copy. [Action-Invalid]");
+  return *this;
+}
+
+/// Merge the results of all thread private copies into the shared actions
+void Geant4Kernel::mergeActionClones()   {
+  if ( !m_actionClones.empty() )   {
+    G4AutoLock protection_lock(&kernel_mutex);
+    for( auto& c : m_actionClones )
+      c.first->merge(*c.second);
+  }
+}
+
+/// Release the thread private copies of shared actions
+void Geant4Kernel::releaseActionClones()   {
+  for( auto& c : m_actionClones )   {
+    detail::releasePtr(c.second);
+    detail::releasePtr(c.first);
+  }
+  m_actionClones.clear();
+}
+
 /// Execute phase action if it exists
 bool Geant4Kernel::executePhase(const std::string& nam, const void** arguments)  const   {
   if( auto i=m_phases.find(nam); i != m_phases.end() )   {
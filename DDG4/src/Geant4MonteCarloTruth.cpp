@@ -27,6 +27,11 @@ Geant4MonteCarloTruth::~Geant4MonteCarloTruth() {
   InstanceCount::decrement(this);
 }
 
+/// Check if a new track may be required by the MC truth record. Default: all tracks are required
+bool Geant4MonteCarloTruth::requiresTrack(const G4Track*)  const  {
+  return true;
+}
+
 /// Standard constructor
 Geant4DummyTruthHandler::Geant4DummyTruthHandler(Geant4Context* ctxt,const std::string& nam) 
   : Geant4Action(ctxt,nam), Geant4MonteCarloTruth()
@@ -54,3 +59,7 @@ void Geant4DummyTruthHandler::mark(const G4Step*) {
 void Geant4DummyTruthHandler::mark(const G4Step*, int ) {
 }
 
+/// No MC truth record: no track is required
+bool Geant4DummyTruthHandler::requiresTrack(const G4Track*)  const  {
+  return false;
+}
@@ -167,6 +167,23 @@ void Geant4ParticleHandler::mark(const G4Track* track)   {
   //Geant4ParticleHandle(&m_currTrack).dump4(outputLevel(),vol->GetName(),"hit created by particle");
 }
 
+/// Check if a new track may be required by the MC truth record. If yes, it may not be discarded before tracking
+bool Geant4ParticleHandler::requiresTrack(const G4Track* track)  const  {
+  Geant4TrackHandler h(track);
+  if ( m_keepAll || h.parent() == 0 || h.primary() )
+    return true;
+  else if ( h.kineticEnergy() > m_kinEnergyCut )
+    return true;
+  else if ( m_userHandler && m_userHandler->requiresTrack(track) )
+    return true;
+  else if ( h.creatorProcess() && !m_processNames.empty() )  {
+    const G4String& proc = h.creatorProcess()->GetProcessName();
+    return find(m_processNames.begin(), m_processNames.end(), proc) != m_processNames.end();
+  }
+  // Low energy tracks which create no hits are removed from the record by default
+  return false;
+}
+
 /// Event generation action callback
 void Geant4ParticleHandler::operator()(G4Event* event)  {
   typedef Geant4MonteCarloTruth _MC;
@@ -142,6 +142,11 @@ void Geant4RunActionSequence::adopt(Geant4RunAction* action) {
 /// Pre-track action callback
 void Geant4RunActionSequence::begin(const G4Run* run) {
   G4AutoLock protection_lock(&sequence_mutex);
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("begin-run", &Geant4RunAction::begin, run);
+    Geant4ActionProfiler::call(this, "begin-run-callbacks", m_begin, run);
+    return;
+  }
   m_actors(&Geant4RunAction::begin, run);
   m_begin(run);
 }
@@ -149,6 +154,11 @@ void Geant4RunActionSequence::begin(const G4Run* run) {
 /// Post-track action callback
 void Geant4RunActionSequence::end(const G4Run* run) {
   G4AutoLock protection_lock(&sequence_mutex);
+  if ( Geant4ActionProfiler::enabled() )  {
+    Geant4ActionProfiler::call(this, "end-run-callbacks", m_end, run);
+    m_actors.profile("end-run", &Geant4RunAction::end, run);
+    return;
+  }
   m_end(run);
   m_actors(&Geant4RunAction::end, run);
 }
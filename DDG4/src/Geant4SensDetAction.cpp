@@ -97,6 +97,11 @@ bool Geant4Filter::operator()(const G4GFlashSpot*) const {
   return false;
 }
 
+/// Describe the filter by particle type and energy deposit requirements
+bool Geant4Filter::fold(Geant4FilterCuts& /* cuts */) const {
+  return false;
+}
+
 /// Constructor. The detector element is identified by the name
 Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElement det, Detector& det_ref)
   : Geant4Action(ctxt, nam), m_detDesc(det_ref), m_detector(det)
@@ -105,7 +110,9 @@ Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElem
   if (!det.isValid()) {
     throw runtime_error(format("Geant4Sensitive", "DDG4: Detector elemnt for %s is invalid.", nam.c_str()));
   }
-  declareProperty("HitCreationMode", m_hitCreationMode = SIMPLE_MODE);
+  declareProperty("HitCreationMode",  m_hitCreationMode = SIMPLE_MODE);
+  declareProperty("FoldFilters",      m_foldFilters);
+  declareProperty("FilterStatistics", m_filterStatistics);
   m_sequence     = context()->kernel().sensitiveAction(m_detector.name());
   m_sensitive    = m_detDesc.sensitiveDetector(det.name());
   m_readout      = m_sensitive.readout();
@@ -114,6 +121,9 @@ Geant4Sensitive::Geant4Sensitive(Geant4Context* ctxt, const string& nam, DetElem
 
 /// Standard destructor
 Geant4Sensitive::~Geant4Sensitive() {
+  if ( m_filterChain && m_filterStatistics )
+    m_filterChain->printStatistics(*this);
+  m_filterChain.reset();
   m_filters(&Geant4Filter::release);
   m_filters.clear();
   InstanceCount::decrement(this);
@@ -130,6 +140,7 @@ void Geant4Sensitive::adopt(Geant4Filter* filter) {
   if (filter) {
     filter->addRef();
     m_filters.add(filter);
+    m_filterChain.reset();
     return;
   }
   throw runtime_error("Geant4Sensitive: Attempt to add invalid sensitive filter!");
@@ -146,13 +157,25 @@ void Geant4Sensitive::adopt_front(Geant4Filter* filter) {
   if (filter) {
     filter->addRef();
     m_filters.add_front(filter);
+    m_filterChain.reset();
     return;
   }
   throw runtime_error("Geant4Sensitive: Attempt to add invalid sensitive filter!");
 }
 
+/// Access the compiled filter chain. Built on first use
+const Geant4FilterChain& Geant4Sensitive::filterChain() const {
+  if ( !m_filterChain )  {
+    m_filterChain.reset(new Geant4FilterChain());
+    m_filterChain->compile(vector<Geant4Filter*>(m_filters.begin(), m_filters.end()), m_foldFilters);
+  }
+  return *m_filterChain;
+}
+
 /// Callback before hit processing starts. Invoke all filters.
 bool Geant4Sensitive::accept(const G4Step* step) const {
+  if ( m_foldFilters || m_filterStatistics )
+    return filterChain().accept(step);
   bool (Geant4Filter::*filter)(const G4Step*) const = &Geant4Filter::operator();
   bool result = m_filters.filter(filter, step);
   return result;
@@ -160,6 +183,8 @@ bool Geant4Sensitive::accept(const G4Step* step) const {
 
 /// GFLASH interface: Callback before hit processing starts. Invoke all filters.
 bool Geant4Sensitive::accept(const G4GFlashSpot* spot) const {
+  if ( m_foldFilters || m_filterStatistics )
+    return filterChain().accept(spot);
   bool (Geant4Filter::*filter)(const G4GFlashSpot*) const = &Geant4Filter::operator();
   bool result = m_filters.filter(filter, spot);
   return result;
@@ -301,11 +326,16 @@ Geant4SensDetActionSequence::Geant4SensDetActionSequence(Geant4Context* ctxt, co
   /// Update the sensitive detector type, so that the proper instance is created
   m_sensitive = context()->detectorDescription().sensitiveDetector(nam);
   m_sensitiveType = m_sensitive.type();
+  declareProperty("FoldFilters",      m_foldFilters);
+  declareProperty("FilterStatistics", m_filterStatistics);
   InstanceCount::increment(this);
 }
 
 /// Default destructor
 Geant4SensDetActionSequence::~Geant4SensDetActionSequence() {
+  if ( m_filterChain && m_filterStatistics )
+    m_filterChain->printStatistics(*this);
+  m_filterChain.reset();
   m_filters(&Geant4Filter::release);
   m_actors(&Geant4Sensitive::release);
   m_filters.clear();
@@ -341,6 +371,7 @@ void Geant4SensDetActionSequence::adopt(Geant4Filter* filter) {
   if (filter) {
     filter->addRef();
     m_filters.add(filter);
+    m_filterChain.reset();
     return;
   }
   throw runtime_error("Geant4SensDetActionSequence: Attempt to add invalid sensitive filter!");
@@ -397,8 +428,19 @@ Geant4HitCollection* Geant4SensDetActionSequence::collectionByID(size_t id) cons
   return 0;
 }
 
+/// Access the compiled filter chain. Built on first use
+const Geant4FilterChain& Geant4SensDetActionSequence::filterChain() const {
+  if ( !m_filterChain )  {
+    m_filterChain.reset(new Geant4FilterChain());
+    m_filterChain->compile(vector<Geant4Filter*>(m_filters.begin(), m_filters.end()), m_foldFilters);
+  }
+  return *m_filterChain;
+}
+
 /// Callback before hit processing starts. Invoke all filters.
 bool Geant4SensDetActionSequence::accept(const G4Step* step) const {
+  if ( m_foldFilters || m_filterStatistics )
+    return filterChain().accept(step);
   bool (Geant4Filter::*filter)(const G4Step*) const = &Geant4Filter::operator();
   bool result = m_filters.filter(filter, step);
   return result;
@@ -406,6 +448,8 @@ bool Geant4SensDetActionSequence::accept(const G4Step* step) const {
 
 /// Callback before hit processing starts. Invoke all filters.
 bool Geant4SensDetActionSequence::accept(const G4GFlashSpot* spot) const {
+  if ( m_foldFilters || m_filterStatistics )
+    return filterChain().accept(spot);
   bool (Geant4Filter::*filter)(const G4GFlashSpot*) const = &Geant4Filter::operator();
   bool result = m_filters.filter(filter, spot);
   return result;
@@ -414,6 +458,15 @@ bool Geant4SensDetActionSequence::accept(const G4GFlashSpot* spot) const {
 /// G4VSensitiveDetector interface: Method for generating hit(s) using the information of G4Step object.
 bool Geant4SensDetActionSequence::process(G4Step* step, G4TouchableHistory* history) {
   bool result = false;
+  if ( Geant4ActionProfiler::enabled() )  {
+    for (Geant4Sensitive* sensitive : m_actors)  {
+      Geant4ActionProfiler::Timer timer(sensitive, "process-hit");
+      if ( sensitive->accept(step) )
+        result |= sensitive->process(step, history);
+    }
+    Geant4ActionProfiler::call(this, "process-hit-callbacks", m_process, step, history);
+    return result;
+  }
   for (Geant4Sensitive* sensitive : m_actors)  {
     if ( sensitive->accept(step) )
       result |= sensitive->process(step, history);
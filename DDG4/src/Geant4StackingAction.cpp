@@ -25,6 +25,16 @@ using namespace std;
 using namespace dd4hep::sim;
 namespace {
   G4Mutex action_mutex=G4MUTEX_INITIALIZER;
+
+  /// Rank of a track classification: the highest rank wins
+  int classification_rank(G4ClassificationOfNewTrack value)   {
+    switch(value)   {
+    case fKill:     return 3;
+    case fPostpone: return 2;
+    case fUrgent:   return 1;   // An explicit urgent request protects against deferral
+    default:        return 0;   // Any waiting stack
+    }
+  }
 }
 
 /// Standard constructor
@@ -87,6 +97,17 @@ void Geant4SharedStackingAction::prepare()  {
   }
 }
 
+/// Classify a new track
+TrackClassification Geant4SharedStackingAction::classifyNewTrack(G4StackManager* mgr, const G4Track* track)  {
+  if ( m_action )  {
+    G4AutoLock protection_lock(&action_mutex);  {
+      ContextSwap swap(m_action,context());
+      return m_action->classifyNewTrack(mgr, track);
+    }
+  }
+  return TrackClassification();
+}
+
 /// Standard constructor
 Geant4StackingActionSequence::Geant4StackingActionSequence(Geant4Context* ctxt, const string& nam)
   : Geant4Action(ctxt, nam) {
@@ -131,12 +152,47 @@ Geant4StackingAction* Geant4StackingActionSequence::get(const string& nam) const
 
 /// Pre-track action callback
 void Geant4StackingActionSequence::newStage() {
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("new-stage", &Geant4StackingAction::newStage);
+    Geant4ActionProfiler::call(this, "new-stage-callbacks", m_newStage);
+    return;
+  }
   m_actors(&Geant4StackingAction::newStage);
   m_newStage();
 }
 
 /// Post-track action callback
 void Geant4StackingActionSequence::prepare() {
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("prepare", &Geant4StackingAction::prepare);
+    Geant4ActionProfiler::call(this, "prepare-callbacks", m_prepare);
+    return;
+  }
   m_actors(&Geant4StackingAction::prepare);
   m_prepare();
 }
+
+/// Classify a new track
+TrackClassification Geant4StackingActionSequence::classifyNewTrack(G4StackManager* mgr, const G4Track* track)   {
+  TrackClassification result;
+  bool profile = Geant4ActionProfiler::enabled();
+  for( Geant4StackingAction* action : m_actors )   {
+    TrackClassification ret;
+    if ( profile )   {
+      Geant4ActionProfiler::Timer timer(action, "classify");
+      ret = action->classifyNewTrack(mgr, track);
+    }
+    else   {
+      ret = action->classifyNewTrack(mgr, track);
+    }
+    if ( !ret.isValid() )
+      continue;
+    else if ( !result.isValid() )
+      result = ret;
+    else if ( classification_rank(ret.value) > classification_rank(result.value) )
+      result = ret;
+    if ( result.value == fKill )
+      break;
+  }
+  return result;
+}
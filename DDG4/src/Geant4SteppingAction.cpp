@@ -113,6 +113,11 @@ Geant4SteppingAction* Geant4SteppingActionSequence::get(const string& nam) const
 
 /// Pre-track action callback
 void Geant4SteppingActionSequence::operator()(const G4Step* step, G4SteppingManager* mgr) {
+  if ( Geant4ActionProfiler::enabled() )  {
+    m_actors.profile("step", &Geant4SteppingAction::operator(), step, mgr);
+    Geant4ActionProfiler::call(this, "step-callbacks", m_calls, step, mgr);
+    return;
+  }
   m_actors(&Geant4SteppingAction::operator(), step, mgr);
   m_calls(step, mgr);
 }
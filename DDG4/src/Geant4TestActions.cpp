@@ -178,10 +178,31 @@ Geant4TestStepAction::Geant4TestStepAction(Geant4Context* c, const std::string&
 
 /// Default destructor
 Geant4TestStepAction::~Geant4TestStepAction() {
+  if ( m_numSteps > 0 )  {
+    always("%s> Number of steps seen: %ld", m_type.c_str(), m_numSteps);
+  }
   InstanceCount::decrement(this);
 }
+
+/// Create a private copy for a worker thread if used as shared action
+Geant4Action* Geant4TestStepAction::clone(Geant4Context* thread_context)  const  {
+  Geant4TestStepAction* copy = new Geant4TestStepAction(thread_context, name());
+  copy->m_value1 = m_value1;
+  copy->m_value2 = m_value2;
+  copy->m_value3 = m_value3;
+  return copy;
+}
+
+/// Merge the step count of a worker copy
+void Geant4TestStepAction::merge(Geant4Action& worker_copy)  {
+  Geant4TestStepAction& copy = dynamic_cast<Geant4TestStepAction&>(worker_copy);
+  m_numSteps += copy.m_numSteps;
+  copy.m_numSteps = 0;
+}
+
 /// User stepping callback
 void Geant4TestStepAction::operator()(const G4Step*, G4SteppingManager*) {
+  ++m_numSteps;
   PRINT("%s> calling operator()", m_type.c_str());
 }
 
@@ -83,6 +83,12 @@ void Geant4TrackingActionSequence::adopt(Geant4TrackingAction* action) {
 
 /// Pre-track action callback
 void Geant4TrackingActionSequence::begin(const G4Track* track) {
+  if ( Geant4ActionProfiler::enabled() )  {
+    Geant4ActionProfiler::call(this, "begin-track-callbacks", m_front, track);
+    m_actors.profile("begin-track", &Geant4TrackingAction::begin, track);
+    Geant4ActionProfiler::call(this, "begin-track-callbacks", m_begin, track);
+    return;
+  }
   m_front(track);
   m_actors(&Geant4TrackingAction::begin, track);
   m_begin(track);
@@ -90,6 +96,12 @@ void Geant4TrackingActionSequence::begin(const G4Track* track) {
 
 /// Post-track action callback
 void Geant4TrackingActionSequence::end(const G4Track* track) {
+  if ( Geant4ActionProfiler::enabled() )  {
+    Geant4ActionProfiler::call(this, "end-track-callbacks", m_end, track);
+    m_actors.profile("end-track", &Geant4TrackingAction::end, track);
+    Geant4ActionProfiler::call(this, "end-track-callbacks", m_final, track);
+    return;
+  }
   m_end(track);
   m_actors(&Geant4TrackingAction::end, track);
   m_final(track);
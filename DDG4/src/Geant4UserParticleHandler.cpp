@@ -68,3 +68,8 @@ void Geant4UserParticleHandler::combine(Particle& /* to_be_deleted */, Particle&
 bool Geant4UserParticleHandler::keepParticle(Particle& particle)   {
   return Geant4ParticleHandler::defaultKeepParticle(particle);
 }
+
+/// Callback to be answered if a new track may be required by the MC truth record
+bool Geant4UserParticleHandler::requiresTrack(const G4Track* /* track */)  const   {
+  return false;
+}
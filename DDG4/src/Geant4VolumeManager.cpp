@@ -81,7 +81,7 @@ namespace {
       PlacedVolume::VolIDs pv_ids = pv.volIDs();
 
       chain.emplace_back(node);
-      ids.PlacedVolume::VolIDs::Base::insert(ids.end(), pv_ids.begin(), pv_ids.end());
+      ids.insert(ids.end(), pv_ids.begin(), pv_ids.end());
       if (vol.isSensitive()) {
         sd = vol.sensitiveDetector();
         if (sd.readout().isValid()) {
@@ -113,7 +113,7 @@ namespace {
       PlacedVolume::VolIDs encode_ids;
       bool is_virtual = false;
       for (const auto& id : ids) {
-        if (id.first[0] != '~')
+        if (id.first.str()[0] != '~')
           encode_ids.emplace_back(id);
         else
           is_virtual = true;
@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_AlignmentExample_scaling \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml \
+   -threads 1 2 4 8 -repeat 100
+
+   Benchmark of the AlignmentsCalculator: compute the alignment
+   transformations of the full detector hierarchy repeatedly using
+   a varying number of worker threads.
+
+*/
+// Framework include files
+#include "AlignmentExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TStatistic.h"
+#include "TTimeStamp.h"
+
+// C/C++ include files
+#include <cctype>
+
+#ifdef DD4HEP_USE_TBB
+#include "tbb/task_arena.h"
+#endif
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::AlignmentExamples;
+
+/// Plugin function: Alignment program example
+/**
+ *  Factory: DD4hep_AlignmentExample_scaling
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int alignment_example (Detector& description, int argc, char** argv)  {
+
+  string      input;
+  int         num_repeat = 10;
+  vector<int> num_threads;
+  bool        arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-repeat",argv[i],4) )
+      num_repeat = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )  {
+      while( i+1 < argc && argv[i+1] && ::isdigit(argv[i+1][0]) )
+        num_threads.emplace_back(::atol(argv[++i]));
+    }
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_AlignmentExample_scaling                 \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -repeat  <number>        Number of alignment computations per setup.     \n"
+      "     -threads <n1> [n2 ...]   Thread counts to be measured (requires TBB).    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  if ( num_threads.empty() ) num_threads.emplace_back(1);
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Populate the conditions store *********************/
+  IOV iov(iov_typ, IOV::Key(1,10));
+  ConditionsPool* iov_pool = manager.registerIOV(*iov.iovType, iov.key());
+  Scanner().scan(AlignmentCreator(manager, *iov_pool),description.world());
+
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  cond::fill_content(manager,*content,*iov_typ);
+  manager.prepare(IOV(iov_typ,5),*slice);
+
+  map<DetElement, Delta>  deltas;
+  Scanner(deltaCollector(*slice,deltas),description.world());
+  printout(INFO,"Prepare","Got a total of %ld deltas for processing alignments.",deltas.size());
+
+  /******************** Compute  alignments *******************************/
+  double time_1 = 0e0;
+  printout(INFO,"Statistics","+======= Summary: # of repetitions: %3d ============================", num_repeat);
+  for( int nthr : num_threads )   {
+    TStatistic stat("Computation");
+    AlignmentsCalculator::Result total;
+    auto run = [&]()   {
+      for( int i=0; i<num_repeat; ++i )  {
+        AlignmentsCalculator calculator;
+        TTimeStamp start;
+        total += calculator.compute(deltas,*slice);
+        TTimeStamp stop;
+        stat.Fill(stop.AsDouble()-start.AsDouble());
+      }
+    };
+#ifdef DD4HEP_USE_TBB
+    tbb::task_arena arena(nthr);
+    arena.execute(run);
+#else
+    if ( nthr > 1 )
+      printout(WARNING,"Statistics","+  No TBB support: %d threads requested, computing serially.",nthr);
+    run();
+#endif
+    if ( time_1 <= 0e0 ) time_1 = stat.GetMean();
+    printout(INFO,"Statistics",
+             "+  Threads: %3d  %-12s: %11.5g +- %11.4g sec  N = %lld  Speedup: %6.2f  (A:%ld,M:%ld)",
+             nthr, stat.GetName(), stat.GetMean(), stat.GetMeanErr(), stat.GetN(),
+             stat.GetMean() > 0e0 ? time_1/stat.GetMean() : 0e0, total.computed, total.missing);
+  }
+  printout(INFO,"Statistics","+==========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_AlignmentExample_scaling,alignment_example)
@@ -0,0 +1,153 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_AlignmentExample_update \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml \
+   -repeat 100
+
+   Example of an iterative alignment loop: after the initial computation
+   of all alignment transformations, the delta of one single leaf detector
+   element is modified and the alignments are updated incrementally.
+   Only the changed detector element is recomputed, all other
+   transformations are reused from the previous computation.
+
+*/
+// Framework include files
+#include "AlignmentExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TStatistic.h"
+#include "TTimeStamp.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::AlignmentExamples;
+
+/// Plugin function: Alignment program example
+/**
+ *  Factory: DD4hep_AlignmentExample_update
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int alignment_example (Detector& description, int argc, char** argv)  {
+
+  string input;
+  int    num_repeat = 10;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-repeat",argv[i],4) )
+      num_repeat = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_AlignmentExample_update                  \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -repeat  <number>        Number of alignment updates.                    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Populate the conditions store *********************/
+  IOV iov(iov_typ, IOV::Key(1,10));
+  ConditionsPool* iov_pool = manager.registerIOV(*iov.iovType, iov.key());
+  Scanner().scan(AlignmentCreator(manager, *iov_pool),description.world());
+
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  cond::fill_content(manager,*content,*iov_typ);
+  manager.prepare(IOV(iov_typ,5),*slice);
+
+  map<DetElement, Delta>  deltas;
+  Scanner(deltaCollector(*slice,deltas),description.world());
+  printout(INFO,"Prepare","Got a total of %ld deltas for processing alignments.",deltas.size());
+
+  // The delta of the first leaf detector element is modified in the update loop
+  AlignmentsCalculator::OrderedDeltas ordered;
+  DetElement leaf;
+  for( auto& d : deltas )  {
+    ordered.emplace(d.first, &d.second);
+    if ( !leaf.isValid() && d.first.children().empty() ) leaf = d.first;
+  }
+  if ( !leaf.isValid() )
+    except("AlignmentUpdate","++ No leaf detector element with alignment delta found.");
+  Delta& leaf_delta = deltas[leaf];
+
+  /******************** Compute  alignments *******************************/
+  AlignmentsCalculator         calculator;
+  AlignmentsCalculator::Result full = calculator.compute(ordered,*slice), update;
+  TStatistic stat_full("Full"), stat_update("Incremental");
+  for( int i=0; i<num_repeat; ++i )  {
+    leaf_delta.translation.SetX(leaf_delta.translation.X() + 1e-4*dd4hep::mm);
+    leaf_delta.setFlag(Delta::HAVE_TRANSLATION);
+    TTimeStamp start;
+    update += calculator.compute(ordered,*slice,*slice);
+    TTimeStamp stop;
+    stat_update.Fill(stop.AsDouble()-start.AsDouble());
+    full += calculator.compute(ordered,*slice);
+    TTimeStamp stop_full;
+    stat_full.Fill(stop_full.AsDouble()-stop.AsDouble());
+  }
+  printout(INFO,"Statistics","+======= Summary: # of updates: %3d of %s ===============",
+           num_repeat, leaf.path().c_str());
+  printout(INFO,"Statistics","+  %-12s: %11.5g +- %11.4g sec  N = %lld  (A:%ld,R:%ld,M:%ld)",
+           stat_full.GetName(), stat_full.GetMean(), stat_full.GetMeanErr(), stat_full.GetN(),
+           full.computed, full.reused, full.missing);
+  printout(INFO,"Statistics","+  %-12s: %11.5g +- %11.4g sec  N = %lld  (A:%ld,R:%ld,M:%ld)",
+           stat_update.GetName(), stat_update.GetMean(), stat_update.GetMeanErr(), stat_update.GetN(),
+           update.computed, update.reused, update.missing);
+  printout(INFO,"Statistics","+==========================================================================");
+
+  // Update into a separate, non-owning map: the unchanged alignment conditions
+  // of the slice must be shared and not be created again.
+  leaf_delta.translation.SetX(leaf_delta.translation.X() + 1e-4*dd4hep::mm);
+  ConditionsTreeMap next;
+  AlignmentsCalculator::Result separate = calculator.compute(ordered,*slice,next);
+  size_t num_shared = 0, num_conditions = next.data.size();
+  for( auto& c : next.data )  {
+    if ( slice->pool->get(c.first).ptr() == c.second.ptr() )
+      ++num_shared;
+    else  // Created by the calculator for the changed detector element(s)
+      c.second.destroy();
+  }
+  printout(INFO,"Statistics","+  Separate map: (A:%ld,R:%ld,M:%ld) Shared conditions: %ld of %ld",
+           separate.computed, separate.reused, separate.missing,
+           long(num_shared), long(num_conditions));
+  if ( separate.computed + num_shared != num_conditions || size_t(separate.reused) != num_shared )
+    except("AlignmentUpdate","++ Unchanged alignment conditions were not shared with the previous slice.");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_AlignmentExample_update,alignment_example)
@@ -0,0 +1,181 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import time
+import logging
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV, MeV, TeV
+#
+#
+"""
+
+   dd4hep simulation example with parameterized electromagnetic showers
+
+   Usage: python FastShower.py [-full] [-stacking [-nopolicies]] [-events <number>] [-energy <GeV>]
+                               [-library <file>] [-output <file>] [batch]
+
+   With -full the showers are simulated by Geant4. Otherwise electrons and
+   photons entering the calorimeter region are killed and their energy is
+   deposited into the calorimeter hits by the Geant4FastShowerAction.
+   Running both modes allows to compare the timing and the energy response:
+   at the end the summed energy of the calorimeter hits is printed for every
+   event together with the mean and the RMS over all events.
+
+   With -stacking the MC truth is recorded and the stacking policies bound
+   the number of secondaries: low energy secondaries are killed
+   in the calorimeter region, neutrons are deferred to the waiting stack and
+   the urgent stack is limited. The peak memory and the throughput are printed.
+   With -nopolicies the MC truth is recorded in the same way, but the stacking
+   policies are not applied: the stack budget only monitors the stacks.
+   This is the reference for the memory and the throughput of -stacking.
+
+   With -output the events are written to the given ROOT file instead of a
+   file name tagged with the current time.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+
+def calorimeter_response(file_name, collection, mode):
+  from ROOT import TFile
+  f = TFile.Open(file_name)
+  tree = f.Get('EVENT')
+  energies = []
+  for entry in range(tree.GetEntries()):
+    tree.GetEntry(entry)
+    energies.append(sum([hit.energyDeposit for hit in getattr(tree, collection)]))
+    logger.info('+++ %s simulation event %d: calorimeter hit energy %.4f GeV', mode, entry, energies[-1] / GeV)
+  f.Close()
+  if not energies or sum(energies) <= 0:
+    logger.error('+++ %s simulation response: no energy deposited in the calorimeter hits', mode)
+    return
+  mean = sum(energies) / len(energies)
+  rms = (sum([(e - mean)**2 for e in energies]) / len(energies))**0.5
+  logger.info('+++ %s simulation response: mean calorimeter hit energy %.4f GeV RMS %.4f GeV [%d events]',
+              mode, mean / GeV, rms / GeV, len(energies))
+
+
+def run():
+  full = False
+  stacking = False
+  policies = True
+  batch = False
+  num_events = 10
+  energy = 10 * GeV
+  library = None
+  output = None
+  args = sys.argv[1:]
+  while args:
+    a = args.pop(0)
+    if a == '-full':
+      full = True
+    elif a == '-stacking':
+      stacking = True
+    elif a == '-nopolicies':
+      policies = False
+    elif a == '-events':
+      num_events = int(args.pop(0))
+    elif a == '-energy':
+      energy = float(args.pop(0)) * GeV
+    elif a == '-library':
+      library = args.pop(0)
+    elif a == '-output':
+      output = args.pop(0)
+    elif a == 'batch':
+      batch = True
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/FastShower.xml"))
+
+  geant4 = DDG4.Geant4(kernel)
+  geant4.printDetectors()
+  if batch:
+    kernel.UI = ''
+  else:
+    geant4.setupCshUI()
+
+  # Configure G4 geometry setup
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+  if not full:
+    seq, act = geant4.addDetectorConstruction("Geant4FastShowerAction/EcalShower")
+    act.RegionName = 'EcalBarrelRegion'
+    act.ApplicableParticles = ['e+', 'e-', 'gamma']
+    act.EnergyMin = 100 * MeV
+    act.EnergyMax = 1 * TeV
+    if library:
+      act.ProfileLibrary = library
+    act.OutputLevel = Output.INFO
+
+  # Configure I/O
+  mode = 'Full' if full else 'Fast'
+  if not output:
+    output = 'FastShower_' + mode + '_' + time.strftime('%Y-%m-%d_%H-%M')
+  if not output.endswith('.root'):
+    output = output + '.root'
+  geant4.setupROOTOutput('RootOutput', output, mc_truth=stacking)
+
+  # Setup particle gun
+  gun = geant4.setupGun("Gun", particle='e-', energy=energy, isotrop=False, direction=(1.0, 0.0, 0.0))
+  gun.OutputLevel = Output.INFO
+
+  geant4.setupCalorimeter('EcalBarrel')
+
+  if stacking:
+    part = DDG4.GeneratorAction(kernel, str('Geant4ParticleHandler/ParticleHandler'))
+    kernel.generatorAction().adopt(part)
+    part.MinimalKineticEnergy = 100 * MeV
+    # Photo-electrons are recorded: the track killer must protect them
+    part.SaveProcesses = ['Decay', 'phot']
+    part.OutputLevel = Output.INFO
+    part.enableUI()
+
+    if policies:
+      classifier = DDG4.StackingAction(kernel, str('Geant4StackClassifier/StackClassifier'))
+      classifier.WaitingParticles = ['neutron']
+      classifier.OutputLevel = Output.INFO
+      kernel.stackingAction().adopt(classifier)
+      killer = DDG4.StackingAction(kernel, str('Geant4RegionTrackKiller/RegionTrackKiller'))
+      killer.EnergyCuts = {'EcalBarrelRegion': 1 * MeV}
+      killer.OutputLevel = Output.INFO
+      kernel.stackingAction().adopt(killer)
+    budget = DDG4.StackingAction(kernel, str('Geant4StackBudget/StackBudget'))
+    budget.MaxTracks = 50 if policies else 0
+    kernel.stackingAction().adopt(budget)
+
+  # Now build the physics list:
+  phys = geant4.setupPhysics('QGSP_BERT')
+  if not full:
+    ph = DDG4.PhysicsList(kernel, str('Geant4PhysicsList/FastSimPhysics'))
+    ph.addDiscreteParticleProcess(str('e[+-]'), str('G4FastSimulationManagerProcess'))
+    ph.addDiscreteParticleProcess(str('gamma'), str('G4FastSimulationManagerProcess'))
+    ph.enableUI()
+    phys.adopt(ph)
+  phys.dump()
+
+  start = time.time()
+  geant4.execute(num_events)
+  logger.info('+++ %s simulation of %d events took %.3f seconds', mode, num_events, time.time() - start)
+  calorimeter_response(output, 'EcalBarrelHits', mode)
+
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,129 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import re
+import sys
+import logging
+import subprocess
+import DDG4
+import DDG4TestSetup
+import MiniTelSetup
+from g4units import keV
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep example to check the folded sensitive detector filter chains
+
+   The MiniTel trackers are simulated twice with the same seed: once with
+   the filters called one by one and once with the particle and energy
+   filters folded (property FoldFilters). Both runs must give the same
+   number of hits in every collection and every event.
+
+   python MiniTelFilters.py [-events <number>]
+   python MiniTelFilters.py -simulate <output-file> [-fold] [-events <number>]
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def simulate(output, fold, num_events):
+  m = MiniTelSetup.Setup()
+  DDG4.setPrintLevel(DDG4.OutputLevel.WARNING)
+  m.kernel.UI = ''
+  m.kernel.NumEvents = num_events
+  DDG4TestSetup.Setup.configure(m)
+  f1 = DDG4.Filter(m.kernel, 'GeantinoRejectFilter/GeantinoRejector')
+  f2 = DDG4.Filter(m.kernel, 'ParticleRejectFilter/GammaRejector')
+  f2.particle = 'gamma'
+  f3 = DDG4.Filter(m.kernel, 'EnergyDepositMinimumCut/EnergyCut')
+  f3.Cut = 20 * keV
+  for f in (f1, f2, f3):
+    m.kernel.registerGlobalFilter(f)
+  for i in range(1, 11):
+    seq, act = m.geant4.setupTracker('MyLHCBdetector%d' % (i,))
+    for f in (f1, f2, f3):
+      act.adopt(f)
+    act.FoldFilters = fold
+    act.FilterStatistics = True
+  m.defineOutput(output)
+  m.setupGun()
+  m.setupGenerator()
+  m.setupPhysics()
+  m.run()
+
+
+def hit_counts(file_name):
+  from ROOT import TFile
+  f = TFile.Open(file_name)
+  tree = f.Get('EVENT')
+  branches = sorted([b.GetName() for b in tree.GetListOfBranches() if b.GetName().endswith('Hits')])
+  counts = []
+  for entry in range(tree.GetEntries()):
+    tree.GetEntry(entry)
+    counts.append([getattr(tree, b).size() for b in branches])
+  f.Close()
+  return branches, counts
+
+
+def run():
+  num_events = 10
+  output = None
+  fold = False
+  args = sys.argv[1:]
+  while args:
+    opt = args.pop(0)
+    if opt == '-events':
+      num_events = int(args.pop(0))
+    elif opt == '-simulate':
+      output = args.pop(0)
+    elif opt == '-fold':
+      fold = True
+    elif opt == 'batch':
+      pass
+    else:
+      logger.error('Usage: python MiniTelFilters.py [-events <number>] [-simulate <output-file> [-fold]]')
+      sys.exit(1)
+
+  if output:
+    simulate(output, fold, num_events)
+    return
+
+  files = {}
+  folded = 0
+  rejected = 0
+  for mode in ('called', 'folded'):
+    files[mode] = 'MiniTelFilters_%s.root' % (mode,)
+    cmd = [sys.executable, sys.argv[0], '-simulate', files[mode], '-events', str(num_events)]
+    if mode == 'folded':
+      cmd.append('-fold')
+    out = subprocess.check_output(cmd, stderr=subprocess.STDOUT).decode('utf-8')
+    print(out)
+    for m in re.finditer(r'Filter chain with (\d+) filters \[(\d+) folded\] rejected +(\d+) of', out):
+      if mode == 'folded':
+        folded += int(m.group(2))
+      rejected += int(m.group(3))
+
+  branches, called = hit_counts(files['called'])
+  _, fold_counts = hit_counts(files['folded'])
+  num_hits = sum([sum(c) for c in called])
+  identical = len(called) == num_events and called == fold_counts and num_hits > 0 and folded > 0 and rejected > 0
+  logger.info('Collections: %s', ' '.join(branches))
+  logger.info('Events: %d  hits: %d  folded filters: %d  rejected steps: %d', len(called), num_hits, folded, rejected)
+  logger.info('Hit counts of folded and unfolded filter chains identical: %s', 'YES' if identical else 'NO')
+
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,92 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import re
+import sys
+import json
+import logging
+import subprocess
+import DDG4
+from MiniTelSetup import Setup
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep example to check the profiling of the DDG4 action sequences
+
+   The MiniTel geometry is simulated with the kernel property ProfileActions
+   enabled and the individual calls written to a Chrome trace file.
+   The simulation must print the action profile summary and the number of
+   trace records written. The trace file must be valid JSON and contain
+   this number of records.
+
+   python MiniTelProfile.py [-events <number>] [-trace <file>]
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def simulate(trace, num_events):
+  m = Setup()
+  DDG4.setPrintLevel(DDG4.OutputLevel.WARNING)
+  m.kernel.UI = ''
+  m.kernel.ProfileActions = True
+  m.kernel.ProfileTraceFile = trace
+  m.kernel.ProfileTraceLimit = 100000
+  m.configure()
+  m.defineOutput('MiniTelProfile.root')
+  m.setupGun()
+  m.setupGenerator()
+  m.setupPhysics()
+  m.run(num_events)
+
+
+def run():
+  num_events = 5
+  trace = 'MiniTelProfile.json'
+  child = False
+  args = sys.argv[1:]
+  while args:
+    opt = args.pop(0)
+    if opt == '-events':
+      num_events = int(args.pop(0))
+    elif opt == '-trace':
+      trace = args.pop(0)
+    elif opt == '-simulate':
+      child = True
+    elif opt == 'batch':
+      pass
+    else:
+      logger.error('Usage: python MiniTelProfile.py [-events <number>] [-trace <file>]')
+      sys.exit(1)
+
+  if child:
+    simulate(trace, num_events)
+    return
+
+  cmd = [sys.executable, sys.argv[0], '-simulate', '-events', str(num_events), '-trace', trace]
+  out = subprocess.check_output(cmd, stderr=subprocess.STDOUT).decode('utf-8')
+  print(out)
+  summary = re.search(r'Action profile summary of [1-9][0-9]* thread', out) is not None
+  written = [int(n) for n in re.findall(r'Wrote (\d+) trace records to', out)]
+  with open(trace) as f:
+    records = json.load(f)['traceEvents']
+  ok = summary and len(written) == 1 and written[0] > 0 and len(records) == written[0]
+  logger.info('Trace records written: %s  read back: %d', ' '.join([str(n) for n in written]), len(records))
+  logger.info('Action profile summary and trace file consistent: %s', 'YES' if ok else 'NO')
+
+
+if __name__ == "__main__":
+  run()
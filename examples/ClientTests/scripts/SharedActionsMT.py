@@ -0,0 +1,119 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import logging
+import subprocess
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV, MeV
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep example to check thread private copies of shared actions
+
+   The MiniTel geometry is simulated in multi-threaded mode. Every worker
+   thread executes the shared stepping action 'SharedSteps' and its own
+   stepping action 'ThreadSteps', both of type Geant4TestStepAction.
+   The shared action supports clone(): each worker executes a private copy,
+   which is merged into the shared action at the end of the run.
+   The merged step count must equal the sum of the step counts of all threads.
+
+   python SharedActionsMT.py [-threads <number>] [-events <number>]
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def setupWorker(geant4):
+  kernel = geant4.kernel()
+  shared = DDG4.SteppingAction(kernel, 'Geant4TestStepAction/SharedSteps', shared=True)
+  shared.OutputLevel = Output.DEBUG
+  kernel.steppingAction().adopt(shared)
+  private = DDG4.SteppingAction(kernel, 'Geant4TestStepAction/ThreadSteps')
+  private.OutputLevel = Output.DEBUG
+  kernel.steppingAction().adopt(private)
+
+  geant4.setupGun('Gun', particle='e-', energy=2 * GeV, multiplicity=1)
+  part = DDG4.GeneratorAction(kernel, 'Geant4ParticleHandler/ParticleHandler')
+  kernel.generatorAction().adopt(part)
+  part.MinimalKineticEnergy = 1 * MeV
+  part.OutputLevel = Output.WARNING
+  return 1
+
+
+def setupMaster(geant4):
+  kernel = geant4.master()
+  logger.info('#PYTHON: +++ Setting up master thread for %d workers', int(kernel.NumberOfThreads))
+  return 1
+
+
+def simulate(num_threads, num_events):
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str('file:' + install_dir + '/examples/ClientTests/compact/MiniTel.xml'))
+  kernel.NumberOfThreads = num_threads
+  kernel.RunManagerType = 'G4MTRunManager'
+  kernel.NumEvents = num_events
+  kernel.UI = ''
+  DDG4.setPrintLevel(Output.INFO)
+  geant4 = DDG4.Geant4(kernel)
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4,),
+                               master=setupMaster, master_args=(geant4,))
+  geant4.addDetectorConstruction('Geant4DetectorGeometryConstruction/ConstructGeo')
+  geant4.setupTrackingFieldMT()
+  geant4.setupPhysics('QGSP_BERT')
+  geant4.run()
+
+
+def run():
+  num_threads = 3
+  num_events = 30
+  child = False
+  args = sys.argv[1:]
+  while args:
+    opt = args.pop(0)
+    if opt == '-threads':
+      num_threads = int(args.pop(0))
+    elif opt == '-events':
+      num_events = int(args.pop(0))
+    elif opt == '-simulate':
+      child = True
+    elif opt == 'batch':
+      pass
+    else:
+      logger.error('Usage: python SharedActionsMT.py [-threads <number>] [-events <number>]')
+      sys.exit(1)
+
+  if child:
+    simulate(num_threads, num_events)
+    return
+
+  cmd = [sys.executable, sys.argv[0], '-simulate', '-threads', str(num_threads), '-events', str(num_events)]
+  out = subprocess.check_output(cmd, stderr=subprocess.STDOUT).decode('utf-8')
+  print(out)
+  shared = [int(n) for n in re.findall(r'SharedSteps .*Number of steps seen: (\d+)', out)]
+  private = [int(n) for n in re.findall(r'ThreadSteps .*Number of steps seen: (\d+)', out)]
+  ok = len(shared) == 1 and 0 < len(private) <= num_threads and shared[0] == sum(private)
+  logger.info('Steps per thread: %s  sum: %d', ' '.join([str(n) for n in private]), sum(private))
+  logger.info('Steps of the merged shared action: %s', ' '.join([str(n) for n in shared]))
+  logger.info('Merged step count equals the sum over threads: %s', 'YES' if ok else 'NO')
+
+
+if __name__ == "__main__":
+  run()
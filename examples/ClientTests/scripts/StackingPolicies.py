@@ -0,0 +1,86 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import re
+import sys
+import logging
+import subprocess
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+#
+"""
+
+   dd4hep example to compare the simulation with and without track stacking policies
+
+   The showers of FastShower.py are fully simulated twice with the MC truth
+   recorded: once with the stacking policies (-stacking) and once with
+   the stack budget only monitoring the stacks (-stacking -nopolicies).
+   With the policies the classifier, the track killer and the stack budget
+   must act: tracks are deferred by the budget, low energy tracks are killed
+   and tracks required by the MC truth handler are protected.
+   The throughput and the peak resident set size of both runs are printed.
+
+   python StackingPolicies.py [-events <number>]
+
+   \author  M.Frank
+   \version 1.0
+
+"""
+
+
+def simulate(num_events, policies):
+  script = os.path.join(os.path.dirname(os.path.abspath(sys.argv[0])), 'FastShower.py')
+  mode = 'on' if policies else 'off'
+  cmd = [sys.executable, script, '-full', '-stacking', '-events', str(num_events),
+         '-output', 'StackingPolicies_' + mode + '.root', 'batch']
+  if not policies:
+    cmd.append('-nopolicies')
+  out = subprocess.check_output(cmd, stderr=subprocess.STDOUT).decode('utf-8')
+  print(out)
+  res = re.search(r'Processed (\d+) events in ([0-9.]+) seconds \[([0-9.]+) events/sec\]\. '
+                  r'Peak resident set size: ([0-9.]+) MB', out)
+  perf = (float(res.group(3)), float(res.group(4))) if res else (0.0, 0.0)
+  return out, perf
+
+
+def run():
+  num_events = 5
+  args = sys.argv[1:]
+  while args:
+    opt = args.pop(0)
+    if opt == '-events':
+      num_events = int(args.pop(0))
+    elif opt == 'batch':
+      pass
+    else:
+      logger.error('Usage: python StackingPolicies.py [-events <number>]')
+      sys.exit(1)
+
+  out, with_policies = simulate(num_events, True)
+  _, without_policies = simulate(num_events, False)
+  budget = [int(n) for n in re.findall(r'Stack budget \d+: deferred (\d+) of \d+ tracks', out)]
+  killed = [int(n) for n in re.findall(r'killed +(\d+) tracks', out)]
+  protected = [int(n) for n in re.findall(r'(\d+) tracks below the cuts were protected by the MC truth handler', out)]
+  logger.info('Policies: budget deferred %s  killed %s  protected %s tracks',
+              sum(budget), sum(killed), sum(protected))
+  logger.info('Throughput: %.3f events/sec with policies, %.3f events/sec without',
+              with_policies[0], without_policies[0])
+  logger.info('Peak resident set size: %.1f MB with policies, %.1f MB without',
+              with_policies[1], without_policies[1])
+  ok = sum(budget) > 0 and sum(killed) > 0 and sum(protected) > 0 and \
+      with_policies[0] > 0 and without_policies[0] > 0
+  logger.info('Stacking policies active and measured: %s', 'YES' if ok else 'NO')
+
+
+if __name__ == "__main__":
+  run()
@@ -0,0 +1,239 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+ Plugin invocation:
+ ==================
+ This plugin behaves like a main program.
+ Invoke the plugin with something like this:
+
+ geoPluginRun -destroy -plugin DD4hep_FieldMapBenchmark -create FieldMap.bin -coordinates xyz
+ geoPluginRun -destroy -input file:FieldMap.xml -plugin DD4hep_FieldMapBenchmark -points 1000000
+
+*/
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/FieldTypes.h"
+#include "DD4hep/DD4hepUnits.h"
+
+// C/C++ include files
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <iostream>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace  {
+
+  /// Synthetic field used to create and check field maps: linear in the coordinates
+  /**
+   *  Linear fields are reproduced exactly by the trilinear interpolation.
+   *  Positions are given in mm, the field in tesla.
+   */
+  void synthetic_field(double x, double y, double z, double* b)  {
+    b[0] = 1e-3 * x;
+    b[1] = 1e-3 * y;
+    b[2] = 4e0 + 5e-4 * z;
+  }
+
+  /// Create a field map file with the synthetic field
+  void create_map(const string& file_name, int coordinates)  {
+    TabulatedField map;
+    vector<float> values;
+    if ( coordinates == TabulatedField::RZ )   {
+      int    num[3]   = { 101, 201, 1 };
+      double lower[3] = {    0e0, -2000e0, 0e0 };
+      double upper[3] = { 1000e0,  2000e0, 0e0 };
+      for( int i = 0; i < num[0]; ++i )   {
+        for( int j = 0; j < num[1]; ++j )   {
+          double b[3], r = lower[0] + i * (upper[0]-lower[0])/(num[0]-1);
+          synthetic_field(r, 0e0, lower[1] + j * (upper[1]-lower[1])/(num[1]-1), b);
+          values.emplace_back(b[0]);
+          values.emplace_back(b[2]);
+        }
+      }
+      map.setGrid(coordinates, num, lower, upper, values);
+    }
+    else   {
+      int    num[3]   = { 51, 51, 101 };
+      double lower[3] = { -1000e0, -1000e0, -2000e0 };
+      double upper[3] = {  1000e0,  1000e0,  2000e0 };
+      for( int i = 0; i < num[0]; ++i )   {
+        for( int j = 0; j < num[1]; ++j )   {
+          for( int k = 0; k < num[2]; ++k )   {
+            double b[3];
+            synthetic_field(lower[0] + i * (upper[0]-lower[0])/(num[0]-1),
+                            lower[1] + j * (upper[1]-lower[1])/(num[1]-1),
+                            lower[2] + k * (upper[2]-lower[2])/(num[2]-1), b);
+            values.insert(values.end(), b, b+3);
+          }
+        }
+      }
+      map.setGrid(coordinates, num, lower, upper, values);
+    }
+    map.save(file_name);
+    printout(ALWAYS,"FieldMapBenchmark","+++ Created %s field map %s with %ld grid points.",
+             coordinates == TabulatedField::RZ ? "RZ" : "XYZ", file_name.c_str(), long(map.numPoints()));
+  }
+
+  /// Time the field lookups at the given positions [nanoseconds per lookup]
+  double time_lookups(CartesianField::Object* field, const vector<double>& points, double& sum)  {
+    auto start = chrono::high_resolution_clock::now();
+    for( size_t i = 0; i < points.size(); i += 3 )   {
+      double b[3] = { 0e0, 0e0, 0e0 };
+      field->fieldComponents(&points[i], b);
+      sum += b[0] + b[1] + b[2];
+    }
+    auto stop = chrono::high_resolution_clock::now();
+    double ns = double(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    return ns / double(max(points.size()/3, size_t(1)));
+  }
+}
+
+/// Plugin function: Create field maps and measure the lookup throughput of tabulated fields
+/**
+ *  Factory: DD4hep_FieldMapBenchmark
+ *
+ *  With the option -create a field map file with a synthetic field is written.
+ *  Otherwise all tabulated fields of the detector description are accessed
+ *  at random positions and along straight tracks with small steps. If requested
+ *  the values are compared to the synthetic field used to create the maps.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int field_map_benchmark (Detector& detector, int argc, char** argv)  {
+  bool   help = false, check = false;
+  int    coordinates = TabulatedField::XYZ;
+  long   num_points  = 1000000;
+  double step        = 1e0 * dd4hep::mm;
+  string create;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-create",argv[i],4) && i+1 < argc )
+      create = argv[++i];
+    else if ( 0 == ::strncmp("-coordinates",argv[i],4) && i+1 < argc )
+      coordinates = 0 == ::strcasecmp(argv[++i],"rz") ? TabulatedField::RZ : TabulatedField::XYZ;
+    else if ( 0 == ::strncmp("-points",argv[i],4) && i+1 < argc )
+      num_points = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-step",argv[i],4) && i+1 < argc )
+      step = ::atof(argv[++i]) * dd4hep::mm;
+    else if ( 0 == ::strncmp("-check",argv[i],4) )
+      check = true;
+    else
+      help = true;
+  }
+  if ( help || num_points <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                        \n"
+      "     name:   factory name     DD4hep_FieldMapBenchmark                   \n"
+      "     -create      <file>      Create field map file with synthetic field \n"
+      "     -coordinates <xyz|rz>    Coordinates of the created field map       \n"
+      "     -points      <number>    Number of field lookups per measurement    \n"
+      "     -step        <mm>        Step length along the tracks               \n"
+      "     -check                   Compare to the synthetic field             \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  if ( !create.empty() )   {
+    create_map(create, coordinates);
+    return 1;
+  }
+
+  bool   consistent = true;
+  size_t num_maps = 0;
+  double sum = 0e0;
+  mt19937 gen(12345);
+  for( const auto& f : detector.fields() )   {
+    CartesianField field(f.second);
+    TabulatedField* map = dynamic_cast<TabulatedField*>(field.ptr());
+    if ( !map ) continue;
+    ++num_maps;
+    // Random positions inside the grid
+    bool   rz = map->coordinates == TabulatedField::RZ;
+    double lo[3], up[3];
+    for( int i = 0; i < 3; ++i )   {
+      lo[i] = map->lower[i];
+      up[i] = map->upper[i];
+    }
+    if ( rz )   {
+      double rmax = map->upper[0] / sqrt(2e0);
+      lo[0] = lo[1] = -rmax;
+      up[0] = up[1] =  rmax;
+      lo[2] = map->lower[1];
+      up[2] = map->upper[1];
+    }
+    vector<double> random_points(3*num_points), track_points(3*num_points);
+    uniform_real_distribution<double> ux(lo[0], up[0]), uy(lo[1], up[1]), uz(lo[2], up[2]);
+    for( long i = 0; i < num_points; ++i )   {
+      random_points[3*i]   = map->offset.X() + ux(gen);
+      random_points[3*i+1] = map->offset.Y() + uy(gen);
+      random_points[3*i+2] = map->offset.Z() + uz(gen);
+    }
+    // Straight tracks from the origin with small steps: mostly hits in the same cell
+    double track_len = max(step, max(fabs(lo[2]), fabs(up[2])));
+    for( long i = 0; i < num_points; )   {
+      double dir[3] = { ux(gen), uy(gen), uz(gen) }, len = 0e0;
+      double norm = sqrt(dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2]);
+      for( ; i < num_points && len < track_len; ++i, len += step )   {
+        for( int j = 0; j < 3; ++j )
+          track_points[3*i+j] = len * dir[j] / norm;
+        track_points[3*i]   += map->offset.X();
+        track_points[3*i+1] += map->offset.Y();
+        track_points[3*i+2] += map->offset.Z();
+      }
+    }
+    double t_random = time_lookups(map, random_points, sum);
+    double t_track  = time_lookups(map, track_points,  sum);
+    printout(ALWAYS,"FieldMapBenchmark",
+             "+++ %-24s [%s] %9ld grid points: random: %7.1f ns/lookup  tracks: %7.1f ns/lookup",
+             field.name(), rz ? "RZ " : "XYZ", long(map->numPoints()), t_random, t_track);
+    if ( check )   {
+      double max_diff = 0e0;
+      for( long i = 0; i < num_points; ++i )   {
+        const double* p = &random_points[3*i];
+        double b[3] = { 0e0, 0e0, 0e0 }, ref[3];
+        map->fieldComponents(p, b);
+        synthetic_field((p[0]-map->offset.X())/dd4hep::mm,
+                        (p[1]-map->offset.Y())/dd4hep::mm,
+                        (p[2]-map->offset.Z())/dd4hep::mm, ref);
+        for( int j = 0; j < 3; ++j )
+          max_diff = max(max_diff, fabs(b[j]/dd4hep::tesla - ref[j]));
+      }
+      printout(ALWAYS,"FieldMapBenchmark","+++ %-24s maximal deviation from synthetic field: %g tesla",
+               field.name(), max_diff);
+      if ( max_diff > 1e-4 )   {
+        printout(ERROR,"FieldMapBenchmark","+++ %s: Interpolated field differs from synthetic field.",
+                 field.name());
+        consistent = false;
+      }
+    }
+  }
+  if ( num_maps == 0 )   {
+    printout(ERROR,"FieldMapBenchmark","+++ No tabulated field present.");
+    consistent = false;
+  }
+  printout(ALWAYS,"FieldMapBenchmark","+++ Tested %ld field maps [checksum: %g]. Field map lookups consistent: %s",
+           long(num_maps), sum, consistent ? "YES" : "NO");
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_FieldMapBenchmark,field_map_benchmark)
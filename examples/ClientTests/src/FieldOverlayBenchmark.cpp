@@ -0,0 +1,134 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+ Plugin invocation:
+ ==================
+ This plugin behaves like a main program.
+ Invoke the plugin with something like this:
+
+ geoPluginRun -destroy -input file:MagnetFields.xml -plugin DD4hep_FieldOverlayBenchmark -points 1000000
+
+*/
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Fields.h"
+#include "DD4hep/DD4hepUnits.h"
+
+// C/C++ include files
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace  {
+  /// Time a field evaluation function at the given positions [nanoseconds per lookup]
+  template <typename T> double time_lookups(const vector<double>& points, vector<double>& fields, T func)  {
+    auto start = chrono::high_resolution_clock::now();
+    for( size_t i = 0; i < points.size(); i += 3 )
+      func(&points[i], &fields[i]);
+    auto stop = chrono::high_resolution_clock::now();
+    double ns = double(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    return ns / double(max(points.size()/3, size_t(1)));
+  }
+}
+
+/// Plugin function: Measure the evaluation time of the global magnetic field overlay
+/**
+ *  Factory: DD4hep_FieldOverlayBenchmark
+ *
+ *  The magnetic field is evaluated along straight tracks from the origin in
+ *  small steps like in the Geant4 tracking. The time per lookup of the flattened
+ *  overlay with bounding box culling is compared to the evaluation of all
+ *  components through the field handles. Both must give identical results.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int field_overlay_benchmark (Detector& detector, int argc, char** argv)  {
+  bool   help = false;
+  long   num_points = 1000000;
+  double step       = 1e0 * dd4hep::mm;
+  double length     = 5e0 * dd4hep::m;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-points",argv[i],4) && i+1 < argc )
+      num_points = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-step",argv[i],4) && i+1 < argc )
+      step = ::atof(argv[++i]) * dd4hep::mm;
+    else if ( 0 == ::strncmp("-length",argv[i],4) && i+1 < argc )
+      length = ::atof(argv[++i]) * dd4hep::mm;
+    else
+      help = true;
+  }
+  if ( help || num_points <= 0 || step <= 0e0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                        \n"
+      "     name:   factory name     DD4hep_FieldOverlayBenchmark               \n"
+      "     -points      <number>    Number of field lookups                    \n"
+      "     -step        <mm>        Step length along the tracks               \n"
+      "     -length      <mm>        Length of the tracks                       \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  OverlayedField overlay = detector.field();
+  const auto&    components = overlay.data<OverlayedField::Object>()->magnetic_components;
+  size_t         num_bounded = 0;
+  for( const auto& c : components )
+    num_bounded += c.data<CartesianField::Object>()->bounded() ? 1 : 0;
+
+  // Straight tracks from the origin in random directions
+  mt19937 gen(12345);
+  normal_distribution<double> dir_gen(0e0, 1e0);
+  vector<double> points(3*num_points), fields(3*num_points), reference(3*num_points);
+  for( long i = 0; i < num_points; )   {
+    double dir[3] = { dir_gen(gen), dir_gen(gen), dir_gen(gen) };
+    double norm = sqrt(dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2]);
+    for( double len = 0e0; i < num_points && len < length; ++i, len += step )   {
+      for( int j = 0; j < 3; ++j )
+        points[3*i+j] = len * dir[j] / norm;
+    }
+  }
+  double t_handles = time_lookups(points, reference, [&components](const double* p, double* b)  {
+      b[0] = b[1] = b[2] = 0e0;
+      for( const auto& c : components ) c.value(p, b);
+    });
+  double t_overlay = time_lookups(points, fields, [&overlay](const double* p, double* b)  {
+      overlay.magneticField(p, b);
+    });
+  bool consistent = true;
+  for( size_t i = 0; i < fields.size(); ++i )   {
+    if ( fields[i] != reference[i] )   {
+      printout(ERROR,"FieldOverlayBenchmark","+++ Field differs at (%g, %g, %g): %g != %g",
+               points[i/3*3], points[i/3*3+1], points[i/3*3+2], fields[i], reference[i]);
+      consistent = false;
+      break;
+    }
+  }
+  printout(ALWAYS,"FieldOverlayBenchmark",
+           "+++ %ld magnetic field components [%ld bounded]. Time per lookup: handles: %7.1f ns  overlay: %7.1f ns  [%.1f %%]",
+           long(components.size()), long(num_bounded), t_handles, t_overlay,
+           t_handles > 0e0 ? 100e0 * (t_handles - t_overlay) / t_handles : 0e0);
+  printout(ALWAYS,"FieldOverlayBenchmark","+++ Overlay field consistent: %s", consistent ? "YES" : "NO");
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_FieldOverlayBenchmark,field_overlay_benchmark)
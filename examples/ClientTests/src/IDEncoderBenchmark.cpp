@@ -0,0 +1,157 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+ Plugin invocation:
+ ==================
+ This plugin behaves like a main program.
+ Invoke the plugin with something like this:
+
+ geoPluginRun -destroy -input file:FastShower.xml -plugin DD4hep_IDEncoderBenchmark -ids 1000000
+
+*/
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Readout.h"
+#include "DD4hep/IDDescriptor.h"
+
+// C/C++ include files
+#include <chrono>
+#include <random>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace  {
+  /// Time the encoding of all volume identifiers [nanoseconds per volumeID]
+  template <typename T> double time_encoding(size_t num_ids, T func)  {
+    auto start = chrono::high_resolution_clock::now();
+    func();
+    auto stop = chrono::high_resolution_clock::now();
+    double ns = double(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    return ns / double(max(num_ids, size_t(1)));
+  }
+}
+
+/// Plugin function: Measure the volumeID encoding time of the IDDescriptor implementations
+/**
+ *  Factory: DD4hep_IDEncoderBenchmark
+ *
+ *  For every readout random field values are encoded with
+ *  - IDDescriptor::encode using the field names,
+ *  - IDDescriptor::encode using the interned field names of PlacedVolume::VolIDs,
+ *  - the precompiled IDDescriptor::Encoder one by one and in batch mode.
+ *  All implementations must give identical volume identifiers.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int id_encoder_benchmark (Detector& detector, int argc, char** argv)  {
+  bool   help = false;
+  long   num_ids = 1000000;
+  string readout_name;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-ids",argv[i],4) && i+1 < argc )
+      num_ids = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-readout",argv[i],4) && i+1 < argc )
+      readout_name = argv[++i];
+    else
+      help = true;
+  }
+  if ( help || num_ids <= 0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                        \n"
+      "     name:   factory name     DD4hep_IDEncoderBenchmark                  \n"
+      "     -ids         <number>    Number of volume identifiers to encode     \n"
+      "     -readout     <name>      Benchmark only this readout                \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  bool consistent = true;
+  mt19937 gen(12345);
+  for( const auto& r : detector.readouts() )   {
+    Readout      readout = r.second;
+    IDDescriptor dsc     = readout.idSpec();
+    if ( !dsc.isValid() || (!readout_name.empty() && readout_name != r.first) )
+      continue;
+    vector<string> names;
+    for( const auto& f : dsc.fields() )
+      names.emplace_back(f.first);
+
+    const size_t num_fields = names.size();
+    vector<int>  values(num_ids * num_fields);
+    for( long i = 0; i < num_ids; ++i )   {
+      for( size_t j = 0; j < num_fields; ++j )   {
+        const BitFieldElement* f = dsc.field(names[j]);
+        uniform_int_distribution<int> val_gen(f->minValue(), f->maxValue());
+        values[i*num_fields + j] = val_gen(gen);
+      }
+    }
+    vector<VolumeID> ref(num_ids), ids(num_ids), batch(num_ids);
+    vector<pair<string,int> > named(num_fields);
+    PlacedVolume::VolIDs interned;
+    for( const auto& n : names ) interned.insert(n, 0);
+    for( size_t j = 0; j < num_fields; ++j ) named[j].first = names[j];
+
+    double t_named = time_encoding(num_ids, [&]()  {
+        for( long i = 0; i < num_ids; ++i )   {
+          for( size_t j = 0; j < num_fields; ++j ) named[j].second = values[i*num_fields + j];
+          ref[i] = dsc.encode(named);
+        }
+      });
+    double t_interned = time_encoding(num_ids, [&]()  {
+        for( long i = 0; i < num_ids; ++i )   {
+          for( size_t j = 0; j < num_fields; ++j ) interned[j].second = values[i*num_fields + j];
+          ids[i] = dsc.encode(interned);
+        }
+      });
+    for( long i = 0; i < num_ids && consistent; ++i )   {
+      if ( ids[i] != ref[i] )   {
+        printout(ERROR,"IDEncoderBenchmark","+++ %s: Interned encoding differs: %016llX != %016llX",
+                 r.first.c_str(), (unsigned long long)ids[i], (unsigned long long)ref[i]);
+        consistent = false;
+      }
+    }
+    IDDescriptor::Encoder encoder = dsc.encoder(names);
+    double t_encoder = time_encoding(num_ids, [&]()  {
+        for( long i = 0; i < num_ids; ++i )
+          ids[i] = encoder.encode(&values[i*num_fields]);
+      });
+    double t_batch = time_encoding(num_ids, [&]()  {
+        encoder.encode(values.data(), num_ids, batch.data());
+      });
+    for( long i = 0; i < num_ids && consistent; ++i )   {
+      if ( ids[i] != ref[i] || batch[i] != ref[i] )   {
+        printout(ERROR,"IDEncoderBenchmark","+++ %s: Encoder result differs: %016llX / %016llX != %016llX",
+                 r.first.c_str(), (unsigned long long)ids[i], (unsigned long long)batch[i],
+                 (unsigned long long)ref[i]);
+        consistent = false;
+      }
+    }
+    printout(ALWAYS,"IDEncoderBenchmark",
+             "+++ %-24s %2ld fields. Time per volumeID: names: %6.1f ns  interned: %6.1f ns  "
+             "encoder: %6.1f ns  batch: %6.1f ns",
+             r.first.c_str(), long(num_fields), t_named, t_interned, t_encoder, t_batch);
+  }
+  printout(ALWAYS,"IDEncoderBenchmark","+++ Encoders consistent: %s", consistent ? "YES" : "NO");
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_IDEncoderBenchmark,id_encoder_benchmark)
@@ -0,0 +1,131 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+ Plugin invocation:
+ ==================
+ This plugin behaves like a main program.
+ Invoke the plugin with something like this:
+
+ geoPluginRun -destroy -input file:PolarNeighbours.xml -plugin DD4hep_PolarGridNeighbours
+
+*/
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Readout.h"
+#include "DD4hep/Segmentations.h"
+#include "DDSegmentation/Segmentation.h"
+
+// C/C++ include files
+#include <set>
+#include <vector>
+#include <utility>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace  {
+  typedef pair<long64, long64> Bin;
+
+  /// Expected neighbours of one cell
+  struct Expectation  {
+    const char* what;
+    Bin         cell;
+    vector<Bin> face;
+    vector<Bin> all;
+  };
+
+  /// Check the face and all neighbours of a set of cells against the expectation
+  bool check_neighbours(Detector& detector, const string& readout, const vector<Expectation>& expected)  {
+    typedef DDSegmentation::Segmentation base_t;
+    Segmentation seg = detector.readout(readout).segmentation();
+    const BitFieldCoder* decoder = seg.decoder();
+    auto make_cell = [decoder](const Bin& b)  {
+      long64 id = 0;
+      decoder->set(id, "system", 1);
+      decoder->set(id, "r",      b.first);
+      decoder->set(id, "phi",    b.second);
+      return CellID(id);
+    };
+    auto make_set = [&make_cell](const vector<Bin>& bins)  {
+      set<CellID> cells;
+      for( const auto& b : bins ) cells.insert(make_cell(b));
+      return cells;
+    };
+    bool ok = true;
+    for( const auto& e : expected )   {
+      CellID buffer[64];
+      CellID cell = make_cell(e.cell);
+      size_t num_face = seg.findNeighbours(cell, base_t::FaceNeighbours, buffer, 64);
+      bool   face_ok  = num_face <= 64 && set<CellID>(buffer, buffer+num_face) == make_set(e.face);
+      size_t num_all  = seg.findNeighbours(cell, base_t::AllNeighbours, buffer, 64);
+      bool   all_ok   = num_all <= 64 && set<CellID>(buffer, buffer+num_all) == make_set(e.all);
+      printout(face_ok && all_ok ? INFO : ERROR, "PolarNeighbours",
+               "+++ %-16s %-18s cell r:%3lld phi:%3lld  face: %ld of %ld %s  all: %ld of %ld %s",
+               seg.type().c_str(), e.what, e.cell.first, e.cell.second,
+               long(num_face), long(e.face.size()), face_ok ? "OK" : "WRONG",
+               long(num_all), long(e.all.size()), all_ok ? "OK" : "WRONG");
+      ok &= face_ok && all_ok;
+    }
+    return ok;
+  }
+}
+
+/// Plugin function: Check the neighbours of polar grid segmentations
+/**
+ *  Factory: DD4hep_PolarGridNeighbours
+ *
+ *  Requires the readouts of PolarNeighbours.xml:
+ *  - PolarRPhiHits:  PolarGridRPhi, 10 mm in r, 45 degrees in phi,
+ *    signed r and phi fields. There are no cells at negative radius
+ *    and phi does not wrap.
+ *  - PolarRPhi2Hits: PolarGridRPhi2 with 3 rings of 120, 45 and 30 degrees.
+ *    Phi wraps within a ring. In the adjacent rings the face neighbour is
+ *    the cell containing the phi centre, all neighbours are the cells
+ *    touching the phi range including the corners.
+ *  The expected neighbours of interior, wrap-around and ring boundary cells
+ *  are listed explicitly.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int polar_grid_neighbours (Detector& detector, int /* argc */, char** /* argv */)  {
+  vector<Expectation> rphi = {
+    { "interior",      {5,  3}, {{4,3},{6,3},{5,2},{5,4}},
+                                {{4,2},{4,3},{4,4},{5,2},{5,4},{6,2},{6,3},{6,4}} },
+    { "zero radius",   {0,  0}, {{1,0},{0,-1},{0,1}},
+                                {{0,-1},{0,1},{1,-1},{1,0},{1,1}} },
+    { "phi edge",      {5,127}, {{4,127},{6,127},{5,126}},
+                                {{4,126},{4,127},{5,126},{6,126},{6,127}} }
+  };
+  vector<Expectation> rphi2 = {
+    { "interior",       {1,  3}, {{1,2},{1,4},{0,1},{2,5}},
+                                 {{1,2},{1,4},{0,1},{2,4},{2,5},{2,6}} },
+    { "phi wrap",       {1,  0}, {{1,7},{1,1},{0,0},{2,0}},
+                                 {{1,7},{1,1},{0,2},{0,0},{2,11},{2,0},{2,1}} },
+    { "inner ring",     {0,  2}, {{0,1},{0,0},{1,6}},
+                                 {{0,1},{0,0},{1,5},{1,6},{1,7},{1,0}} },
+    { "outer ring",     {2,  5}, {{2,4},{2,6},{1,3}},
+                                 {{2,4},{2,6},{1,3},{1,4}} },
+    { "outer ring wrap",{2, 11}, {{2,10},{2,0},{1,7}},
+                                 {{2,10},{2,0},{1,7},{1,0}} }
+  };
+  bool ok = check_neighbours(detector, "PolarRPhiHits", rphi);
+  ok &= check_neighbours(detector, "PolarRPhi2Hits", rphi2);
+  printout(ALWAYS,"PolarNeighbours","+++ Polar grid neighbours as expected: %s", ok ? "YES" : "NO");
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_PolarGridNeighbours,polar_grid_neighbours)
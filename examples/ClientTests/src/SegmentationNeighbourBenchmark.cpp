@@ -0,0 +1,208 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+ Plugin invocation:
+ ==================
+ This plugin behaves like a main program.
+ Invoke the plugin with something like this:
+
+ geoPluginRun -destroy -input file:FastShower.xml -plugin DD4hep_SegmentationNeighbourBenchmark -cells 1000000
+
+*/
+// Framework include files
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Readout.h"
+#include "DD4hep/Segmentations.h"
+#include "DDSegmentation/Segmentation.h"
+
+// C/C++ include files
+#include <set>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace dd4hep;
+
+namespace  {
+  /// Time the neighbour search of all cells [nanoseconds per cell]
+  template <typename T> double time_search(const vector<CellID>& cells, T func)  {
+    auto start = chrono::high_resolution_clock::now();
+    for( CellID c : cells )
+      func(c);
+    auto stop = chrono::high_resolution_clock::now();
+    double ns = double(chrono::duration_cast<chrono::nanoseconds>(stop - start).count());
+    return ns / double(max(cells.size(), size_t(1)));
+  }
+
+  /// Reference neighbour search independent of the segmentation code
+  /**
+   *  Brute force loop over all +-1 combinations of the index fields.
+   *  Out of range indices are detected by the range check of BitFieldCoder::set.
+   */
+  set<CellID> reference_neighbours(const BitFieldCoder* decoder, const vector<string>& fields,
+                                   CellID cell, bool all)  {
+    set<CellID> result;
+    size_t total = 1;
+    for( size_t i = 0; i < fields.size(); ++i ) total *= 3;
+    for( size_t combination = 0; combination < total; ++combination )   {
+      long64 nID  = long64(cell);
+      size_t moved = 0;
+      try  {
+        for( size_t i = 0, digits = combination; i < fields.size(); ++i, digits /= 3 )   {
+          long64 delta = long64(digits % 3) - 1;
+          if ( delta == 0 ) continue;
+          decoder->set(nID, fields[i], decoder->get(long64(cell), fields[i]) + delta);
+          ++moved;
+        }
+      }
+      catch(const runtime_error&)  {
+        continue;
+      }
+      if ( moved == 1 || (all && moved > 1) )
+        result.insert(CellID(nID));
+    }
+    return result;
+  }
+}
+
+/// Plugin function: Measure the neighbour search time of the readout segmentations
+/**
+ *  Factory: DD4hep_SegmentationNeighbourBenchmark
+ *
+ *  For every segmented readout random cells are generated. A fraction of the
+ *  cells is placed on the boundary of the index fields. The neighbours are
+ *  searched with the std::set based Segmentation::neighbours and with the
+ *  buffer based Segmentation::findNeighbours for face and all neighbours.
+ *  For segmentations on a regular grid of indices both neighbourhoods must be
+ *  identical to a brute force search over the index fields. For PolarGridRPhi
+ *  the cells at negative radius are removed from the reference. The ring
+ *  structure of PolarGridRPhi2 is checked by DD4hep_PolarGridNeighbours.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int segmentation_neighbour_benchmark (Detector& detector, int argc, char** argv)  {
+  typedef DDSegmentation::Segmentation base_t;
+  bool   help = false;
+  long   num_cells = 1000000;
+  double edge = 0.1;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-cells",argv[i],4) && i+1 < argc )
+      num_cells = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-edge",argv[i],4) && i+1 < argc )
+      edge = ::atof(argv[++i]);
+    else
+      help = true;
+  }
+  if ( help || num_cells <= 0 || edge < 0e0 || edge > 1e0 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                        \n"
+      "     name:   factory name     DD4hep_SegmentationNeighbourBenchmark      \n"
+      "     -cells       <number>    Number of cells                            \n"
+      "     -edge        <fraction>  Fraction of cells on a field boundary      \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  const size_t capacity = 64;
+  bool    consistent = true;
+  mt19937 gen(12345);
+  uniform_real_distribution<double> flat(0e0, 1e0);
+  for( const auto& r : detector.readouts() )   {
+    Readout      readout = r.second;
+    Segmentation seg     = readout.segmentation();
+    if ( !seg.isValid() )
+      continue;
+    const BitFieldCoder* decoder = seg.decoder();
+    vector<CellID> cells(num_cells);
+    for( auto& c : cells )   {
+      c = 0;
+      for( size_t j = 0; j < decoder->size(); ++j )   {
+        const BitFieldElement& f = (*decoder)[j];
+        long64 val = uniform_int_distribution<long64>(f.minValue(), f.maxValue())(gen);
+        if ( flat(gen) < edge )
+          val = flat(gen) < 0.5 ? f.minValue() : f.maxValue();
+        c = CellID((ulong64(c) & ~f.mask()) | ((ulong64(val) << f.offset()) & f.mask()));
+      }
+    }
+    set<CellID> nb;
+    CellID      buffer[capacity];
+    size_t      num_set = 0, num_face = 0, num_all = 0;
+    double t_set = time_search(cells, [&](CellID c)  {
+        nb.clear();
+        seg.neighbours(c, nb);
+        num_set += nb.size();
+      });
+    double t_face = time_search(cells, [&](CellID c)  {
+        num_face += seg.findNeighbours(c, base_t::FaceNeighbours, buffer, capacity);
+      });
+    double t_all = time_search(cells, [&](CellID c)  {
+        num_all += seg.findNeighbours(c, base_t::AllNeighbours, buffer, capacity);
+      });
+    // Independent reference: index fields of the segmentation from its identifier parameters
+    vector<string> fields;
+    for( const auto* p : seg.parameters() )
+      if ( p->name().compare(0, 11, "identifier_") == 0 ) fields.emplace_back(p->value());
+    bool   grid  = seg.type().compare(0, 13, "CartesianGrid") == 0 || seg.type() == "PolarGridRPhi";
+    bool   polar = seg.type() == "PolarGridRPhi";
+    string r_field;
+    long64 r_min = 0;
+    if ( polar )   {
+      // Keep the bins with upper edge at positive radius
+      double size   = ::atof(seg.parameter("grid_size_r")->value().c_str());
+      double offset = ::atof(seg.parameter("offset_r")->value().c_str());
+      r_field = seg.parameter("identifier_r")->value();
+      r_min   = long64(::floor(-offset/size - 0.5)) + 1;
+    }
+    size_t num_checked = 0;
+    for( size_t i = 0; grid && i < cells.size() && i < 100000; ++i, ++num_checked )   {
+      CellID c = cells[i];
+      for( int type : { int(base_t::FaceNeighbours), int(base_t::AllNeighbours) } )   {
+        set<CellID> ref = reference_neighbours(decoder, fields, c, type == base_t::AllNeighbours);
+        if ( polar )   {
+          for( auto it = ref.begin(); it != ref.end(); )
+            it = decoder->get(long64(*it), r_field) < r_min ? ref.erase(it) : ++it;
+        }
+        size_t num = seg.findNeighbours(c, type, buffer, capacity);
+        if ( num > capacity || set<CellID>(buffer, buffer+num) != ref )   {
+          printout(ERROR,"NeighbourBenchmark","+++ %s: %s neighbours of %016llX differ: %ld != %ld",
+                   r.first.c_str(), type == base_t::AllNeighbours ? "All" : "Face",
+                   (unsigned long long)c, long(num), long(ref.size()));
+          consistent = false;
+          break;
+        }
+      }
+      if ( !consistent ) break;
+    }
+    printout(ALWAYS,"NeighbourBenchmark",
+             "+++ %-24s %-20s Time per cell: set: %7.1f ns  face: %6.1f ns  all: %6.1f ns  "
+             "Neighbours per cell: %.2f / %.2f / %.2f",
+             r.first.c_str(), seg.type().c_str(), t_set, t_face, t_all,
+             double(num_set)/double(num_cells), double(num_face)/double(num_cells),
+             double(num_all)/double(num_cells));
+    printout(ALWAYS,"NeighbourBenchmark","+++ %-24s %-20s Checked %ld cells against the brute force reference.",
+             r.first.c_str(), seg.type().c_str(), long(num_checked));
+  }
+  printout(ALWAYS,"NeighbourBenchmark","+++ Neighbour search consistent: %s", consistent ? "YES" : "NO");
+  return 1;
+}
+
+DECLARE_APPLY(DD4hep_SegmentationNeighbourBenchmark,segmentation_neighbour_benchmark)
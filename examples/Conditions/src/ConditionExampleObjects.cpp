@@ -422,7 +422,7 @@ int ConditionsKeys::operator()(DetElement de, int)  const   {
 template<typename T>
 Condition ConditionsCreator::make_condition(DetElement de, const string& name, const T& val)  const {
   Condition cond(de.path()+"#"+name, name);
-  T& value   = cond.bind<T>();
+  T& value   = arena ? cond.data().bind<T>(*arena) : cond.bind<T>();
   value      = val;
   cond->hash = ConditionKey::hashCode(de,name);
   return cond;
@@ -280,9 +280,14 @@ namespace dd4hep {
       ConditionsSlice& slice;
       /// Conditions pool the created conditions are inserted to (not equals user pool!)
       ConditionsPool&  pool;
+      /// Optional payload arena (e.g. the arena of the conditions pool)
+      OpaqueDataArena* arena = 0;
       /// Constructor
       ConditionsCreator(ConditionsSlice& s, ConditionsPool& p, PrintLevel l=DEBUG)
         : OutputLevel(l), slice(s), pool(p)  {}
+      /// Constructor with payload arena
+      ConditionsCreator(ConditionsSlice& s, ConditionsPool& p, OpaqueDataArena* a, PrintLevel l=DEBUG)
+        : OutputLevel(l), slice(s), pool(p), arena(a)  {}
       /// Destructor
       virtual ~ConditionsCreator() = default;
       /// Callback to process a single detector element
@@ -0,0 +1,328 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_benchmark \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml \
+   -pool DD4hep_ConditionsHashedPool -user_pool DD4hep_ConditionsMapUserPool \
+   -threads 1 2 4 -events 100 -output benchmark.json
+
+   Benchmark of the conditions access:
+   - memory per condition: resident memory used to populate the conditions store,
+   - derived compute time: prepare time of a slice with derived conditions minus
+                           the prepare time of a slice without,
+   - prepare latency:      time of ConditionsManager::prepare per event,
+   - access throughput:    ConditionsMap::get calls per second for all conditions
+                           of the slice for every event.
+   Every worker thread processes the events using its own conditions slice.
+   The results are written in JSON format.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TStatistic.h"
+#include "TTimeStamp.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+#include "TList.h"
+
+// C/C++ include files
+#include <mutex>
+#include <thread>
+#include <cctype>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Quote and escape a string for the use in JSON output
+  string json_string(const string& value)  {
+    stringstream str;
+    str << '"';
+    for( unsigned char c : value )  {
+      switch(c)  {
+      case '"':  str << "\\\""; break;
+      case '\\': str << "\\\\"; break;
+      case '\n': str << "\\n";  break;
+      case '\r': str << "\\r";  break;
+      case '\t': str << "\\t";  break;
+      default:
+        if ( c < 0x20 )
+          str << "\\u" << hex << setw(4) << setfill('0') << int(c) << dec << setfill(' ');
+        else
+          str << c;
+        break;
+      }
+    }
+    str << '"';
+    return str.str();
+  }
+
+  /// Collect the detector elements participating in the benchmark
+  struct DetectorCollector  {
+    vector<DetElement>& detectors;
+    size_t              max_count;
+    DetectorCollector(vector<DetElement>& d, size_t m) : detectors(d), max_count(m) {}
+    int operator()(DetElement de, int)  const  {
+      if ( detectors.size() >= max_count ) return 0;
+      detectors.emplace_back(de);
+      return 1;
+    }
+  };
+
+  /// Benchmark results of one thread configuration
+  struct ThreadResult  {
+    mutex      guard;
+    TStatistic prepare {"Prepare"};
+    long       accesses = 0;
+    long       missing  = 0;
+    double     access_time = 0e0;
+  };
+
+  /// Worker processing a number of events with its own conditions slice
+  void run_worker(ConditionsManager manager, const IOVType* iov_typ,
+                  const ConditionsSlice& proto, int id, int num_iov, int num_events,
+                  const vector<pair<DetElement,Condition::itemkey_type> >& items,
+                  ThreadResult& result)
+  {
+    ConditionsSlice slice(proto);
+    TRandom3        random(1000+id);
+    TStatistic      prepare("Prepare");
+    long            accesses = 0, missing = 0;
+    double          access_time = 0e0;
+    for( int i=0; i < num_events; ++i )  {
+      IOV req_iov(iov_typ, 1+random.Integer(num_iov*10));
+      TTimeStamp start;
+      manager.prepare(req_iov, slice);
+      TTimeStamp prepared;
+      for( const auto& item : items )  {
+        Condition c = slice.get(item.first, item.second);
+        c.isValid() ? ++accesses : ++missing;
+      }
+      TTimeStamp stop;
+      prepare.Fill(prepared.AsDouble()-start.AsDouble());
+      access_time += stop.AsDouble()-prepared.AsDouble();
+    }
+    lock_guard<mutex> lock(result.guard);
+    TList others;
+    others.Add(&prepare);
+    result.prepare.Merge(&others);
+    others.Clear("nodelete");
+    result.accesses    += accesses;
+    result.missing     += missing;
+    result.access_time += access_time;
+  }
+}
+
+/// Plugin function: Conditions access benchmark
+/**
+ *  Factory: DD4hep_ConditionExample_benchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string      input, output;
+  string      pool_type = "DD4hep_ConditionsLinearPool";
+  string      user_pool_type = "DD4hep_ConditionsMapUserPool";
+  int         num_iov = 10, num_events = 100;
+  size_t      max_detectors = ~0x0UL;
+  vector<int> num_threads;
+  bool        arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-output",argv[i],4) )
+      output = argv[++i];
+    else if ( 0 == ::strncmp("-pool",argv[i],4) )
+      pool_type = argv[++i];
+    else if ( 0 == ::strncmp("-user_pool",argv[i],4) )
+      user_pool_type = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-events",argv[i],4) )
+      num_events = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-detectors",argv[i],4) )
+      max_detectors = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )  {
+      while( i+1 < argc && argv[i+1] && ::isdigit(argv[i+1][0]) )
+        num_threads.emplace_back(::atol(argv[++i]));
+    }
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_benchmark               \n"
+      "     -input     <string>      Geometry file                                   \n"
+      "     -output    <string>      JSON output file. Default: standard output.     \n"
+      "     -pool      <string>      Conditions pool type (PoolType)                 \n"
+      "     -user_pool <string>      User pool type (UserPoolType)                   \n"
+      "     -detectors <number>      Maximal number of detector elements used.       \n"
+      "     -iovs      <number>      Number of IOV slots populated.                  \n"
+      "     -events    <number>      Number of events processed by each thread.      \n"
+      "     -threads   <n1> [n2 ...] Thread counts to be measured.                   \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+  if ( num_threads.empty() ) num_threads.emplace_back(1);
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
+  ConditionsManager manager = ConditionsManager::from(description);
+  manager["PoolType"]       = pool_type;
+  manager["UserPoolType"]   = user_pool_type;
+  manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  manager.initialize();
+  const IOVType* iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Select the detector elements **********************/
+  vector<DetElement> detectors;
+  Scanner().scan(DetectorCollector(detectors, max_detectors), description.world());
+
+  /******************** Create the slices *********************************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsContent> plain(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  ConditionsKeys                keys(*content,DEBUG), plain_keys(*plain,DEBUG);
+  ConditionsDependencyCreator   deps(*content,DEBUG);
+  for( const auto& de : detectors )  {
+    keys(de, 0);
+    plain_keys(de, 0);
+    deps(de, 0);
+  }
+  map<Condition::detkey_type,DetElement> det_map;
+  for( const auto& de : detectors ) det_map.emplace(de.key(), de);
+  vector<pair<DetElement,Condition::itemkey_type> > items;
+  for( const auto& c : content->conditions() )  {
+    ConditionKey::KeyMaker m(c.first);
+    items.emplace_back(det_map[m.values.det_key], m.values.item_key);
+  }
+  for( const auto& c : content->derived() )  {
+    ConditionKey::KeyMaker m(c.first);
+    items.emplace_back(det_map[m.values.det_key], m.values.item_key);
+  }
+
+  /******************** Populate the conditions store *********************/
+  ProcInfo_t mem_start, mem_stop;
+  size_t     num_created = 0;
+  gSystem->GetProcInfo(&mem_start);
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool*   pool = manager.registerIOV(*iov.iovType, iov.key());
+    ConditionsCreator creator(*slice, *pool, DEBUG);
+    for( const auto& de : detectors )
+      creator(de, 0);
+    num_created += pool->size();
+  }
+  gSystem->GetProcInfo(&mem_stop);
+  double mem_per_cond = num_created > 0
+    ? 1024e0*double(mem_stop.fMemResident-mem_start.fMemResident)/double(num_created) : 0e0;
+
+  /******************** Derived conditions compute time *******************/
+  TStatistic plain_stat("Plain"), derived_stat("Derived");
+  ConditionsManager::Result derived_res;
+  for(int i=0; i<num_iov; ++i)  {
+    IOV req_iov(iov_typ, i*10+5);
+    ConditionsSlice s_plain(manager, plain), s_derived(manager, content);
+    TTimeStamp start;
+    manager.prepare(req_iov, s_plain);
+    TTimeStamp middle;
+    derived_res += manager.prepare(req_iov, s_derived);
+    TTimeStamp stop;
+    plain_stat.Fill(middle.AsDouble()-start.AsDouble());
+    derived_stat.Fill(stop.AsDouble()-middle.AsDouble());
+  }
+  double derived_time = derived_res.computed > 0
+    ? (derived_stat.GetMean()-plain_stat.GetMean())*double(num_iov)/double(derived_res.computed) : 0e0;
+
+  /******************** Multi-threaded prepare and access *****************/
+  stringstream json;
+  json << setprecision(4)
+       << "{\n  \"benchmark\": \"DD4hep_ConditionExample_benchmark\",\n"
+       << "  \"geometry\": "       << json_string(input)          << ",\n"
+       << "  \"pool_type\": "      << json_string(pool_type)      << ",\n"
+       << "  \"user_pool_type\": " << json_string(user_pool_type) << ",\n"
+       << "  \"detectors\": "      << detectors.size() << ",\n"
+       << "  \"iovs\": "           << num_iov          << ",\n"
+       << "  \"events\": "         << num_events       << ",\n"
+       << "  \"conditions_created\": "   << num_created << ",\n"
+       << "  \"memory_per_condition\": " << fixed << setprecision(1) << mem_per_cond << ",\n"
+       << defaultfloat << setprecision(4)
+       << "  \"derived\": { \"computed\": " << derived_res.computed
+       << ", \"time_per_condition\": " << derived_time << " },\n"
+       << "  \"threads\": [";
+  for( size_t t=0; t < num_threads.size(); ++t )  {
+    int          nthr = num_threads[t];
+    ThreadResult result;
+    vector<thread> workers;
+    TTimeStamp start;
+    for( int i=0; i<nthr; ++i )
+      workers.emplace_back(run_worker, manager, iov_typ, std::cref(*slice), i,
+                           num_iov, num_events, std::cref(items), std::ref(result));
+    for( auto& w : workers ) w.join();
+    TTimeStamp stop;
+    double throughput = result.access_time > 0e0 ? double(result.accesses)/result.access_time : 0e0;
+    printout(INFO,"Benchmark",
+             "+  Threads: %3d  Prepare: %11.5g +- %11.4g sec  Access: %11.5g get/sec  (A:%ld,M:%ld) [%8.3f sec]",
+             nthr, result.prepare.GetMean(), result.prepare.GetMeanErr(), throughput,
+             result.accesses, result.missing, stop.AsDouble()-start.AsDouble());
+    json << (t == 0 ? "" : ",") << "\n    { \"threads\": " << nthr
+         << ", \"prepare_latency\": { \"mean\": " << result.prepare.GetMean()
+         << ", \"rms\": " << result.prepare.GetRMS()
+         << ", \"n\": "   << result.prepare.GetN() << " }"
+         << ", \"get_throughput\": " << throughput
+         << ", \"accesses\": " << result.accesses
+         << ", \"missing\": "  << result.missing
+         << ", \"elapsed\": "  << stop.AsDouble()-start.AsDouble() << " }";
+  }
+  json << "\n  ]\n}\n";
+
+  if ( output.empty() )  {
+    cout << json.str() << flush;
+  }
+  else  {
+    FILE* file = ::fopen(output.c_str(),"w");
+    if ( !file )
+      except("Benchmark","+++ Failed to open output file %s [%s]",output.c_str(),::strerror(errno));
+    const string text = json.str();
+    ::fwrite(text.c_str(), 1, text.length(), file);
+    ::fclose(file);
+    printout(INFO,"Benchmark","+++ Wrote benchmark results to %s",output.c_str());
+  }
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_benchmark,condition_example)
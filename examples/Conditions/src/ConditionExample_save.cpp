@@ -29,6 +29,7 @@
 #include "DDCond/ConditionsManager.h"
 #include "DDCond/ConditionsIOVPool.h"
 #include "DDCond/ConditionsRootPersistency.h"
+#include "DDCond/ConditionsMappedSnapshot.h"
 #include "DD4hep/Factories.h"
 
 using namespace std;
@@ -44,7 +45,7 @@ using namespace dd4hep::ConditionExamples;
  *  \date    01/12/2016
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
-  string input, conditions;
+  string input, conditions, mapped;
   int    num_iov = 10;
   bool   arg_error = false;
   bool   output_iovpool  = true;
@@ -56,6 +57,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       input = argv[++i];
     else if ( 0 == ::strncmp("-conditions",argv[i],4) )
       conditions = argv[++i];
+    else if ( 0 == ::strncmp("-mapped",argv[i],4) )
+      mapped = argv[++i];
     else if ( 0 == ::strncmp("-iovs",argv[i],4) )
       num_iov = ::atol(argv[++i]);
     else
@@ -69,6 +72,7 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -input       <string>    Geometry file                                   \n"
       "     -conditions  <string>    Conditions output file                          \n"
       "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
+      "     -mapped      <string>    Optional: also write a mapped snapshot file     \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -163,6 +167,19 @@ static int condition_example (Detector& description, int argc, char** argv)  {
              "+++ Successfully saved %ld condition to file.",total_count);
   }
   delete persist;
+
+  if ( !mapped.empty() )  {
+    cond::ConditionsMappedSnapshot snapshot;
+    count = snapshot.add(*manager.iovPool(*iov_typ));
+    long nb = snapshot.save(mapped);
+    printout(ALWAYS,"Example",
+             "+++ Wrote %ld Bytes (%ld conditions) of data to mapped snapshot '%s'  [%8.3f seconds].",
+             nb, count, mapped.c_str(), snapshot.duration);
+    if ( nb > 0 )  {
+      printout(ALWAYS,"Example",
+               "+++ Successfully saved %ld condition to mapped snapshot.",count);
+    }
+  }
   
   printout(ALWAYS,"Statistics","+=========================================================================");
   printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
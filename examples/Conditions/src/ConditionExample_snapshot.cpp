@@ -0,0 +1,137 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_snapshot \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml \
+   -conditions Conditions.mapped -format mapped
+
+   Benchmark the open-to-first-access time of conditions snapshots.
+   The snapshot files are written by DD4hep_ConditionExample_save.
+   - format 'root':   load the ROOT object, import the IOV pool and prepare the first slice.
+   - format 'mapped': map the columnar snapshot and prepare the first slice.
+                      Conditions are materialized by the loader on demand.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsManager.h"
+#include "DDCond/ConditionsDataLoader.h"
+#include "DDCond/ConditionsRootPersistency.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+static void help(int argc, char** argv)  {
+  /// Help printout describing the basic command line interface
+  cout <<
+    "Usage: -plugin <name> -arg [-arg]                                             \n"
+    "     name:   factory name     DD4hep_ConditionExample_snapshot                \n"
+    "     -input       <string>    Geometry file                                   \n"
+    "     -conditions  <string>    Conditions snapshot file                        \n"
+    "     -format      <string>    Snapshot format: root or mapped.                \n"
+    "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
+    "\tArguments given: " << arguments(argc,argv) << endl << flush;
+  ::exit(EINVAL);
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_snapshot
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    01/12/2016
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input, conditions, format="mapped";
+  int    num_iov = 10;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-conditions",argv[i],4) )
+      conditions = argv[++i];
+    else if ( 0 == ::strncmp("-format",argv[i],4) )
+      format = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || conditions.empty() ) help(argc,argv);
+  if ( format != "root" && format != "mapped" ) help(argc,argv);
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
+  ConditionsManager manager = ConditionsManager::from(description);
+  manager["PoolType"]       = "DD4hep_ConditionsLinearPool";
+  manager["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+  manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  if ( format == "mapped" )
+    manager["LoaderType"]   = "DD4hep_Conditions_mapped_snapshot_Loader";
+  manager.initialize();
+  const IOVType* iov_typ = manager.registerIOVType(0,"run").second;
+
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+
+  /******************** Open the snapshot and access the first slice ******/
+  ConditionsManager::Result total;
+  TTimeStamp start;
+  if ( format == "root" )  {
+    auto pers = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
+    pers->importIOVPool("ConditionsIOVPool No 1","run",manager);
+  }
+  else  {
+    manager.loader().addSource(conditions);
+  }
+  total += manager.prepare(IOV(iov_typ,5),*slice);
+  TTimeStamp first;
+
+  // ++++++++++++++++++++++++ Now access the remaining IOVs
+  for(int i=1; i<num_iov; ++i)  {
+    IOV req_iov(iov_typ,i*10+5);
+    ConditionsManager::Result r = manager.prepare(req_iov,*slice);
+    total += r;
+    printout(INFO,"Prepare","Total %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s",
+             r.total(), r.selected, r.loaded, r.computed, r.missing, req_iov.str().c_str());
+  }
+  TTimeStamp stop;
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  printout(ALWAYS,"Statistics","+  Snapshot format: %s  file: %s",format.c_str(),conditions.c_str());
+  printout(ALWAYS,"Statistics","+  Open-to-first-access: %8.3f seconds.",
+           first.AsDouble()-start.AsDouble());
+  printout(ALWAYS,"Statistics","+  Access of all %d IOVs: %8.3f seconds.",
+           num_iov, stop.AsDouble()-start.AsDouble());
+  printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+           total.total(), total.selected, total.loaded, total.computed, total.missing);
+  printout(ALWAYS,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_snapshot,condition_example)
@@ -29,6 +29,7 @@
 #include "TStatistic.h"
 #include "TTimeStamp.h"
 #include "TRandom3.h"
+#include "TSystem.h"
 
 using namespace std;
 using namespace dd4hep;
@@ -45,7 +46,7 @@ using namespace dd4hep::ConditionExamples;
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
   int    num_iov = 10, num_runs = 10;
-  bool   arg_error = false;
+  bool   arg_error = false, use_arena = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -53,6 +54,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       num_iov = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-runs",argv[i],4) )
       num_runs = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-arena",argv[i],4) )
+      use_arena = true;
     else
       arg_error = true;
   }
@@ -64,6 +67,7 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -input   <string>        Geometry file                                   \n"
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
+      "     -arena                   Allocate payloads from the pool memory arena.   \n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -85,6 +89,8 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
 
   TStatistic cr_stat("Creation"), acc_stat("Access");
+  ProcInfo_t mem_start, mem_created;
+  gSystem->GetProcInfo(&mem_start);
   /******************** Populate the conditions store *********************/
   // Have 10 run-slices [11,20] .... [91,100]
   size_t total_created = 0;
@@ -93,13 +99,15 @@ static int condition_example (Detector& description, int argc, char** argv)  {
     IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
     ConditionsPool*   iov_pool = manager.registerIOV(*iov.iovType, iov.key());
     // Create conditions with all deltas.  Use a generic creator
-    int count = Scanner().scan(ConditionsCreator(*slice, *iov_pool, DEBUG), description.world());
+    OpaqueDataArena*  arena = use_arena ? &iov_pool->arena() : 0;
+    int count = Scanner().scan(ConditionsCreator(*slice, *iov_pool, arena, DEBUG), description.world());
     TTimeStamp stop;
     cr_stat.Fill(stop.AsDouble()-start.AsDouble());
     printout(INFO,"Example", "Setup %ld conditions for IOV:%s [%8.3f sec]",
              count, iov.str().c_str(), stop.AsDouble()-start.AsDouble());
     total_created += count;
   }
+  gSystem->GetProcInfo(&mem_created);
 
   // ++++++++++++++++++++++++ Now compute the conditions for each of these IOVs
   TRandom3 random;
@@ -125,6 +133,15 @@ static int condition_example (Detector& description, int argc, char** argv)  {
            acc_stat.GetName(), acc_stat.GetMean(), acc_stat.GetMeanErr(), acc_stat.GetRMS(), acc_stat.GetN());
   printout(INFO,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld). Created:%ld",
            total.total(), total.selected, total.loaded, total.computed, total.missing, total_created);
+
+  // ++++++++++++++++++++++++ Release all conditions and measure the teardown
+  TTimeStamp start_clear;
+  slice->reset();
+  manager.clear();
+  TTimeStamp stop_clear;
+  printout(INFO,"Statistics","+  Payload allocation: %s  Memory for creation: %ld kB  Teardown: %8.3f sec",
+           use_arena ? "arena" : "heap ", mem_created.fMemResident-mem_start.fMemResident,
+           stop_clear.AsDouble()-start_clear.AsDouble());
   printout(INFO,"Statistics","+=========================================================================");
   // All done.
   return 1;
@@ -0,0 +1,115 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Read events written by Geant4Output2ROOT with the DigiDDG4Input action
+#  and measure the event throughput as a function of the number of events
+#  processed in parallel.
+#
+#  python TestDDG4Input.py -input <file.root> [-input <file.root>]
+#                          -compact <compact.xml> -events <n> -parallel 1 2 4 8
+#                          [-readahead <n>] [-debug]
+#
+#  With -debug every event delivered by the read-ahead thread is printed.
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals, print_function
+import subprocess
+import sys
+import time
+import DDDigi
+
+
+def make_kernel(compact, inputs, num_events, num_parallel, read_ahead, debug):
+  kernel = DDDigi.Kernel()
+  kernel.loadGeometry(str('file:' + compact))
+  reader = DDDigi.EventAction(kernel, 'DigiDDG4Input/Input')
+  reader.Input = [str(i) for i in inputs]
+  reader.ReadAhead = read_ahead
+  if debug:
+    reader.OutputLevel = DDDigi.OutputLevel.DEBUG
+  kernel.inputAction().adopt(reader)
+  kernel.numThreads = 0   # = number of concurrent threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  return kernel
+
+
+def run():
+  inputs = []
+  compact = None
+  num_events = 100
+  read_ahead = 8
+  debug = False
+  parallel = []
+  args = sys.argv[1:]
+  i = 0
+  while i < len(args):
+    if args[i] == '-input':
+      i = i + 1
+      inputs.append(args[i])
+    elif args[i] == '-compact':
+      i = i + 1
+      compact = args[i]
+    elif args[i] == '-events':
+      i = i + 1
+      num_events = int(args[i])
+    elif args[i] == '-readahead':
+      i = i + 1
+      read_ahead = int(args[i])
+    elif args[i] == '-debug':
+      debug = True
+    elif args[i] == '-parallel':
+      while i + 1 < len(args) and args[i + 1].isdigit():
+        i = i + 1
+        parallel.append(int(args[i]))
+    else:
+      print('Unknown argument: ' + args[i])
+      sys.exit(1)
+    i = i + 1
+  if not inputs or not compact:
+    print('Usage: python TestDDG4Input.py -input <file> -compact <xml> '
+          '[-events <n>] [-readahead <n>] [-parallel n1 n2 ...] [-debug]')
+    sys.exit(1)
+  if not parallel:
+    parallel = [1]
+
+  if len(parallel) > 1:
+    # The digitization kernel is a singleton: every setup runs in its own process
+    results = []
+    for num_parallel in parallel:
+      cmd = [sys.executable, sys.argv[0], '-compact', compact, '-events', str(num_events),
+             '-readahead', str(read_ahead), '-parallel', str(num_parallel)]
+      for inp in inputs:
+        cmd = cmd + ['-input', inp]
+      if debug:
+        cmd.append('-debug')
+      out = subprocess.check_output(cmd).decode('utf-8')
+      for line in out.splitlines():
+        if line.startswith('+  maxEventsParallel:'):
+          results.append(line)
+    print('+======= DigiDDG4Input throughput: %d events ==========================' % (num_events,))
+    for line in results:
+      print(line)
+    print('+=====================================================================')
+    return
+
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = make_kernel(compact, inputs, num_events, parallel[0], read_ahead, debug)
+  start = time.time()
+  kernel.run()
+  elapsed = time.time() - start
+  kernel.terminate()
+  rate = num_events / elapsed if elapsed > 0 else 0.0
+  print('+  maxEventsParallel: %3d  Time: %9.3f sec  Rate: %9.2f events/s' % (parallel[0], elapsed, rate))
+
+
+if __name__ == '__main__':
+  run()
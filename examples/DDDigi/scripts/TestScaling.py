@@ -0,0 +1,89 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Scaling test of the DDDigi kernel scheduler: events are processed
+#  concurrently (maxEventsParallel) and within each event the subdetector
+#  sequences are executed in parallel. All tasks share one TBB arena.
+#
+#  python TestScaling.py -threads <n> -parallel <n> -events <n> [-timing]
+#                         [-trace <file.json>] [-folded <file.txt>]
+#
+#  -trace:  execution trace for chrome://tracing, Perfetto or speedscope
+#  -folded: folded call stacks for flamegraph.pl
+#
+# ==========================================================================
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import DDDigi
+from TestFramework import make_input, make_subdetector
+
+
+def run():
+  num_threads = 0
+  num_parallel = 1
+  num_events = 20
+  timing = False
+  trace = ''
+  folded = ''
+  args = sys.argv[1:]
+  i = 0
+  while i < len(args):
+    if args[i] == '-threads':
+      i = i + 1
+      num_threads = int(args[i])
+    elif args[i] == '-parallel':
+      i = i + 1
+      num_parallel = int(args[i])
+    elif args[i] == '-events':
+      i = i + 1
+      num_events = int(args[i])
+    elif args[i] == '-timing':
+      timing = True
+    elif args[i] == '-trace':
+      i = i + 1
+      trace = args[i]
+    elif args[i] == '-folded':
+      i = i + 1
+      folded = args[i]
+    else:
+      print('Usage: python TestScaling.py -threads <n> -parallel <n> -events <n> [-timing] '
+            '[-trace <file>] [-folded <file>]')
+      sys.exit(1)
+    i = i + 1
+
+  DDDigi.setPrintFormat(str('%-32s %5s %s'))
+  kernel = DDDigi.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  fname = "file:" + install_dir + "/examples/ClientTests/compact/MiniTel.xml"
+  kernel.loadGeometry(str(fname))
+  digi = DDDigi.Digitize(kernel)
+
+  event_processor = DDDigi.Synchronize(kernel, 'DigiSynchronize/MainDigitizer', True)
+  event_processor.parallel = True
+  make_input(kernel)
+  for d in digi.activeDetectors():
+    event_processor.adopt(make_subdetector(kernel, d['name']))
+  kernel.eventAction().adopt(event_processor)
+  kernel.outputAction().adopt(DDDigi.TestAction(kernel, 'output_01', 200))
+
+  kernel.numThreads = num_threads
+  kernel.numEvents = num_events
+  kernel.maxEventsParallel = num_parallel
+  kernel.actionTiming = timing
+  kernel.profileTrace = str(trace)
+  kernel.profileFolded = str(folded)
+  kernel.run()
+  kernel.terminate()
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,197 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiData.h>
+
+/// C/C++ include files
+#include <random>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+namespace {
+  /// Simple hit structure standing in for the simulation hits
+  struct Hit  {
+    long long int cellID;
+    long          flag;
+    double        energy;
+    Position      position;
+  };
+}
+
+/// Plugin to test the columnar deposit containers
+/**
+ *  Several threads fill the deposits of their detector segments into the
+ *  columnar containers of one event and merge a spillover event into them.
+ *  The merged containers are then compacted once and a compacted spillover
+ *  event is merged again, which uses the linear merge of sorted columns.
+ *  The energy sums are compared with the sums obtained by iterating the
+ *  polymorphic energy deposits.
+ *
+ *  Factory: DD4hep_DigiDepositColumns
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiDepositColumns(Detector& /* description */, int argc, char** argv) {
+  size_t num_hits     = 1000000;
+  int    num_segments = 8;
+  int    num_threads  = 4;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-hits",argv[i],3) )
+      num_hits     = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-segments",argv[i],3) )
+      num_segments = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],3) )
+      num_threads  = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiDepositColumns -arg [-arg]                    \n"
+        "     -hits     <value>  Number of hits per segment [default: 1000000]    \n"
+        "     -segments <value>  Number of detector segments [default: 8]         \n"
+        "     -threads  <value>  Number of threads [default: 4]                   \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  num_threads  = std::max(1, num_threads);
+  num_segments = std::max(1, num_segments);
+
+  // Hits and polymorphic deposits of all segments
+  EnergyDeposit::FunctionTable table;
+  table.cellID   = [](const void* p)  { return ((const Hit*)p)->cellID;   };
+  table.flag     = [](const void* p)  { return ((const Hit*)p)->flag;     };
+  table.deposit  = [](const void* p)  { return ((const Hit*)p)->energy;   };
+  table.position = [](const void* p) -> const Position&  { return ((const Hit*)p)->position; };
+  std::mt19937_64 engine(12345);
+  std::uniform_int_distribution<long long int> cells(0, num_hits/4);
+  std::exponential_distribution<double>       energy(1e0);
+  std::vector<std::vector<Hit> >                hits(num_segments);
+  std::vector<std::vector<EnergyDeposit> >      handles(num_segments);
+  std::vector<std::shared_ptr<DigiEnergyDeposits> > deposits(num_segments);
+  for( int s = 0; s < num_segments; ++s )   {
+    hits[s].resize(num_hits);
+    handles[s].reserve(num_hits);
+    deposits[s] = std::make_shared<DigiEnergyDeposits>("Segment"+std::to_string(s));
+    for( auto& h : hits[s] )   {
+      h = Hit{cells(engine), 0, energy(engine), Position(1,2,3)};
+      handles[s].emplace_back(&h, &table);
+      deposits[s]->emplace_back(&handles[s].back());
+    }
+  }
+
+  // Reference: iterate the polymorphic deposits
+  auto start = std::chrono::high_resolution_clock::now();
+  double sum_objects = 0e0;
+  for( const auto& d : deposits )
+    for( const auto* dep : *d )
+      sum_objects += dep->deposit();
+  std::chrono::duration<double> t_objects = std::chrono::high_resolution_clock::now() - start;
+
+  // Fill signal and spillover columns concurrently: threads share the segments
+  DigiEvent event(1), spillover(2);
+  std::vector<std::thread> workers;
+  for( int t = 0; t < num_threads; ++t )   {
+    workers.emplace_back([&, t]()  {
+        for( int s = t; s < num_segments; s += num_threads )   {
+          std::string nam = "Segment"+std::to_string(s);
+          Key key(0, nam);
+          event.columns(key, nam).append(*deposits[s]);
+          spillover.columns(key, nam).append(*deposits[s]);
+        }
+      });
+  }
+  for( auto& w : workers ) w.join();
+  workers.clear();
+
+  // Stream through the columns
+  start = std::chrono::high_resolution_clock::now();
+  double sum_columns = 0e0;
+  for( const auto& c : event.depositColumns )   {
+    const double* e = c.second->energy.data();
+    for( size_t i = 0, n = c.second->size(); i < n; ++i )
+      sum_columns += e[i];
+  }
+  std::chrono::duration<double> t_columns = std::chrono::high_resolution_clock::now() - start;
+
+  // Merge the spillover (shifted by one bunch crossing) from several threads
+  start = std::chrono::high_resolution_clock::now();
+  for( int t = 0; t < num_threads; ++t )   {
+    workers.emplace_back([&, t]()  {
+        int s = 0;
+        for( const auto& c : spillover.depositColumns )   {
+          if ( (s++ % num_threads) == t )
+            event.depositColumns.at(c.first)->merge(*c.second, -25e0);
+        }
+      });
+  }
+  for( auto& w : workers ) w.join();
+  std::chrono::duration<double> t_merge = std::chrono::high_resolution_clock::now() - start;
+
+  double sum_merged = 0e0;
+  for( const auto& c : event.depositColumns )
+    for( double e : c.second->energy ) sum_merged += e;
+
+  // Sort once on read, then merge the compacted spillover of the next crossing
+  start = std::chrono::high_resolution_clock::now();
+  for( const auto& c : event.depositColumns )   {
+    c.second->compact();
+    spillover.depositColumns.at(c.first)->compact();
+  }
+  std::chrono::duration<double> t_compact = std::chrono::high_resolution_clock::now() - start;
+  start = std::chrono::high_resolution_clock::now();
+  for( const auto& c : spillover.depositColumns )
+    event.depositColumns.at(c.first)->merge(*c.second, 25e0);
+  std::chrono::duration<double> t_sorted = std::chrono::high_resolution_clock::now() - start;
+
+  bool   sorted     = true;
+  double sum_sorted = 0e0;
+  size_t num_cells  = 0;
+  for( const auto& c : event.depositColumns )   {
+    const auto& cols = *c.second;
+    sorted &= cols.sorted();
+    for( size_t i = 0; i < cols.size(); ++i )   {
+      sum_sorted += cols.energy[i];
+      if ( i > 0 && cols.cellID[i-1] >= cols.cellID[i] ) sorted = false;
+    }
+    num_cells += cols.size();
+  }
+  bool ok = std::fabs(sum_columns - sum_objects) < 1e-9 * sum_objects &&
+            std::fabs(sum_merged - 2e0*sum_objects) < 1e-9 * sum_objects &&
+            std::fabs(sum_sorted - 3e0*sum_objects) < 1e-9 * sum_objects && sorted;
+  printout(INFO, "DepositColumns", "Segments: %d  hits/segment: %ld  threads: %d",
+           num_segments, num_hits, num_threads);
+  printout(INFO, "DepositColumns", "Objects : %9.4f sec  sum: %15.6f",
+           t_objects.count(), sum_objects);
+  printout(INFO, "DepositColumns", "Columns : %9.4f sec  sum: %15.6f",
+           t_columns.count(), sum_columns);
+  printout(INFO, "DepositColumns", "Merge   : %9.4f sec  sum: %15.6f",
+           t_merge.count(), sum_merged);
+  printout(INFO, "DepositColumns", "Compact : %9.4f sec",
+           t_compact.count());
+  printout(INFO, "DepositColumns", "Sorted  : %9.4f sec  sum: %15.6f  cells: %ld  ordered: %s",
+           t_sorted.count(), sum_sorted, num_cells, yes_no(sorted));
+  printout(INFO, "DepositColumns", "Energy sums consistent: %s", ok ? "YES" : "NO");
+  return ok ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiDepositColumns,test_DigiDepositColumns)
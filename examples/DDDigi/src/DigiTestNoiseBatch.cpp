@@ -0,0 +1,132 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiGaussianNoise.h>
+#include <DDDigi/DigiRandomGenerator.h>
+
+/// C/C++ include files
+#include <random>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+/// Plugin to test the batched noise generation of the signal processors
+/**
+ *  Compares the throughput of the per-cell random generation with the
+ *  batched generation using the counter based random stream. Checks
+ *  that the batched result does not depend on the batch size and on
+ *  the number of threads used.
+ *
+ *  Factory: DD4hep_DigiNoiseBatch
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiNoiseBatch(Detector& description, int argc, char** argv) {
+  size_t num_cells   = 1000000;
+  size_t batch_size  = 4096;
+  int    num_threads = 4;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-cells",argv[i],3) )
+      num_cells   = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-batch",argv[i],3) )
+      batch_size  = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],3) )
+      num_threads = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiNoiseBatch -arg [-arg]                        \n"
+        "     -cells    <value>  Number of detector cells [default: 1000000]      \n"
+        "     -batch    <value>  Number of cells per batch [default: 4096]        \n"
+        "     -threads  <value>  Number of threads [default: 4]                   \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  num_threads = std::max(1, num_threads);
+  batch_size  = std::max(size_t(1), batch_size);
+
+  DigiKernel&        kernel = DigiKernel::instance(description);
+  DigiGaussianNoise* noise  = new DigiGaussianNoise(kernel, "GaussianNoise");
+  noise->property("sigma").set(1.0);
+  DigiContext        context(&kernel);
+  DigiRandomStream   random(12345, 1, 0xFEED);
+  std::vector<double> signals(num_cells, 0e0);
+  std::vector<double> single(num_cells, 0e0), reference(num_cells, 0e0), threaded(num_cells, 0e0);
+
+  // Per-cell generation through the std::function engine
+  std::mt19937_64                        engine(12345);
+  std::uniform_real_distribution<double> flat(0e0, 1e0);
+  DigiRandomGenerator                    generator;
+  generator.engine = [&engine, &flat]()  { return flat(engine); };
+  auto start = std::chrono::high_resolution_clock::now();
+  for( size_t i=0; i < num_cells; ++i )
+    single[i] += generator.gaussian(0e0, 1e0);
+  std::chrono::duration<double> t_single = std::chrono::high_resolution_clock::now() - start;
+
+  // Batched generation: one single batch
+  start = std::chrono::high_resolution_clock::now();
+  DigiCellBatch all(context, random, 0, num_cells, signals.data(), reference.data());
+  noise->process(all);
+  std::chrono::duration<double> t_batch = std::chrono::high_resolution_clock::now() - start;
+
+  // Batched generation: batches distributed to several threads
+  start = std::chrono::high_resolution_clock::now();
+  std::vector<std::thread> workers;
+  for( int t=0; t < num_threads; ++t )   {
+    workers.emplace_back([&, t]()  {
+        for( size_t first = t*batch_size; first < num_cells; first += num_threads*batch_size )  {
+          size_t len = std::min(batch_size, num_cells-first);
+          DigiCellBatch batch(context, random, first, len, signals.data()+first, threaded.data()+first);
+          noise->process(batch);
+        }
+      });
+  }
+  for( auto& w : workers ) w.join();
+  std::chrono::duration<double> t_threaded = std::chrono::high_resolution_clock::now() - start;
+
+  double mean = 0e0, mean2 = 0e0;
+  for( double v : reference )  {
+    mean  += v;
+    mean2 += v*v;
+  }
+  mean /= double(num_cells);
+  bool identical = 0 == ::memcmp(reference.data(), threaded.data(), num_cells*sizeof(double));
+  printout(INFO, "NoiseBatch", "Cells: %ld  batch size: %ld  threads: %d",
+           num_cells, batch_size, num_threads);
+  printout(INFO, "NoiseBatch", "Per cell  : %9.4f sec  %12.4g cells/sec",
+           t_single.count(), double(num_cells)/t_single.count());
+  printout(INFO, "NoiseBatch", "Batched   : %9.4f sec  %12.4g cells/sec",
+           t_batch.count(), double(num_cells)/t_batch.count());
+  printout(INFO, "NoiseBatch", "Threaded  : %9.4f sec  %12.4g cells/sec",
+           t_threaded.count(), double(num_cells)/t_threaded.count());
+  printout(INFO, "NoiseBatch", "Distribution  Mean %10.5f RMS %10.5f",
+           mean, std::sqrt(mean2/double(num_cells) - mean*mean));
+  printout(INFO, "NoiseBatch", "Reproducible independent of batching and threads: %s",
+           identical ? "YES" : "NO");
+  noise->release();
+  return identical ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiNoiseBatch,test_DigiNoiseBatch)
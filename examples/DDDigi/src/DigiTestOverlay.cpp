@@ -0,0 +1,160 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiOverlayInput.h>
+
+/// C/C++ include files
+#include <random>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+/// Plugin to test the pile-up and spillover overlay
+/**
+ *  A synthetic background pool is overlaid with a fixed number of events
+ *  per bunch crossing. Every pool container carries a total energy of 1:
+ *  the energy of the overlaid event is known exactly. The merged columns
+ *  must be sorted by cell without duplicates and the overlay must be
+ *  reproducible. The throughput is printed in events per second.
+ *
+ *  Factory: DD4hep_DigiOverlay
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiOverlay(Detector& description, int argc, char** argv) {
+  size_t num_pool       = 100;
+  size_t num_deposits   = 2000;
+  int    num_containers = 4;
+  int    num_events     = 10;
+  int    num_bx         = 1;
+  double mu             = 200e0;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-pool",argv[i],3) )
+      num_pool       = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-deposits",argv[i],3) )
+      num_deposits   = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-containers",argv[i],3) )
+      num_containers = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-events",argv[i],3) )
+      num_events     = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-bx",argv[i],3) )
+      num_bx         = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-mu",argv[i],3) )
+      mu             = ::atof(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiOverlay -arg [-arg]                           \n"
+        "     -pool       <value>  Number of events in the pool [default: 100]    \n"
+        "     -deposits   <value>  Deposits per pool container [default: 2000]    \n"
+        "     -containers <value>  Number of containers [default: 4]              \n"
+        "     -events     <value>  Number of signal events [default: 10]          \n"
+        "     -bx         <value>  Number of bunch crossings [default: 1]         \n"
+        "     -mu         <value>  Background events per crossing [default: 200]  \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  num_pool = std::max(size_t(1), num_pool);
+  num_bx   = std::max(1, num_bx);
+  mu       = std::floor(mu + 0.5);
+
+  // Synthetic background pool: the energy of every container adds up to 1
+  std::mt19937_64 engine(12345);
+  std::uniform_int_distribution<DigiDepositColumns::CellID> cells(0, 100*num_deposits);
+  std::exponential_distribution<double> energy(1e0);
+  auto pool = std::make_shared<DigiOverlayPool>();
+  for( size_t p = 0; p < num_pool; ++p )   {
+    DigiOverlayPool::event_t evt;
+    for( int c = 0; c < num_containers; ++c )   {
+      std::string nam = "Container"+std::to_string(c);
+      auto cols = std::make_shared<DigiDepositColumns>(nam);
+      std::vector<double> e(num_deposits);
+      double sum = 0e0;
+      for( auto& v : e ) sum += (v = energy(engine));
+      for( double v : e )
+        cols->emplace_back(cells(engine), v/sum, 0e0, Position());
+      evt.emplace(Key(0, nam).toLong(), cols);
+    }
+    pool->add(std::move(evt));
+  }
+
+  DigiKernel&       kernel  = DigiKernel::instance(description);
+  DigiOverlayInput* overlay = new DigiOverlayInput(kernel, "Overlay");
+  std::vector<int>  crossings;
+  for( int b = 0; b < num_bx; ++b ) crossings.emplace_back(b - num_bx + 1);
+  bool   ok = true;
+  size_t num_cells = 0;
+  std::chrono::duration<double> elapsed(0e0);
+  try   {
+    overlay->property("Mu").set(mu);
+    overlay->property("Poisson").set(false);
+    overlay->property("BunchCrossings").set(crossings);
+    overlay->setPool(pool);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int evt = 0; evt < num_events; ++evt )   {
+      DigiEvent   event(evt);
+      DigiContext context(&kernel, &event);
+      overlay->execute(context);
+      double sum = 0e0;
+      for( const auto& c : event.depositColumns )   {
+        const auto& cols = *c.second;
+        for( size_t i = 0; i < cols.size(); ++i )   {
+          sum += cols.energy[i];
+          if ( i > 0 && cols.cellID[i-1] >= cols.cellID[i] ) ok = false;
+        }
+        num_cells += cols.size();
+      }
+      double expected = mu * double(num_bx) * double(num_containers);
+      if ( std::fabs(sum - expected) > 1e-9 * expected ) ok = false;
+    }
+    elapsed = std::chrono::high_resolution_clock::now() - start;
+
+    // Reproducibility: the same event overlaid twice must be identical
+    DigiEvent   first(7), second(7);
+    DigiContext ctx1(&kernel, &first), ctx2(&kernel, &second);
+    overlay->execute(ctx1);
+    overlay->execute(ctx2);
+    for( const auto& c : first.depositColumns )   {
+      const auto& other = *second.depositColumns.at(c.first);
+      if ( c.second->cellID != other.cellID || c.second->energy != other.energy ) ok = false;
+    }
+  }
+  catch(...)   {
+    overlay->release();
+    throw;
+  }
+  overlay->release();
+
+  printout(INFO, "Overlay", "Pool: %ld events  deposits/container: %ld  containers: %d",
+           num_pool, num_deposits, num_containers);
+  printout(INFO, "Overlay", "Mu: %g  bunch crossings: %d  cells/event: %ld",
+           mu, num_bx, num_events > 0 ? num_cells/num_events : 0);
+  printout(INFO, "Overlay", "Throughput: %9.2f events/sec",
+           elapsed.count() > 0 ? double(num_events)/elapsed.count() : 0e0);
+  printout(INFO, "Overlay", "Overlay consistent: %s", ok ? "YES" : "NO");
+  return ok ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiOverlay,test_DigiOverlay)
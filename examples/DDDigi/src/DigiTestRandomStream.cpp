@@ -0,0 +1,71 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiRandomStream.h>
+
+/// C/C++ include files
+#include <cstdint>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+/// Plugin to check the counter based random stream against known answers
+/**
+ *  The Philox4x32-10 output of DigiRandomStream::block is compared to the
+ *  known-answer vectors published with the Random123 library (kat_vectors).
+ *  The 128 bit counter is made of the cell number (words 0,1) and the draw
+ *  number (words 2,3), the 64 bit key is the raw stream key.
+ *
+ *  Factory: DD4hep_DigiRandomStreamKAT
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiRandomStreamKAT(Detector& /* description */, int /* argc */, char** /* argv */) {
+  struct kat_t  {
+    std::uint32_t counter[4];
+    std::uint32_t key[2];
+    std::uint32_t expected[4];
+  };
+  static const kat_t vectors[] = {
+    { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 },
+      { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+    { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+    { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }
+  };
+  int num_failed = 0;
+  for( const auto& v : vectors )   {
+    std::uint32_t out[4];
+    DigiRandomStream stream((std::uint64_t(v.key[1])<<32) | v.key[0]);
+    stream.block((std::uint64_t(v.counter[1])<<32) | v.counter[0],
+                 (std::uint64_t(v.counter[3])<<32) | v.counter[2], out);
+    bool ok = true;
+    for( int i = 0; i < 4; ++i )
+      ok = ok && out[i] == v.expected[i];
+    printout(ok ? INFO : ERROR, "RandomStreamKAT",
+             "Key: %08x %08x Counter: %08x %08x %08x %08x -> %08x %08x %08x %08x  %s",
+             v.key[0], v.key[1], v.counter[0], v.counter[1], v.counter[2], v.counter[3],
+             out[0], out[1], out[2], out[3], ok ? "OK" : "FAILED");
+    if ( !ok ) ++num_failed;
+  }
+  printout(INFO, "RandomStreamKAT", "Known-answer test of Philox4x32-10: %s",
+           num_failed == 0 ? "PASSED" : "FAILED");
+  return num_failed == 0 ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiRandomStreamKAT,test_DigiRandomStreamKAT)
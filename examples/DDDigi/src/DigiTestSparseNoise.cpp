@@ -0,0 +1,119 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiSparseNoise.h>
+#include <DDDigi/DigiRandomStream.h>
+
+/// ROOT include files
+#include <TH1D.h>
+
+/// C/C++ include files
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+/// Plugin to validate the sparse noise generation against the dense cell scan
+/**
+ *  The dense scan generates gaussian noise for every cell and applies the
+ *  zero-suppression threshold. The sparse scan only generates the cells
+ *  above threshold. Both must give compatible numbers of noisy cells and
+ *  compatible amplitude spectra.
+ *
+ *  Factory: DD4hep_DigiSparseNoise
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiSparseNoise(Detector& /* description */, int argc, char** argv) {
+  size_t num_cells  = 1000000;
+  size_t num_events = 20;
+  double sigma      = 1e0;
+  double threshold  = 3e0;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-cells",argv[i],3) )
+      num_cells  = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-events",argv[i],3) )
+      num_events = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-sigma",argv[i],3) )
+      sigma      = ::atof(argv[++i]);
+    else if ( 0 == ::strncmp("-threshold",argv[i],3) )
+      threshold  = ::atof(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiSparseNoise -arg [-arg]                       \n"
+        "     -cells     <value>  Number of detector cells [default: 1000000]     \n"
+        "     -events    <value>  Number of events [default: 20]                  \n"
+        "     -sigma     <value>  Noise width [default: 1]                        \n"
+        "     -threshold <value>  Zero-suppression threshold [default: 3]         \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  DigiSparseNoise     noise(sigma, threshold);
+  std::vector<double> values(num_cells, 0e0);
+  TH1D h_dense ("dense",  "Dense scan",  100, threshold, threshold + 3e0*sigma);
+  TH1D h_sparse("sparse", "Sparse scan", 100, threshold, threshold + 3e0*sigma);
+  h_dense.SetDirectory(nullptr);
+  h_sparse.SetDirectory(nullptr);
+
+  size_t n_dense = 0, n_sparse = 0;
+  std::chrono::duration<double> t_dense(0), t_sparse(0);
+  for( size_t evt = 0; evt < num_events; ++evt )   {
+    DigiRandomStream random(12345, evt, 1);
+    auto start = std::chrono::high_resolution_clock::now();
+    random.derive(1).fill_gaussian(0, values.data(), num_cells);
+    for( double v : values )   {
+      if ( v*sigma > threshold )  {
+        h_dense.Fill(v*sigma);
+        ++n_dense;
+      }
+    }
+    t_dense += std::chrono::high_resolution_clock::now() - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    auto engine = random.derive(2).engine(0);
+    for( std::uint64_t idx = noise.gap(engine()); idx < num_cells; idx += 1 + noise.gap(engine()) )  {
+      h_sparse.Fill(noise.tail(engine()));
+      ++n_sparse;
+    }
+    t_sparse += std::chrono::high_resolution_clock::now() - start;
+  }
+  double expected = noise.probability() * double(num_cells) * double(num_events);
+  double error    = std::sqrt(expected);
+  double prob     = h_dense.KolmogorovTest(&h_sparse);
+  bool   counts   = std::fabs(double(n_dense)  - expected) < 5e0*error + 1e0 &&
+                    std::fabs(double(n_sparse) - expected) < 5e0*error + 1e0;
+  bool   shapes   = prob > 1e-3;
+
+  printout(INFO, "SparseNoise", "Cells: %ld  events: %ld  sigma: %g  threshold: %g  p: %g",
+           num_cells, num_events, sigma, threshold, noise.probability());
+  printout(INFO, "SparseNoise", "Dense scan : %9.4f sec  %10ld cells above threshold",
+           t_dense.count(), n_dense);
+  printout(INFO, "SparseNoise", "Sparse scan: %9.4f sec  %10ld cells above threshold",
+           t_sparse.count(), n_sparse);
+  printout(INFO, "SparseNoise", "Expected   : %10.1f +- %.1f cells  Amplitude KS probability: %g",
+           expected, error, prob);
+  printout(INFO, "SparseNoise", "Distributions compatible: %s",
+           counts && shapes ? "YES" : "NO");
+  return counts && shapes ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiSparseNoise,test_DigiSparseNoise)
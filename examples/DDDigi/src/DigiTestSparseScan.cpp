@@ -0,0 +1,218 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Detector.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiUniformNoise.h>
+#include <DDDigi/DigiSparseNoise.h>
+#include <DDDigi/DigiSubdetectorSequence.h>
+
+/// C/C++ include files
+#include <random>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+namespace {
+
+  /// Subdetector sequence recording the cells passed to the cell handler
+  class CellRecorder : public DigiSubdetectorSequence   {
+  public:
+    /// Signals of the cells passed to the cell handler
+    std::map<CellID, double> cells;
+    /// Number of cell handler calls
+    std::size_t num_calls = 0;
+    /// Number of cells passed without placement or solid
+    std::size_t num_bad   = 0;
+  public:
+    /// Initializing constructor
+    CellRecorder(const DigiKernel& kernel, const std::string& nam) : DigiSubdetectorSequence(kernel, nam)  {
+      m_cellHandler = [this](DigiContext&, const DigiCellScanner&, const DigiCellData& data)  {
+        if ( !data.placement.isValid() || !data.solid.isValid() ) ++num_bad;
+        cells[data.cell_id] += data.signal;
+        ++num_calls;
+      };
+    }
+    /// Default destructor
+    virtual ~CellRecorder() = default;
+    /// Access the total number of grid cells of the sensors
+    std::uint64_t numGridCells()  const  {  return m_numCells;  }
+  };
+}
+
+/// Plugin to compare the sparse scan of a subdetector with the dense scan
+/**
+ *  Energy deposits are generated at random positions of the sensors of a
+ *  subdetector. The cell identifiers are computed by the segmentation
+ *  as in the simulation. The plugin checks that
+ *  - the dense scan visits every cell once and knows all deposit cells,
+ *  - the dense scan with signal processors visits the same cells,
+ *  - without noise the sparse scan and the dense scan pass the same cells
+ *    with the same signals above threshold,
+ *  - with noise the sparse scan only generates cells known to the dense scan
+ *    and the number of noise cells is compatible with the expectation.
+ *  Every cell passed to the cell handler must have its placement and solid.
+ *
+ *  Factory: DD4hep_DigiSparseScan
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static long test_DigiSparseScan(Detector& description, int argc, char** argv) {
+  std::string det_name;
+  std::string parallel = "side";
+  size_t num_deposits  = 200;
+  size_t num_events    = 100;
+  double threshold     = 3e0;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-detector",argv[i],4) )
+      det_name     = argv[++i];
+    else if ( 0 == ::strncmp("-parallel",argv[i],4) )
+      parallel     = argv[++i];
+    else if ( 0 == ::strncmp("-deposits",argv[i],4) )
+      num_deposits = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-events",argv[i],4) )
+      num_events   = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threshold",argv[i],4) )
+      threshold    = ::atof(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiSparseScan -arg [-arg]                        \n"
+        "     -detector  <name>   Name of the subdetector [mandatory]             \n"
+        "     -parallel  <name>   Volume ID field of the sensors [default: side]  \n"
+        "     -deposits  <value>  Number of deposits [default: 200]               \n"
+        "     -events    <value>  Number of noise events [default: 100]           \n"
+        "     -threshold <value>  Zero-suppression threshold [default: 3]         \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  DigiKernel&       kernel = DigiKernel::instance(description);
+  DetElement        det    = description.detector(det_name);
+  SensitiveDetector sd     = description.sensitiveDetector(det_name);
+  if ( !det.isValid() || !sd.isValid() )   {
+    except("DigiSparseScan", "+++ Invalid subdetector: %s", det_name.c_str());
+  }
+  Readout      readout = sd.readout();
+  Segmentation seg     = readout.segmentation();
+  IDDescriptor id_desc = readout.idSpec();
+
+  // Energy deposits well above threshold at random positions of the sensors.
+  // Stay away from the edges: there the cell centers may be outside the solid
+  std::mt19937_64 engine(12345);
+  std::uniform_real_distribution<double> flat(0e0, 1e0);
+  auto deposits = std::make_shared<DigiDepositColumns>(readout.name());
+  VolumeID det_id = id_desc.encode(det.placement().volIDs());
+  for( size_t i = 0; i < num_deposits; ++i )   {
+    for( const auto& c : det.children() )   {
+      PlacedVolume pv  = c.second.placement();
+      VolumeID     vid = det_id | id_desc.encode(pv.volIDs());
+      Box          box = pv.volume().solid();
+      Position     pos(0.9 * (2e0*flat(engine) - 1e0) * box->GetDX(),
+                       0.9 * (2e0*flat(engine) - 1e0) * box->GetDY(), 0e0);
+      deposits->emplace_back(seg.cellID(pos, pos, vid), threshold + 5e0 + flat(engine), 0e0, pos);
+    }
+  }
+  std::map<CellID, double> signals;
+  for( size_t i = 0; i < deposits->size(); ++i )
+    signals[deposits->cellID[i]] += deposits->energy[i];
+
+  auto run = [&](bool sparse, double sigma, double thr, bool processors, int event_number)  {
+    CellRecorder* seq = new CellRecorder(kernel, "Scanner");
+    seq->property("detector").set(det_name);
+    seq->property("parallize_by").set(parallel);
+    seq->property("sparse").set(sparse);
+    seq->property("noise_sigma").set(sigma);
+    seq->property("threshold").set(thr);
+    seq->property("seed").set(4711L);
+    if ( processors )   {
+      DigiUniformNoise* none = new DigiUniformNoise(kernel, "NoNoise");
+      none->property("minimum").set(0e0);
+      none->property("maximum").set(0e0);
+      seq->adoptProcessor(none);
+      none->release();
+    }
+    seq->initialize();
+    DigiEvent   event(event_number);
+    DigiContext context(&kernel, &event);
+    event.depositColumns.emplace(Key(0, readout.name()).toLong(), deposits);
+    seq->execute(context);
+    return seq;
+  };
+
+  bool ok = true;
+  // Dense scan: every cell exactly once. All deposits must be in known cells
+  CellRecorder* dense = run(false, 0e0, 0e0, false, 0);
+  size_t num_cells = dense->cells.size();
+  ok &= dense->num_calls == num_cells && dense->num_bad == 0 && num_cells > 0;
+  size_t num_unknown = 0;
+  for( const auto& s : signals )
+    if ( dense->cells.find(s.first) == dense->cells.end() ) ++num_unknown;
+  ok &= num_unknown == 0;
+
+  // Dense scan with signal processors: the same cells
+  CellRecorder* batch_all = run(false, 0e0, -1e0, true, 0);
+  bool same_cells = batch_all->cells.size() == num_cells && batch_all->num_bad == 0;
+  for( const auto& c : batch_all->cells )
+    same_cells &= dense->cells.find(c.first) != dense->cells.end();
+  ok &= same_cells;
+
+  // Without noise: dense and sparse scan pass the same signals above threshold
+  CellRecorder* batch  = run(false, 0e0, threshold, true, 0);
+  CellRecorder* sparse = run(true,  0e0, threshold, false, 0);
+  bool same_signals = batch->cells == signals && sparse->cells == signals &&
+    sparse->num_calls == signals.size() && sparse->num_bad == 0;
+  ok &= same_signals;
+
+  // With noise: noise cells must be known cells, the signal cells must survive
+  DigiSparseNoise noise(1e0, threshold);
+  size_t num_noise = 0, num_foreign = 0, num_missing = 0;
+  for( size_t evt = 0; evt < num_events; ++evt )   {
+    CellRecorder* noisy = run(true, 1e0, threshold, false, int(evt));
+    for( const auto& c : noisy->cells )   {
+      if ( dense->cells.find(c.first) == dense->cells.end() ) ++num_foreign;
+      if ( signals.find(c.first) == signals.end() ) ++num_noise;
+    }
+    for( const auto& s : signals )
+      if ( noisy->cells.find(s.first) == noisy->cells.end() ) ++num_missing;
+    ok &= noisy->num_bad == 0;
+    noisy->release();
+  }
+  double expected = noise.probability() * double(num_cells - signals.size()) * double(num_events);
+  bool   counts   = std::fabs(double(num_noise) - expected) < 5e0*std::sqrt(expected) + 1e0;
+  ok &= num_foreign == 0 && num_missing == 0 && counts;
+
+  printout(INFO, "SparseScan", "Detector: %s  cells: %ld of %lld grid cells  deposit cells: %ld  unknown: %ld",
+           det_name.c_str(), num_cells, (long long)dense->numGridCells(), signals.size(), num_unknown);
+  printout(INFO, "SparseScan", "Dense scan with signal processors visits the same cells: %s",
+           yes_no(same_cells));
+  printout(INFO, "SparseScan", "Signals above threshold  dense: %ld  sparse: %ld  identical: %s",
+           batch->cells.size(), sparse->cells.size(), yes_no(same_signals));
+  printout(INFO, "SparseScan", "Noise cells: %ld  expected: %.1f  unknown cells: %ld  lost signals: %ld",
+           num_noise, expected, num_foreign, num_missing);
+  printout(INFO, "SparseScan", "Sparse and dense scans consistent: %s", ok ? "YES" : "NO");
+  dense->release();
+  batch_all->release();
+  batch->release();
+  sparse->release();
+  return ok ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_DigiSparseScan,test_DigiSparseScan)
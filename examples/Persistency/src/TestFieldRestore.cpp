@@ -0,0 +1,92 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin after loading the geometry with something like this:
+
+   geoPluginRun -plugin DD4hep_RootLoader <file-name> \
+                -plugin DD4hep_PersistencyExample_check_field
+
+   Check that the magnetic field overlay restored from a ROOT file
+   gives a non-vanishing field identical to the sum of its components.
+
+*/
+// Framework include files
+#include "DD4hep/Detector.h"
+#include "DD4hep/Printout.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/DD4hepUnits.h"
+
+// C/C++ include files
+#include <cmath>
+
+using namespace std;
+using namespace dd4hep;
+
+/// Plugin function: Check the restored magnetic field overlay
+/**
+ *  Factory: DD4hep_PersistencyExample_check_field
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    19/10/2026
+ */
+static int persistency_check_field (Detector& description, int argc, char** argv)  {
+  double step  = 50e0*dd4hep::cm;
+  int    steps = 10;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-step",argv[i],4) )
+      step = ::atof(argv[++i])*dd4hep::cm;
+    else if ( 0 == ::strncmp("-points",argv[i],4) )
+      steps = ::atol(argv[++i]);
+    else  {
+      /// Help printout describing the basic command line interface
+      cout <<
+        "Usage: -plugin <name> -arg [-arg]                                             \n"
+        "     name:   factory name     DD4hep_PersistencyExample_check_field           \n"
+        "     -step   <number>         Step size along x and z in cm [default: 50]     \n"
+        "     -points <number>         Number of steps along x and z [default: 10]     \n"
+        "\tArguments given: " << arguments(argc,argv) << endl << flush;
+      ::exit(EINVAL);
+    }
+  }
+  OverlayedField field = description.field();
+  if ( !field.isValid() )   {
+    printout(ERROR,"Example","+++ ERROR +++ No field overlay present.");
+    return 0;
+  }
+  const auto& components = field.data<OverlayedField::Object>()->magnetic_components;
+  size_t num_points = 0, num_errors = 0;
+  double max_field  = 0e0;
+  for( int ix = 0; ix <= steps; ++ix )   {
+    for( int iz = -steps; iz <= steps; ++iz, ++num_points )   {
+      double pos[3] = { ix*step, 0e0, iz*step };
+      double overlay[3] = { 0e0, 0e0, 0e0 }, sum[3] = { 0e0, 0e0, 0e0 };
+      field.magneticField(pos, overlay);
+      for( const auto& c : components ) c.value(pos, sum);
+      for( int k = 0; k < 3; ++k )
+        if ( std::fabs(overlay[k]-sum[k]) > 1e-9*dd4hep::tesla ) { ++num_errors; break; }
+      max_field = std::max(max_field, std::sqrt(overlay[0]*overlay[0]+overlay[1]*overlay[1]+overlay[2]*overlay[2]));
+    }
+  }
+  bool ok = num_errors == 0 && max_field > 0e0 && !components.empty();
+  printout(ok ? ALWAYS : ERROR,"Example",
+           "+++ %s Checked the field of %ld components at %ld points. Max |B|: %.3f tesla Num.Errors: %ld",
+           ok ? "PASSED" : "FAILED", components.size(), num_points, max_field/dd4hep::tesla, num_errors);
+  return ok ? 1 : 0;
+}
+
+DECLARE_APPLY(DD4hep_PersistencyExample_check_field,persistency_check_field)